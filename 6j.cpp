@@ -3,42 +3,145 @@
 6j.cpp
 ======
 
-Author:     Grant Bradley
-Date:       20 July 2021
-Version:    1.0
+Date:		18 October 2026
+Version:	1.0
 
-This file contains the routine 6j adapted from Greg Egan's tenJ routine.
+This file contains routines that compute normalised 6j symbols, for use in
+Ponzano-Regge and Turaev-Viro state sums.
 
+sixJ(int twoJ1, int twoJ2, int twoJ3, int twoJ4, int twoJ5, int twoJ6) computes
 
-Refs:
+	{j1 j2 j3}
+	{j4 j5 j6}
 
+whose triads are (j1,j2,j3), (j1,j5,j6), (j4,j2,j6) and (j4,j5,j3).  This is the
+tetrahedral net
+
+	Tet[j1 j2 j6]
+	   [j4 j5 j3]
+
+divided by the square root of the absolute value of the product of the theta
+nets on its four triangles; with the sign conventions of Kauffman and Lins it is
+exactly the usual (Wigner) 6j symbol.  The arguments are double the spins, as
+elsewhere in the package, and the result is zero if any triad is not admissible.
+
+sixJRow(int twoJ2, int twoJ3, int twoJ4, int twoJ5, int twoJ6, int &twoJ1Min,
+	SIXJfloat *values)
+computes the symbols for every admissible j1, with the other five spins fixed,
+and returns how many there are; twoJ1Min is set to double the smallest j1, and
+values[] must have room for 1+min(twoJ2,twoJ3,twoJ5,twoJ6) entries, or be NULL
+if only the number is wanted.  Rather than summing each symbol separately, it
+uses the three-term recursion in j1 of Schulten and Gordon:
+
+	j1 E(j1+1) {j1+1} + F(j1) {j1} + (j1+1) E(j1) {j1-1} = 0
+
+Starting from exact values at each end of the row, the recursion is run upwards
+until the magnitude of the symbols first falls, which happens once j1 is inside
+the classically allowed region, and downwards from the top to meet it; in each
+direction it then follows the growing solution, and is stable.  The cost is four
+direct evaluations plus O(1) per symbol, instead of one alternating sum each.
+
+The recursion is also more accurate than the alternating sums, which lose digits
+to cancellation once the spins reach a hundred or so; 6jMain.cpp compares both
+against the orthogonality of the symbols.
+
+Reference:	K. Schulten and R.G. Gordon, "Exact recursive evaluation of 3j- and
+			6j-coefficients for quantum-mechanical coupling of angular momenta",
+			J. Math. Phys. 16 (1975) 1961.
 
 */
-#define _USE_MATH_DEFINES
-#include <cmath>
-
-//  6j symbol is a real number related to the labelling of edges of a 
-//  tetrahedra by SU2 representations. specifically, the square of the SL(2,R) 6j symbol
-//  is an integral over the space of AdS tetrahedra, obtained via combination of four
-//  normalized Clebsch-Gordan coefficients along six edges of a tetrahedra
-int l_01,l_02,l_03,l_23,l_13,l_12;
-int V_l[4] = {0,1,2,3};
-int baseJ1[]={1,1,1,1,1};
-int I[2][3] = {l_01,l_02,l_03,
-               l_23,l_13,l_12}; //  square this matrix
-
-for theta(int twoJ1, int twoJ2, int twoJ3){
-    if (theta_IJ <= theta_IK + theta_JK)
-    if (2* M_PI >= theta_IJ + theta_IK + theta_JK)
 
+#include "spin.h"
+
+//	Rows of at most this length are computed directly
+
+#define minRecursion 4
+
+//	Is (a,b,c) an admissible triad of doubled spins?
+
+static bool triad(int a, int b, int c)
+{
+return (a+b+c)%2==0 && a<=b+c && b<=a+c && c<=a+b;
 }
-//  gauge invariant variables given by 6 angles theta_iJ \in [0,\pi]
-//  for any triple (I,J,K) of distinct elements == set of all possible
-//  spherical tetrahedra 
-    if (theta_IJ <= theta_IK + theta_JK)
-    if (2* M_PI >= theta_IJ + theta_IK + theta_JK )
 
+//	sixJ()
+//	======
+
+SIXJfloat sixJ(int twoJ1, int twoJ2, int twoJ3, int twoJ4, int twoJ5, int twoJ6)
+{
+if (!(triad(twoJ1,twoJ2,twoJ3) && triad(twoJ1,twoJ5,twoJ6) &&
+	triad(twoJ4,twoJ2,twoJ6) && triad(twoJ4,twoJ5,twoJ3))) return 0.0;
+return tetOnRootThetas(twoJ1,twoJ2,twoJ4,twoJ5,twoJ6,twoJ3);
+}
 
+//	sixJRow()
+//	=========
 
+//	Coefficients of the recursion, for {j1 j2 j3; l1 l2 l3}
 
-double SIXJfloat sixJ()
\ No newline at end of file
+static double recursionE(double j1, double j2, double j3, double l2, double l3)
+{
+return sqrt((j1*j1-(j2-j3)*(j2-j3))*((j2+j3+1)*(j2+j3+1)-j1*j1)*
+	(j1*j1-(l2-l3)*(l2-l3))*((l2+l3+1)*(l2+l3+1)-j1*j1));
+}
+
+static double recursionF(double j1, double j2, double j3, double l1, double l2, double l3)
+{
+double J1=j1*(j1+1), J2=j2*(j2+1), J3=j3*(j3+1);
+double L1=l1*(l1+1), L2=l2*(l2+1), L3=l3*(l3+1);
+return (2*j1+1)*(J1*(-J1+J2+J3-2*L1)+L2*(J1+J2-J3)+L3*(J1-J2+J3));
+}
+
+int sixJRow(int twoJ2, int twoJ3, int twoJ4, int twoJ5, int twoJ6,
+	int &twoJ1Min, SIXJfloat *values)
+{
+//	Range of j1 allowed by the triads (j1,j2,j3) and (j1,j5,j6)
+
+int lo1=abs(twoJ2-twoJ3), lo2=abs(twoJ5-twoJ6);
+int hi1=twoJ2+twoJ3, hi2=twoJ5+twoJ6;
+int lo=max(lo1,lo2), hi=min(hi1,hi2);
+twoJ1Min=lo;
+if (hi<lo || (hi1-hi2)%2!=0 ||
+	!triad(twoJ4,twoJ2,twoJ6) || !triad(twoJ4,twoJ5,twoJ3)) return 0;
+int n=(hi-lo)/2+1;
+if (values==NULL) return n;
+
+if (n<=minRecursion)
+	{
+	for (int k=0;k<n;k++) values[k]=sixJ(lo+2*k,twoJ2,twoJ3,twoJ4,twoJ5,twoJ6);
+	return n;
+	};
+
+double j2=twoJ2/2.0, j3=twoJ3/2.0, l1=twoJ4/2.0, l2=twoJ5/2.0, l3=twoJ6/2.0;
+
+//	Upwards from the bottom, until the magnitude falls
+
+values[0]=sixJ(lo,twoJ2,twoJ3,twoJ4,twoJ5,twoJ6);
+values[1]=sixJ(lo+2,twoJ2,twoJ3,twoJ4,twoJ5,twoJ6);
+int mid=n-2;
+for (int k=1;k<n-2;k++)
+	{
+	double j1=(lo+2*k)/2.0;
+	values[k+1]=-(recursionF(j1,j2,j3,l1,l2,l3)*values[k]+
+		(j1+1)*recursionE(j1,j2,j3,l2,l3)*values[k-1])/
+		(j1*recursionE(j1+1,j2,j3,l2,l3));
+	if (fabs(values[k+1])<fabs(values[k]))
+		{
+		mid=k+1;
+		break;
+		};
+	};
+
+//	Downwards from the top, to meet it
+
+values[n-1]=sixJ(hi,twoJ2,twoJ3,twoJ4,twoJ5,twoJ6);
+values[n-2]=sixJ(hi-2,twoJ2,twoJ3,twoJ4,twoJ5,twoJ6);
+for (int k=n-2;k>mid;k--)
+	{
+	double j1=(lo+2*k)/2.0;
+	values[k-1]=-(recursionF(j1,j2,j3,l1,l2,l3)*values[k]+
+		j1*recursionE(j1+1,j2,j3,l2,l3)*values[k+1])/
+		((j1+1)*recursionE(j1,j2,j3,l2,l3));
+	};
+return n;
+}
@@ -0,0 +1,113 @@
+/*
+
+6jMain.cpp
+==========
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a main program that computes 6j symbols, and compares the ways
+of computing them.
+
+	6j <twoJ1> <twoJ2> <twoJ3> <twoJ4> <twoJ5> <twoJ6>
+
+prints the symbol {j1 j2 j3; j4 j5 j6} from sixJ().
+
+	6j -b <maxTwoJ> [rows]
+
+chooses the given number of rows (default 2000) of symbols with random j2..j6,
+with 2j at most maxTwoJ, and computes every symbol in them three ways:  from tet()
+and theta() separately, from sixJ(), and from sixJRow().  For each way it prints
+the time taken, the number of symbols per second, and the worst departure from
+the orthogonality relation
+
+	sum over j1 of (2j1+1)(2j4+1) {j1 j2 j3; j4 j5 j6}^2 = 1
+
+across the rows, which measures the accuracy without needing a reference value.
+
+*/
+
+#include <string.h>
+#include "spin.h"
+
+void usage()
+{
+printf("usage:\t6j <6 values of 2j>\n\t6j -b <maxTwoJ> [rows]\n");
+exit(2);
+}
+
+//	The three ways of computing a row
+
+#define nMethods 3
+static const char *methodNames[nMethods]={"tet/theta","sixJ","sixJRow"};
+
+static int computeRow(int method, int *r, int &lo, SIXJfloat *values)
+{
+if (method==2) return sixJRow(r[0],r[1],r[2],r[3],r[4],lo,values);
+
+//	Find the range of j1 as sixJRow() would
+
+int n=sixJRow(r[0],r[1],r[2],r[3],r[4],lo,NULL);
+for (int k=0;k<n;k++)
+	{
+	int a=lo+2*k;
+	if (method==1) values[k]=sixJ(a,r[0],r[1],r[2],r[3],r[4]);
+	else
+		{
+		double th=theta(a,r[0],r[1])*theta(a,r[3],r[4])*
+			theta(r[2],r[0],r[4])*theta(r[2],r[3],r[1]);
+		values[k]=tet(a,r[0],r[2],r[3],r[4],r[1])/sqrt(fabs(th));
+		};
+	};
+return n;
+}
+
+int main(int argc, char **argv)
+{
+if (argc==7)
+	{
+	int j[6];
+	for (int i=0;i<6;i++) j[i]=atoi(argv[1+i]);
+	printf("%.17g\n",(double)sixJ(j[0],j[1],j[2],j[3],j[4],j[5]));
+	return 0;
+	};
+if (argc<3 || argc>4 || strcmp(argv[1],"-b")!=0) usage();
+
+int maxTwoJ=atoi(argv[2]), nRows=argc==4 ? atoi(argv[3]) : 2000;
+if (maxTwoJ<0 || nRows<=0) usage();
+
+//	Choose rows with at least one admissible symbol
+
+int (*rows)[5]=new int[nRows][5];
+srand(1);
+for (int q=0;q<nRows;)
+	{
+	int lo;
+	for (int i=0;i<5;i++) rows[q][i]=rand()%(maxTwoJ+1);
+	if (sixJRow(rows[q][0],rows[q][1],rows[q][2],rows[q][3],rows[q][4],lo,NULL)>0) q++;
+	};
+
+SIXJfloat *values=new SIXJfloat[maxTwoJ+1];
+printf("%d rows with 2j <= %d\n",nRows,maxTwoJ);
+printf("%10s %10s %10s %14s %14s\n","method","symbols","seconds","symbols/sec","orthogonality");
+for (int method=0;method<nMethods;method++)
+	{
+	double worst=0.0, nSymbols=0.0;
+	clock_t c0=clock();
+	for (int q=0;q<nRows;q++)
+		{
+		int lo, n=computeRow(method,rows[q],lo,values);
+		double norm=0.0;
+		for (int k=0;k<n;k++) norm+=(lo+2*k+1)*(rows[q][2]+1)*values[k]*values[k];
+		if (!(fabs(norm-1.0)<=worst)) worst=fabs(norm-1.0);
+		nSymbols+=n;
+		};
+	double seconds=(clock()-c0)/(double)CLOCKS_PER_SEC;
+	printf("%10s %10.0f %10.3f %14.4g %14.3g\n",methodNames[method],
+		nSymbols,seconds,seconds>0.0 ? nSymbols/seconds : 0.0,worst);
+	};
+
+delete [] rows;
+delete [] values;
+return 0;
+}
@@ -0,0 +1,398 @@
+/*
+
+6jTable.cpp
+===========
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains routines that precompute every 6j symbol with 2j <= maxTwoJ,
+store them in a file, and look them up from a memory-mapped copy of it.
+
+The 6j symbol {j1 j2 j3; j4 j5 j6} depends on its six spins only through the
+four sums around its triads,
+
+	a1 = j1+j2+j3,  a2 = j1+j5+j6,  a3 = j4+j2+j6,  a4 = j4+j5+j3,
+
+and the three sums around the quadrilaterals left by pairs of opposite edges,
+
+	b1 = j3+j6+j1+j4,  b2 = j1+j4+j2+j5,  b3 = j2+j5+j3+j6,
+
+and is unchanged by any permutation of the a's and any permutation of the b's
+(the Racah sum is symmetric in both).  These 4!*3! = 144 permutations are the
+tetrahedral and Regge symmetries.  So the table holds one value for each sorted
+pair a1<=a2<=a3<=a4, b1<=b2<=b3 (with b1>=a4, and the sum of the a's equal to the
+sum of the b's) that is the image of at least one admissible six-tuple with every
+2j <= maxTwoJ.  The spins can be recovered from a canonical pair as
+
+	2j1 = a1+a2-b,  2j4 = a3+a4-b,		b the sum opposite {j1, j4}
+	2j2 = a1+a3-b', 2j5 = a2+a4-b',		b' the sum opposite {j2, j5}
+	2j3 = a1+a4-b'',2j6 = a2+a3-b'',	b'' the sum opposite {j3, j6}
+
+for some assignment of the three b's, which we find by trying all six.
+
+To find a value, the a's are sorted and ranked as a multiset, giving an O(1)
+index into a directory of the rows of values for each set of a's, one row for
+each b1; each row holds the values for a contiguous range of b2 (b3 follows).
+So a lookup is two sorts of a few numbers and three array references.
+
+writeSixJTable(const char *fileName, int maxTwoJ, int nThreads) enumerates the
+canonical pairs, computes their values with sixJ() (and so with tet.cpp and
+theta.cpp), sharing the sets of a's between nThreads threads, and writes the file.
+
+openSixJTable(const char *fileName) maps a file into memory, read-only, so that
+several processes can share a single copy, and makeSixJTable(int maxTwoJ, int
+nThreads) builds the same table in memory, for a program that needs it only while
+it runs; sixJTableLookup(table, twoJ1, ..., twoJ6) then gives any symbol,
+returning 0 for inadmissible spins, and computing symbols with spins larger than
+the table's maxTwoJ with sixJ().  closeSixJTable() unmaps the file or frees the
+memory.
+
+*/
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "spin.h"
+
+//	File header, followed by the directory, the rows and the values
+
+#define tableMagic "6JTABLE1"
+
+struct TableHeader
+	{
+	char magic[8];
+	int maxTwoJ;				//	Largest 2j in the table
+	int maxA;					//	Largest triad sum
+	long long nAlpha;			//	Number of multisets of four triad sums
+	long long nRows;			//	Number of rows
+	long long nValues;			//	Number of values
+	long long reserved[3];
+	};
+
+//	Helpers
+//	=======
+
+static inline void swapIf(int &x, int &y)
+{
+if (x>y) {int t=x; x=y; y=t;};
+}
+
+//	rankAlpha() ranks a1<=a2<=a3<=a4 among all such multisets, in the order of
+//	a4, then a3, then a2, then a1
+
+static inline long long rankAlpha(int *a)
+{
+long long a2=a[1]+1, a3=a[2]+2, a4=a[3]+3;
+return a[0]+a2*(a2-1)/2+a3*(a3-1)*(a3-2)/6+a4*(a4-1)*(a4-2)*(a4-3)/24;
+}
+
+//	spinsFor() finds spins, each at most maxTwoJ, with the triad sums a[] and
+//	quadrilateral sums b[] in some order, if there are any
+
+static bool spinsFor(int *a, int *b, int maxTwoJ, int *twoJ)
+{
+static const int perms[6][3]={{0,1,2},{0,2,1},{1,0,2},{1,2,0},{2,0,1},{2,1,0}};
+for (int p=0;p<6;p++)
+	{
+	int x=b[perms[p][0]], y=b[perms[p][1]], z=b[perms[p][2]];
+	twoJ[0]=a[0]+a[1]-x; twoJ[3]=a[2]+a[3]-x;
+	twoJ[1]=a[0]+a[2]-y; twoJ[4]=a[1]+a[3]-y;
+	twoJ[2]=a[0]+a[3]-z; twoJ[5]=a[1]+a[2]-z;
+	bool ok=true;
+	for (int i=0;i<6;i++) ok&=(twoJ[i]>=0 && twoJ[i]<=maxTwoJ);
+	if (ok) return true;
+	};
+return false;
+}
+
+//	The rows for one set of a's, as found by findRows():  b1 runs over a range,
+//	and for each b1 there is a range of b2 (possibly empty) holding all the values
+
+struct AlphaRows
+	{
+	int b1Min, b1Max;
+	std::vector<int> b2Min, b2Max;
+	};
+
+static void findRows(int *a, int maxTwoJ, AlphaRows &rows)
+{
+int S=a[0]+a[1]+a[2]+a[3], b[3], twoJ[6];
+rows.b1Min=a[3];
+rows.b1Max=a[3]-1;
+rows.b2Min.clear();
+rows.b2Max.clear();
+for (int b1=a[3];3*b1<=S;b1++)
+	{
+	int lo=-1, hi=-2;
+	for (int b2=b1;2*b2<=S-b1;b2++)
+		{
+		b[0]=b1; b[1]=b2; b[2]=S-b1-b2;
+		if (spinsFor(a,b,maxTwoJ,twoJ))
+			{
+			if (lo<0) lo=b2;
+			hi=b2;
+			};
+		};
+	rows.b2Min.push_back(lo<0 ? 0 : lo);
+	rows.b2Max.push_back(hi);
+	if (lo>=0) rows.b1Max=b1;
+	};
+rows.b2Min.resize(rows.b1Max-rows.b1Min+1);
+rows.b2Max.resize(rows.b1Max-rows.b1Min+1);
+}
+
+//	The arrays of ints in the file are padded to multiples of 8 bytes
+
+static long long pad8(long long n)
+{
+return (n+7)&~7LL;
+}
+
+//	buildImage() lays out the table exactly as it is stored in a file, in an
+//	anonymous mapping, and computes the values into it
+
+static char *buildImage(int maxTwoJ, int nThreads, long long &bytes)
+{
+if (maxTwoJ<0)
+	{
+	printf("Invalid maximum 2j %d\n",maxTwoJ);
+	return NULL;
+	};
+if (nThreads<1) nThreads=1;
+
+//	Lay out the directory and the rows; every set of a's is at most 3*maxTwoJ/2
+
+TableHeader h;
+memset(&h,0,sizeof(h));
+memcpy(h.magic,tableMagic,8);
+h.maxTwoJ=maxTwoJ;
+h.maxA=(3*maxTwoJ)/2;
+long long m=h.maxA+4;
+h.nAlpha=m*(m-1)*(m-2)*(m-3)/24;
+
+std::vector<int> dirRow(h.nAlpha+1), dirB1Min(h.nAlpha+1);
+std::vector<long long> rowValue;
+std::vector<int> rowB2Min;
+std::vector<long long> alphaStart;			//	Packed a's and first row, for the
+std::vector<int> alphas;					//	classes that have any values
+long long nValues=0;
+
+int a[4];
+AlphaRows rows;
+for (a[3]=0;a[3]<=h.maxA;a[3]++)
+for (a[2]=0;a[2]<=a[3];a[2]++)
+for (a[1]=0;a[1]<=a[2];a[1]++)
+for (a[0]=0;a[0]<=a[1];a[0]++)
+	{
+	long long r=rankAlpha(a);
+	findRows(a,maxTwoJ,rows);
+	dirRow[r]=(int)rowValue.size();
+	dirB1Min[r]=rows.b1Min;
+	if (rows.b1Max<rows.b1Min) continue;
+	alphaStart.push_back((long long)rowValue.size());
+	for (int i=0;i<4;i++) alphas.push_back(a[i]);
+	for (int q=0;q<=rows.b1Max-rows.b1Min;q++)
+		{
+		rowValue.push_back(nValues);
+		rowB2Min.push_back(rows.b2Min[q]);
+		if (rows.b2Max[q]>=rows.b2Min[q]) nValues+=rows.b2Max[q]-rows.b2Min[q]+1;
+		};
+	};
+dirRow[h.nAlpha]=(int)rowValue.size();
+dirB1Min[h.nAlpha]=0;
+rowValue.push_back(nValues);
+rowB2Min.push_back(0);
+h.nRows=(long long)rowValue.size()-1;
+h.nValues=nValues;
+rowB2Min.resize(pad8((h.nRows+1)*sizeof(int))/sizeof(int),0);
+
+long long dirBytes=(h.nAlpha+1)*sizeof(int);
+bytes=sizeof(TableHeader)+2*dirBytes+(h.nRows+1)*sizeof(long long)+
+	rowB2Min.size()*sizeof(int)+nValues*sizeof(SIXJfloat);
+void *map=mmap(NULL,bytes,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS,-1,0);
+if (map==MAP_FAILED)
+	{
+	printf("Could not allocate %lld bytes for a 6j table\n",bytes);
+	return NULL;
+	};
+char *image=(char *)map, *p=image;
+memcpy(p,&h,sizeof(h));
+p+=sizeof(h);
+memcpy(p,&dirRow[0],dirBytes);
+p+=dirBytes;
+memcpy(p,&dirB1Min[0],dirBytes);
+p+=dirBytes;
+memcpy(p,&rowValue[0],(h.nRows+1)*sizeof(long long));
+p+=(h.nRows+1)*sizeof(long long);
+memcpy(p,&rowB2Min[0],rowB2Min.size()*sizeof(int));
+p+=rowB2Min.size()*sizeof(int);
+
+//	Compute the values, with threads taking sets of a's from a shared counter
+
+SIXJfloat *values=(SIXJfloat *)p;
+int nClasses=(int)alphaStart.size();
+std::atomic<int> next(0);
+auto work=[&]()
+	{
+	for (int c=next++;c<nClasses;c=next++)
+		{
+		int *ac=&alphas[4*c], S=ac[0]+ac[1]+ac[2]+ac[3];
+		long long row=alphaStart[c];
+		for (int b1=ac[3];row<(c+1<nClasses ? alphaStart[c+1] : h.nRows);b1++,row++)
+			{
+			int b[3], twoJ[6];
+			for (long long v=rowValue[row];v<rowValue[row+1];v++)
+				{
+				b[0]=b1;
+				b[1]=rowB2Min[row]+(int)(v-rowValue[row]);
+				b[2]=S-b[0]-b[1];
+				values[v]=spinsFor(ac,b,maxTwoJ,twoJ) ?
+					sixJ(twoJ[0],twoJ[1],twoJ[2],twoJ[3],twoJ[4],twoJ[5]) : 0.0;
+				};
+			};
+		};
+	};
+std::vector<std::thread> threads;
+for (int t=1;t<nThreads;t++) threads.push_back(std::thread(work));
+work();
+for (int t=1;t<nThreads;t++) threads[t-1].join();
+return image;
+}
+
+//	tableFromImage() checks a table image, from a file or buildImage(), and points
+//	a SixJTable into it
+
+static SixJTable *tableFromImage(const char *base, long long bytes, const char *name)
+{
+const TableHeader *h=(const TableHeader *)base;
+long long dirBytes=(h->nAlpha+1)*sizeof(int), rowBytes=pad8((h->nRows+1)*sizeof(int));
+long long expected=sizeof(TableHeader)+2*dirBytes+
+	(h->nRows+1)*sizeof(long long)+rowBytes+h->nValues*sizeof(SIXJfloat);
+if (memcmp(h->magic,tableMagic,8)!=0 || expected!=bytes)
+	{
+	printf("%s is not a valid 6j table file\n",name);
+	return NULL;
+	};
+
+SixJTable *t=new SixJTable;
+t->maxTwoJ=h->maxTwoJ;
+t->nValues=h->nValues;
+t->fileBytes=bytes;
+t->map=base;
+long long offset=sizeof(TableHeader);
+t->dirRow=(const int *)(base+offset);
+offset+=dirBytes;
+t->dirB1Min=(const int *)(base+offset);
+offset+=dirBytes;
+t->rowValue=(const long long *)(base+offset);
+offset+=(h->nRows+1)*sizeof(long long);
+t->rowB2Min=(const int *)(base+offset);
+offset+=rowBytes;
+t->values=(const SIXJfloat *)(base+offset);
+return t;
+}
+
+//	writeSixJTable()
+//	================
+
+bool writeSixJTable(const char *fileName, int maxTwoJ, int nThreads)
+{
+long long bytes;
+char *image=buildImage(maxTwoJ,nThreads,bytes);
+if (image==NULL) return false;
+
+FILE *fp=fopen(fileName,"wb");
+bool ok=fp!=NULL;
+if (ok)
+	{
+	ok=fwrite(image,1,bytes,fp)==(size_t)bytes;
+	if (fclose(fp)!=0) ok=false;
+	};
+if (!ok) printf("Could not write 6j table file %s\n",fileName);
+munmap(image,bytes);
+return ok;
+}
+
+//	makeSixJTable()
+//	===============
+
+SixJTable *makeSixJTable(int maxTwoJ, int nThreads)
+{
+long long bytes;
+char *image=buildImage(maxTwoJ,nThreads,bytes);
+if (image==NULL) return NULL;
+SixJTable *t=tableFromImage(image,bytes,"The computed table");
+if (t==NULL) munmap(image,bytes);
+return t;
+}
+
+//	openSixJTable()
+//	===============
+
+SixJTable *openSixJTable(const char *fileName)
+{
+int fd=open(fileName,O_RDONLY);
+if (fd<0)
+	{
+	printf("Could not open 6j table file %s\n",fileName);
+	return NULL;
+	};
+struct stat st;
+if (fstat(fd,&st)!=0 || st.st_size<(off_t)sizeof(TableHeader))
+	{
+	printf("6j table file %s is too short\n",fileName);
+	close(fd);
+	return NULL;
+	};
+void *map=mmap(NULL,st.st_size,PROT_READ,MAP_SHARED,fd,0);
+close(fd);
+if (map==MAP_FAILED)
+	{
+	printf("Could not map 6j table file %s\n",fileName);
+	return NULL;
+	};
+SixJTable *t=tableFromImage((const char *)map,st.st_size,fileName);
+if (t==NULL) munmap(map,st.st_size);
+return t;
+}
+
+void closeSixJTable(SixJTable *table)
+{
+if (table==NULL) return;
+munmap((void *)table->map,table->fileBytes);
+delete table;
+}
+
+//	sixJTableLookup()
+//	=================
+
+SIXJfloat sixJTableLookup(SixJTable *table, int twoJ1, int twoJ2, int twoJ3,
+	int twoJ4, int twoJ5, int twoJ6)
+{
+int t[6]={twoJ1,twoJ2,twoJ3,twoJ4,twoJ5,twoJ6};
+bool inTable=true;
+for (int i=0;i<6;i++) inTable&=(t[i]>=0 && t[i]<=table->maxTwoJ);
+if (!inTable) return sixJ(twoJ1,twoJ2,twoJ3,twoJ4,twoJ5,twoJ6);
+
+//	Triad and quadrilateral sums; they must be whole numbers, and the triangle
+//	inequalities hold exactly when every b is at least every a
+
+int sa[4]={t[0]+t[1]+t[2], t[0]+t[4]+t[5], t[3]+t[1]+t[5], t[3]+t[4]+t[2]};
+if ((sa[0]|sa[1]|sa[2]|sa[3])&1) return 0.0;
+int a[4]={sa[0]/2, sa[1]/2, sa[2]/2, sa[3]/2};
+int b[3]={(t[2]+t[5]+t[0]+t[3])/2, (t[0]+t[3]+t[1]+t[4])/2, (t[1]+t[4]+t[2]+t[5])/2};
+
+swapIf(a[0],a[1]); swapIf(a[2],a[3]); swapIf(a[0],a[2]); swapIf(a[1],a[3]); swapIf(a[1],a[2]);
+swapIf(b[0],b[1]); swapIf(b[1],b[2]); swapIf(b[0],b[1]);
+if (b[0]<a[3]) return 0.0;
+
+long long r=rankAlpha(a);
+long long row=table->dirRow[r]+(b[0]-table->dirB1Min[r]);
+return table->values[table->rowValue[row]+(b[1]-table->rowB2Min[row])];
+}
@@ -0,0 +1,137 @@
+/*
+
+6jTableMain.cpp
+===============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a main program that builds, checks and reads tables of 6j
+symbols made by writeSixJTable().
+
+	6jtable build <maxTwoJ> <file> [threads]
+
+computes every 6j symbol with 2j <= maxTwoJ, with the given number of threads (by
+default, one for each processor), and writes the table.
+
+	6jtable check <file>
+
+looks up every admissible six-tuple with 2j <= maxTwoJ in the table, compares it
+with sixJ(), and prints the number of lookups per second.
+
+	6jtable <file> <twoJ1> <twoJ2> <twoJ3> <twoJ4> <twoJ5> <twoJ6>
+
+prints a single symbol from the table.
+
+*/
+
+#include <thread>
+#include <string.h>
+#include "spin.h"
+
+void usage()
+{
+printf("usage:\t6jtable build <maxTwoJ> <file> [threads]\n");
+printf("\t6jtable check <file>\n");
+printf("\t6jtable <file> <6 values of 2j>\n");
+exit(2);
+}
+
+static bool triad(int a, int b, int c)
+{
+return (a+b+c)%2==0 && a<=b+c && b<=a+c && c<=a+b;
+}
+
+int main(int argc, char **argv)
+{
+if (argc<3) usage();
+
+if (strcmp(argv[1],"build")==0)
+	{
+	if (argc<4 || argc>5) usage();
+	int maxTwoJ=atoi(argv[2]);
+	int nThreads=argc==5 ? atoi(argv[4]) : (int)std::thread::hardware_concurrency();
+	time_t t0=time(NULL);
+	if (!writeSixJTable(argv[3],maxTwoJ,nThreads)) return 1;
+	SixJTable *table=openSixJTable(argv[3]);
+	if (table==NULL) return 1;
+	printf("%lld symbols with 2j <= %d, %lld bytes, %ld seconds\n",
+		table->nValues,maxTwoJ,table->fileBytes,(long)(time(NULL)-t0));
+	closeSixJTable(table);
+	return 0;
+	};
+
+if (strcmp(argv[1],"check")==0)
+	{
+	if (argc!=3) usage();
+	SixJTable *table=openSixJTable(argv[2]);
+	if (table==NULL) return 1;
+	int J=table->maxTwoJ;
+
+	//	Every admissible six-tuple, in the order of the loops
+
+	long long n=0, nBad=0;
+	double worst=0.0, check=0.0;
+	clock_t c0=clock();
+	int t[6];
+	for (t[0]=0;t[0]<=J;t[0]++)
+	for (t[1]=0;t[1]<=J;t[1]++)
+	for (t[2]=0;t[2]<=J;t[2]++)
+		{
+		if (!triad(t[0],t[1],t[2])) continue;
+		for (t[3]=0;t[3]<=J;t[3]++)
+		for (t[4]=0;t[4]<=J;t[4]++)
+			{
+			if (!triad(t[3],t[4],t[2])) continue;
+			for (t[5]=0;t[5]<=J;t[5]++)
+				{
+				if (!triad(t[0],t[4],t[5]) || !triad(t[3],t[1],t[5])) continue;
+				check+=sixJTableLookup(table,t[0],t[1],t[2],t[3],t[4],t[5]);
+				n++;
+				};
+			};
+		};
+	double seconds=(clock()-c0)/(double)CLOCKS_PER_SEC;
+
+	//	Compare with sixJ() on every 97th of them
+
+	long long k=0;
+	for (t[0]=0;t[0]<=J;t[0]++)
+	for (t[1]=0;t[1]<=J;t[1]++)
+	for (t[2]=0;t[2]<=J;t[2]++)
+		{
+		if (!triad(t[0],t[1],t[2])) continue;
+		for (t[3]=0;t[3]<=J;t[3]++)
+		for (t[4]=0;t[4]<=J;t[4]++)
+			{
+			if (!triad(t[3],t[4],t[2])) continue;
+			for (t[5]=0;t[5]<=J;t[5]++)
+				{
+				if (!triad(t[0],t[4],t[5]) || !triad(t[3],t[1],t[5])) continue;
+				if (k++%97!=0) continue;
+				double v=sixJTableLookup(table,t[0],t[1],t[2],t[3],t[4],t[5]);
+				double e=sixJ(t[0],t[1],t[2],t[3],t[4],t[5]);
+				double d=fabs(v-e);
+				if (d>worst) worst=d;
+				if (d>1e-12*(1.0+fabs(e))) nBad++;
+				};
+			};
+		};
+
+	printf("%lld lookups in %.3f seconds, %.4g per second (checksum %.17g)\n",
+		n,seconds,seconds>0.0 ? n/seconds : 0.0,check);
+	printf("%lld of them checked against sixJ(): %lld disagree, worst difference %.3g\n",
+		(k+96)/97,nBad,worst);
+	closeSixJTable(table);
+	return nBad==0 ? 0 : 1;
+	};
+
+if (argc!=8) usage();
+SixJTable *table=openSixJTable(argv[1]);
+if (table==NULL) return 1;
+int t[6];
+for (int i=0;i<6;i++) t[i]=atoi(argv[2+i]);
+printf("%.17g\n",(double)sixJTableLookup(table,t[0],t[1],t[2],t[3],t[4],t[5]));
+closeSixJTable(table);
+return 0;
+}
@@ -18,8 +18,16 @@ is not efficiently performed on this representation.
 The class also manages a list of prime numbers themselves, and a list of
 factorisations of factorials.
 
+The managed lists can be extended and read by several threads at once:  they
+are only ever extended while holding a lock, and the counts of valid entries
+are only increased once those entries are complete.  When an array has to be
+enlarged, the old copy is not deleted, since another thread might still be
+reading from it.
+
 */
 
+#include <atomic>
+#include <mutex>
 #include "PrimePowers.h"
 #include <math.h>
 
@@ -27,20 +35,25 @@ factorisations of factorials.
 
 //	Static data for a managed list of prime numbers
 
-static long long *primeList=0;			/*	Array of primes	*/
-static PPfloat *primeSqrts=0;			/*	Array of square roots of primes */
-static int nPrimeList=0;				/*	Count of primes			*/
+static std::atomic<long long *> primeList(0);	/*	Array of primes	*/
+static std::atomic<PPfloat *> primeSqrts(0);	/*	Array of square roots of primes */
+static std::atomic<int> nPrimeList(0);			/*	Count of primes			*/
 static int sPrimeList=0;				/*	Size of array primeList	*/
 static const int incPrimeList=10000;	/*	Increment when primeList is increased	*/
 
 //	Static data for a managed list of factorised factorials
 
-static PrimePowers **FPlist=0;		/*	Array of PrimePowers describing factorials	*/
-static PrimePowers **IPlist=0;		/*	Array of PrimePowers describing integers	*/
-static int nFPlist=0;				/*	Count of data in arrays FPlist, IPlist */
+static std::atomic<PrimePowers **> FPlist(0);	/*	Array of PrimePowers describing factorials	*/
+static std::atomic<PrimePowers **> IPlist(0);	/*	Array of PrimePowers describing integers	*/
+static std::atomic<int> nFPlist(0);				/*	Count of data in arrays FPlist, IPlist */
 static int sFPlist=0;				/*	Size of arrays FPlist, IPlist	*/
 static const int incFPlist=100;		/*	Increment when FPlist, IPlist are increased	*/
 
+//	Lock held while extending either list; recursive, since extending the list of
+//	factorials extends the list of primes
+
+static std::recursive_mutex listLock;
+
 //	Constructors
 //	============
 
@@ -236,6 +249,44 @@ return prod;
 
 /*
 
+evaluateScaled()
+================
+
+Returns the value of this PrimePowers object as a PPfloat, scaled by a power of 2
+which is returned in exponent; the product is rescaled as it is accumulated, so
+neither the intermediate products nor the result can overflow or underflow.
+	
+*/
+
+PPfloat PrimePowers::evaluateScaled(int &exponent)
+{
+int i,j,n,e;
+PPfloat prod=sign, factor;
+const PPfloat big=1e150, small=1e-150;
+
+exponent=0;
+for (i=0;i<nPowers;i++)
+if ((n=powers[i])!=0)
+	{
+	factor=primeList[i];
+	if (n>0) for (j=0;j<n;j++)
+		{
+		prod=prod*factor;
+		if (prod>big || prod<-big) {prod=frexp(prod,&e); exponent+=e;};
+		}
+	else for (j=0;j<-n;j++)
+		{
+		prod=prod/factor;
+		if (prod<small && prod>-small) {prod=frexp(prod,&e); exponent+=e;};
+		};
+	};
+prod=frexp(prod,&e);
+exponent+=e;
+return prod;
+}
+
+/*
+
 evaluateLongLong()
 ==================
 
@@ -307,6 +358,8 @@ bool isPrime;
 
 if (nPrimeList<=n)
 	{
+	std::lock_guard<std::recursive_mutex> lock(listLock);
+	
 	/*	Work out first candidate to test for being prime	*/
 	
 	topPrime = nPrimeList==0 ? -1 : primeList[nPrimeList-1];
@@ -349,8 +402,6 @@ if (nPrimeList<=n)
 						tmp[j]=primeList[j];
 						td[j]=primeSqrts[j];
 						};
-					delete [] primeList;
-					delete [] primeSqrts;
 					};
 				primeList=tmp;
 				primeSqrts=td;
@@ -382,6 +433,8 @@ PrimePowers **tmp;
 
 if (f>=nFPlist)						/*	Don't yet have data for f!	*/
 	{
+	std::lock_guard<std::recursive_mutex> lock(listLock);
+	
 	if (f>=sFPlist)					/*	Make room for lists to go up to f	*/
 		{
 		i=1+(f+1-sFPlist)/incFPlist;
@@ -391,7 +444,6 @@ if (f>=nFPlist)						/*	Don't yet have data for f!	*/
 		if (FPlist!=0)
 			{
 			for (j=0;j<sFPlist;j++) tmp[j]=FPlist[j];
-			delete [] FPlist;
 			};
 		FPlist=tmp;
 		
@@ -399,7 +451,6 @@ if (f>=nFPlist)						/*	Don't yet have data for f!	*/
 		if (IPlist!=0)
 			{
 			for (j=0;j<sFPlist;j++) tmp[j]=IPlist[j];
-			delete [] IPlist;
 			};
 		IPlist=tmp;
 
@@ -60,6 +60,7 @@ PrimePowers *multByFactorials(			//	Return product of this and some
 	int *factorials, int *fpowers,		//	integer powers of nfact factorials:
 	int nfact);							//	factorials[i]^fpowers[i]
 PPfloat evaluate();						//	Value of this, as type PPfloat
+PPfloat evaluateScaled(int &exponent);	//	Value of this as a PPfloat times 2^exponent
 long long evaluateLongLong();			//	Value of this, as a long long
 PPfloat evaluateSqrt();					//	Value of square root of this, as type PPfloat
 
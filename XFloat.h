@@ -0,0 +1,108 @@
+/*
+
+XFloat.h
+========
+
+Date:		18 October 2026
+Version:	1.0
+
+This header defines XFloat, a floating point number with an extended exponent:
+
+	m * 2^e
+
+where m is a double with 0.5 <= |m| < 1 (or m = 0), and e is an int.  This covers
+values far beyond the range of double or long double, with the precision of a
+double, so it can hold unnormalised tets, thetas and factorial ratios at spins
+where they would overflow.
+
+Only multiplication, division, addition and subtraction are provided, which is all
+the 10j calculations need.  Each operation renormalises its result with frexp(),
+so XFloat arithmetic is several times slower than plain doubles; the routines that
+use it keep their inner loops in plain doubles, scaled by powers of 2, and only use
+XFloat for the scale factors.
+
+*/
+
+#include <math.h>
+#include <stdio.h>
+
+struct XFloat
+	{
+	double m;					//	Mantissa, 0.5<=|m|<1, or zero
+	int e;						//	Exponent of 2
+
+	XFloat() : m(0.0), e(0) {}
+	XFloat(double x) {m=frexp(x,&e);}
+	XFloat(double x, int ex) {m=frexp(x,&e); if (m!=0.0) e+=ex;}
+
+	//	Value as a double; overflows to infinity or underflows to zero if out of range
+
+	double toDouble() const {return ldexp(m,e);}
+	};
+
+inline XFloat operator-(XFloat a)
+{
+a.m=-a.m;
+return a;
+}
+
+inline XFloat operator*(XFloat a, XFloat b)
+{
+return XFloat(a.m*b.m,a.e+b.e);
+}
+
+inline XFloat operator/(XFloat a, XFloat b)
+{
+return XFloat(a.m/b.m,a.e-b.e);
+}
+
+//	Addition aligns the smaller operand to the exponent of the larger; if they
+//	differ by more than the precision of a double, the smaller one is lost, just
+//	as in ordinary floating point addition.
+
+inline XFloat operator+(XFloat a, XFloat b)
+{
+if (a.m==0.0) return b;
+if (b.m==0.0) return a;
+if (a.e>=b.e) return XFloat(a.m+ldexp(b.m,b.e-a.e),a.e);
+return XFloat(b.m+ldexp(a.m,a.e-b.e),b.e);
+}
+
+inline XFloat operator-(XFloat a, XFloat b)
+{
+return a+(-b);
+}
+
+inline XFloat &operator*=(XFloat &a, XFloat b) {return a=a*b;}
+inline XFloat &operator/=(XFloat &a, XFloat b) {return a=a/b;}
+inline XFloat &operator+=(XFloat &a, XFloat b) {return a=a+b;}
+
+//	log10 of the absolute value, which is always in range
+
+inline double xLog10(XFloat a)
+{
+return log10(fabs(a.m))+a.e*log10(2.0);
+}
+
+//	xToString() writes a value in decimal scientific notation, with the given
+//	number of significant digits (at most 17), such as "-1.2345e-4567".
+
+inline char *xToString(XFloat a, int digits, char *buf)
+{
+if (a.m==0.0 || isinf(a.m) || isnan(a.m))
+	{
+	snprintf(buf,32,"%.*g",digits,a.m);
+	return buf;
+	};
+
+//	Split e*log10(2) into integer and fractional decimal exponents, in long double
+//	to keep the fractional part accurate for large e
+
+long double d=(long double)a.e*0.30102999566398119521373889472449302677L;
+long double dec=floorl(d);
+long double mant=a.m*powl(10.0L,d-dec);
+while (fabsl(mant)>=10.0L) {mant/=10.0L; dec+=1.0L;};
+while (fabsl(mant)<1.0L) {mant*=10.0L; dec-=1.0L;};
+snprintf(buf,48,"%.*Lfe%+.0Lf",digits-1,mant,dec);
+return buf;
+}
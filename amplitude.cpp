@@ -1,55 +1,441 @@
-#include <iostream>
-#include <cmath>
-using namespace std;
-
-class DFKR{
-    public:
-    double j_f[5] = {0,0.5,1,1.5,2};
-    int f;
-    int e;
-    int v;
-    
-    _Complex int A_f;
-    _Complex int A_e;
-    _Complex int A_v;
-
-    double j_e[4];      //  spins labelling 4 faces incident to each edge    //
-    double j_v[10];     //  spins labelling 10 faces incident to each vertex //
-
-    // construct adjacency matrix //
-    
-    const int adjacencies[5][4] = {
-    { 1, 2, 3, 4},
-    { 0, 2, 3, 4},
-    { 0, 1, 3, 4},
-    { 0, 1, 2, 4},
-    { 0, 1, 2, 3}
-
-    };
-    // gluings invovled in the 4-sphere triangulation along simplex boundary //
-    const int gluings[6][5][5] = {
-    { { 0, 1, 2, 3, 4}, {1,0,2,3,4}{}}    
-    { { 0, 1, 2, 3 }, { 1, 0, 2, 3 }, { 1, 2, 0, 3 }, { 1, 2, 3, 0 } },
-    { { 0, 1, 2, 3 }, { 0, 1, 2, 3 }, { 0, 2, 1, 3 }, { 0, 2, 3, 1 } },
-    { { 1, 0, 2, 3 }, { 0, 1, 2, 3 }, { 0, 1, 2, 3 }, { 0, 1, 3, 2 } },
-    { { 2, 0, 1, 3 }, { 0, 2, 1, 3 }, { 0, 1, 2, 3 }, { 0, 1, 2, 3 } },
-    { { 3, 0, 1, 2 }, { 0, 3, 1, 2 }, { 0, 1, 3, 2 }, { 0, 1, 2, 3 } }
-    _Complex int Z_F (_Complex int A_f, _Complex int A_e, _Complex int A_v){
-        // use 1 j_f ; product over 2-simplices -> face amplitude //
-        // 4j symbol //
-        for(f=0;f<i;f++){
-            return (2j(f) + 1) ** 2;
-
-        }
-        // use 4 spins j_e ; product over 3-simplices -> edge amplitude //
-        for(e=0;e<i;e++){
-
-        }
-        // use 10 spins j_v ; product over 4-simplices -> vertex amplitude //
-        for(v=0;v<i;v++){
-
-        }
-
-    };
-
-};
+/*
+
+amplitude.cpp
+=============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains routines that compute the amplitudes of spin foams in the
+Riemannian Barrett-Crane model, with the face and edge amplitudes of De Pietri,
+Freidel, Krasnov and Rovelli (DFKR).
+
+Reference:	J.C. Baez, J.D. Christensen, T.R. Halford and D.C. Tsang, "Spin Foam
+			Models of Riemannian Quantum Gravity", Class. Quant. Grav. 19 (2002)
+			4627.
+
+A spin foam lives on the dual 2-skeleton of a triangulated 4-manifold M:  its
+faces, edges and vertices are dual to the triangles, tetrahedra and 4-simplices
+of M, and each face is labelled by a spin j(f).  Its amplitude is
+
+	Z(F) = prod over faces A(f) * prod over edges A(e) * prod over vertices A(v)
+
+with
+
+	A(f) = (2j+1)^2,
+	A(e) = 1/fourJ(j1,j2,j3,j4), for the spins on the four triangles of the tet,
+	A(v) = the 10j symbol, for the spins on the ten triangles of the 4-simplex.
+
+The "4j symbol" fourJ(int twoJ1, int twoJ2, int twoJ3, int twoJ4) is the number of
+spins k for which (j1,j2,k) and (j3,j4,k) are both admissible; if it is zero for
+any tetrahedron, so is the amplitude.
+
+Triangulations are simplicial complexes given by the five vertex labels of each
+4-simplex; makeTriangulation(int nPent, int (*vertices)[5], Triangulation *tri)
+identifies the triangles and tetrahedra they share, and checks that every
+tetrahedron is a face of exactly two 4-simplices.  makeSphere4() gives the
+4-sphere as the boundary of a 5-simplex, and readTriangulation(const char *fileName,
+Triangulation *tri) reads a file listing the five vertex labels of each 4-simplex,
+one 4-simplex per line, or makes the 4-sphere if fileName is "S4".
+
+dfkrLogAmplitude(Triangulation *tri, int *twoJ, int &sign) computes the amplitude
+of the spin foam with double spins twoJ[] on the triangles, as the log of its
+absolute value and its sign (0 if the amplitude is zero); the product is formed
+in log space, so large foams cannot overflow.  If one of the 10j symbols is too
+large for tenJ() the result is NaN, with sign 0.
+
+The 10j symbols come from tenJCached(int *twoJ1, int *twoJ2), which keeps every
+value it computes, keyed by a canonical form of the symbol:  a 10j symbol is
+unchanged by any of the 120 permutations of the five vertices of its spin
+network, so the key is the smallest of the 120 relabellings of its ten spins.
+The cache is shared between threads; lookups take a shared lock, and a symbol
+that is missing is computed outside any lock, then added.  Once the values for
+the spins in use have been computed, evaluating a foam involves no 10j
+computations at all.  tenJCacheInfo() reports how well it is doing.  A symbol
+whose matrices would exceed maxC (spin.h) is not computed; it gives NaN, which is
+cached like any other value.
+
+*/
+
+#include <map>
+#include <vector>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <unordered_map>
+#include <stdint.h>
+#include <string.h>
+#include "spin.h"
+
+//	Largest 2j that fits in a cache key
+
+#define maxKeyTwoJ 4095
+
+//	------------------------
+//	**** Triangulations ***
+//	------------------------
+
+//	Sorted lists of vertex labels, for identifying shared faces
+
+static void sortLabels(int *v, int n)
+{
+for (int i=1;i<n;i++)
+	for (int k=i;k>0 && v[k-1]>v[k];k--)
+		{
+		int t=v[k]; v[k]=v[k-1]; v[k-1]=t;
+		};
+}
+
+//	makeTriangulation()
+//	===================
+
+bool makeTriangulation(int nPent, int (*vertices)[5], Triangulation *tri)
+{
+std::map<std::vector<int>,int> triangles, tets;
+std::vector<int> tetCount;
+
+tri->nPent=nPent;
+tri->nTriangles=tri->nTets=0;
+tri->pentVertices=new int[nPent][5];
+tri->pentTriangles=new int[nPent][10];
+tri->pentTets=new int[nPent][5];
+
+for (int p=0;p<nPent;p++)
+	{
+	int *v=tri->pentVertices[p];
+	for (int i=0;i<5;i++) v[i]=vertices[p][i];
+	for (int i=0;i<5;i++)
+		for (int k=i+1;k<5;k++)
+			if (v[i]==v[k])
+				{
+				printf("4-simplex %d has a repeated vertex %d\n",p,v[i]);
+				freeTriangulation(tri);
+				return false;
+				};
+
+	//	The tet opposite vertex i
+
+	for (int i=0;i<5;i++)
+		{
+		std::vector<int> t;
+		for (int k=0;k<5;k++) if (k!=i) t.push_back(v[k]);
+		sortLabels(&t[0],4);
+		std::map<std::vector<int>,int>::iterator it=tets.find(t);
+		int index;
+		if (it==tets.end())
+			{
+			index=(int)tets.size();
+			tets[t]=index;
+			tetCount.push_back(0);
+			}
+		else index=it->second;
+		tri->pentTets[p][i]=index;
+		tetCount[index]++;
+		};
+
+	//	The triangle opposite the vertices n, n+1 (n<5) or n-5, n-3 (n>=5), which
+	//	carries the spin on that edge of the 10j symbol's spin network
+
+	for (int n=0;n<10;n++)
+		{
+		int a=n<5 ? n : n-5, b=n<5 ? (n+1)%5 : (n-3)%5;
+		std::vector<int> t;
+		for (int k=0;k<5;k++) if (k!=a && k!=b) t.push_back(v[k]);
+		sortLabels(&t[0],3);
+		std::map<std::vector<int>,int>::iterator it=triangles.find(t);
+		int index;
+		if (it==triangles.end())
+			{
+			index=(int)triangles.size();
+			triangles[t]=index;
+			}
+		else index=it->second;
+		tri->pentTriangles[p][n]=index;
+		};
+	};
+
+for (size_t t=0;t<tetCount.size();t++)
+	if (tetCount[t]!=2)
+		{
+		printf("Tetrahedron %d is a face of %d 4-simplices, not 2\n",(int)t,tetCount[t]);
+		freeTriangulation(tri);
+		return false;
+		};
+
+//	List the vertices of the triangles and tets, and the triangles of each tet
+
+tri->nTriangles=(int)triangles.size();
+tri->nTets=(int)tets.size();
+tri->triangleVertices=new int[tri->nTriangles][3];
+tri->tetVertices=new int[tri->nTets][4];
+tri->tetTriangles=new int[tri->nTets][4];
+for (std::map<std::vector<int>,int>::iterator it=triangles.begin();it!=triangles.end();it++)
+	for (int i=0;i<3;i++) tri->triangleVertices[it->second][i]=it->first[i];
+for (std::map<std::vector<int>,int>::iterator it=tets.begin();it!=tets.end();it++)
+	{
+	int *tv=tri->tetVertices[it->second];
+	for (int i=0;i<4;i++) tv[i]=it->first[i];
+	for (int i=0;i<4;i++)
+		{
+		std::vector<int> t;
+		for (int k=0;k<4;k++) if (k!=i) t.push_back(tv[k]);
+		tri->tetTriangles[it->second][i]=triangles[t];
+		};
+	};
+return true;
+}
+
+void freeTriangulation(Triangulation *tri)
+{
+delete [] tri->pentVertices;
+delete [] tri->pentTriangles;
+delete [] tri->pentTets;
+if (tri->nTriangles>0) delete [] tri->triangleVertices;
+if (tri->nTets>0)
+	{
+	delete [] tri->tetVertices;
+	delete [] tri->tetTriangles;
+	};
+tri->nPent=tri->nTriangles=tri->nTets=0;
+}
+
+//	makeSphere4() gives the boundary of the 5-simplex on vertices 0..5
+
+bool makeSphere4(Triangulation *tri)
+{
+int vertices[6][5];
+for (int p=0;p<6;p++)
+	for (int i=0,k=0;i<6;i++) if (i!=p) vertices[p][k++]=i;
+return makeTriangulation(6,vertices,tri);
+}
+
+//	readTriangulation()
+//	===================
+
+bool readTriangulation(const char *fileName, Triangulation *tri)
+{
+if (strcmp(fileName,"S4")==0) return makeSphere4(tri);
+FILE *fp=fopen(fileName,"r");
+if (fp==NULL)
+	{
+	printf("Could not open %s\n",fileName);
+	return false;
+	};
+int n=0, size=16, (*v)[5]=new int[size][5];
+while (fscanf(fp,"%d %d %d %d %d",&v[n][0],&v[n][1],&v[n][2],&v[n][3],&v[n][4])==5)
+	{
+	if (++n==size)
+		{
+		int (*w)[5]=new int[2*size][5];
+		memcpy(w,v,size*sizeof(*v));
+		delete [] v;
+		v=w;
+		size*=2;
+		};
+	};
+fclose(fp);
+bool ok=makeTriangulation(n,v,tri);
+delete [] v;
+return ok;
+}
+
+//	--------------------------
+//	**** Cache of 10j values ***
+//	--------------------------
+
+//	The ten spins of a symbol, as a 5x5 symmetric matrix of labels between the
+//	vertices of its spin network, packed 12 bits each into two words
+
+struct TenJKey
+	{
+	uint64_t w[2];
+	bool operator==(const TenJKey &k) const {return w[0]==k.w[0] && w[1]==k.w[1];}
+	};
+
+struct TenJKeyHash
+	{
+	size_t operator()(const TenJKey &k) const
+		{
+		uint64_t h=k.w[0]*0x9e3779b97f4a7c15ULL^(k.w[1]+0x7f4a7c159e3779b9ULL+(k.w[0]<<6));
+		return (size_t)(h^(h>>29));
+		}
+	};
+
+static std::unordered_map<TenJKey,TENJfloat,TenJKeyHash> tenJCache;
+static std::shared_mutex tenJCacheLock;
+static std::atomic<long long> cacheHits(0), cacheMisses(0);
+
+//	The 120 permutations of the vertices, made once
+
+static int perms[120][5];
+static std::once_flag permsMade;
+
+static void makePerms()
+{
+int p[5]={0,1,2,3,4}, n=0;
+while (true)
+	{
+	for (int i=0;i<5;i++) perms[n][i]=p[i];
+	n++;
+
+	//	Next permutation in lexicographic order
+
+	int i=3;
+	while (i>=0 && p[i]>p[i+1]) i--;
+	if (i<0) break;
+	int k=4;
+	while (p[k]<p[i]) k--;
+	int t=p[i]; p[i]=p[k]; p[k]=t;
+	for (int a=i+1,b=4;a<b;a++,b--) {t=p[a]; p[a]=p[b]; p[b]=t;};
+	};
+}
+
+//	canonicalTenJ() finds the relabelling of a symbol whose spins, read in the
+//	order of twoJ1[0..4] then twoJ2[0..4], come first lexicographically
+
+static void canonicalTenJ(int *twoJ1, int *twoJ2, int *c1, int *c2)
+{
+std::call_once(permsMade,makePerms);
+int L[5][5];
+for (int i=0;i<5;i++)
+	{
+	L[i][(i+1)%5]=L[(i+1)%5][i]=twoJ1[i];
+	L[i][(i+2)%5]=L[(i+2)%5][i]=twoJ2[i];
+	};
+int best[10];
+for (int i=0;i<5;i++) {best[i]=twoJ1[i]; best[5+i]=twoJ2[i];};
+for (int q=1;q<120;q++)
+	{
+	int *p=perms[q], x[10], cmp=0;
+	for (int n=0;n<10;n++)
+		{
+		int a=n<5 ? n : n-5, b=n<5 ? (n+1)%5 : (n-3)%5;
+		x[n]=L[p[a]][p[b]];
+		if (cmp==0 && x[n]>best[n]) break;
+		if (cmp==0 && x[n]<best[n]) cmp=-1;
+		};
+	if (cmp<0) for (int n=0;n<10;n++) best[n]=x[n];
+	};
+for (int i=0;i<5;i++) {c1[i]=best[i]; c2[i]=best[5+i];};
+}
+
+//	tenJCached()
+//	============
+
+TENJfloat tenJCached(int *twoJ1, int *twoJ2)
+{
+int c1[5], c2[5];
+canonicalTenJ(twoJ1,twoJ2,c1,c2);
+
+TenJKey key;
+key.w[0]=key.w[1]=0;
+bool fits=true;
+for (int i=0;i<5;i++)
+	{
+	fits&=(c1[i]>=0 && c1[i]<=maxKeyTwoJ && c2[i]>=0 && c2[i]<=maxKeyTwoJ);
+	key.w[0]|=(uint64_t)(c1[i]&0xfff)<<(12*i);
+	key.w[1]|=(uint64_t)(c2[i]&0xfff)<<(12*i);
+	};
+
+if (fits)
+	{
+	std::shared_lock<std::shared_mutex> lock(tenJCacheLock);
+	std::unordered_map<TenJKey,TENJfloat,TenJKeyHash>::iterator it=tenJCache.find(key);
+	if (it!=tenJCache.end())
+		{
+		cacheHits++;
+		return it->second;
+		};
+	};
+cacheMisses++;
+
+bool regular=true;
+for (int i=0;i<5;i++) regular&=(c1[i]==c1[0] && c2[i]==c1[0]);
+TenJSetup setup;
+TENJfloat value=NAN;
+if (tenJSetup(c1,c2,&setup)) value=regular ? tenJ(c1[0]) : tenJ(c1,c2);
+
+if (fits)
+	{
+	std::unique_lock<std::shared_mutex> lock(tenJCacheLock);
+	tenJCache[key]=value;
+	};
+return value;
+}
+
+void tenJCacheInfo(long long &entries, long long &hits, long long &misses)
+{
+std::shared_lock<std::shared_mutex> lock(tenJCacheLock);
+entries=(long long)tenJCache.size();
+hits=cacheHits;
+misses=cacheMisses;
+}
+
+//	-----------------------
+//	**** DFKR amplitudes ***
+//	-----------------------
+
+//	fourJ()
+//	=======
+
+int fourJ(int twoJ1, int twoJ2, int twoJ3, int twoJ4)
+{
+if ((twoJ1+twoJ2+twoJ3+twoJ4)%2!=0) return 0;
+int lo1=abs(twoJ1-twoJ2), lo2=abs(twoJ3-twoJ4);
+int hi1=twoJ1+twoJ2, hi2=twoJ3+twoJ4;
+int lo=max(lo1,lo2), hi=min(hi1,hi2);
+return hi<lo ? 0 : (hi-lo)/2+1;
+}
+
+//	dfkrLogAmplitude()
+//	==================
+
+double dfkrLogAmplitude(Triangulation *tri, int *twoJ, int &sign)
+{
+double logAmp=0.0;
+sign=1;
+
+//	Faces
+
+for (int f=0;f<tri->nTriangles;f++) logAmp+=2.0*log((double)(twoJ[f]+1));
+
+//	Edges
+
+for (int e=0;e<tri->nTets;e++)
+	{
+	int *t=tri->tetTriangles[e];
+	int n=fourJ(twoJ[t[0]],twoJ[t[1]],twoJ[t[2]],twoJ[t[3]]);
+	if (n==0)
+		{
+		sign=0;
+		return -INFINITY;
+		};
+	logAmp-=log((double)n);
+	};
+
+//	Vertices
+
+for (int v=0;v<tri->nPent;v++)
+	{
+	int *t=tri->pentTriangles[v], twoJ1[5], twoJ2[5];
+	for (int i=0;i<5;i++)
+		{
+		twoJ1[i]=twoJ[t[i]];
+		twoJ2[i]=twoJ[t[5+i]];
+		};
+	TENJfloat a=tenJCached(twoJ1,twoJ2);
+	if (isnan(a))
+		{
+		sign=0;
+		return NAN;
+		};
+	if (a==0.0)
+		{
+		sign=0;
+		return -INFINITY;
+		};
+	if (a<0.0) sign=-sign;
+	logAmp+=log(fabs((double)a));
+	};
+return logAmp;
+}
@@ -0,0 +1,327 @@
+/*
+
+asymptotic.cpp
+==============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains routines that approximate 10j symbols with large spins from
+their asymptotic behaviour, and that choose between the approximation and tenJ().
+
+Reference:	J.C. Baez, J.D. Christensen and G. Egan, "Asymptotics of 10j Symbols",
+			Class. Quant. Grav. 19 (2002) 6489.
+
+When all the areas a = 2j+1 of a 10j symbol are multiplied by a large factor lambda,
+the symbol falls off as a power of lambda without oscillating; the dominant
+contributions come from degenerate 4-simplices.  For the regular symbols the power
+is -2, but it depends on the shape:  for 2j = k*{2,3,1,2,1}, k*{1,3,1,2,2}, for
+example, it is -3.  There is no closed form for the coefficient, so we measure
+both:  we compute exact values of tenJ() for smaller multiples of the same shape,
+and fit
+
+	log |10j| = c0 + c1 log(lambda) + c2/lambda + c3/lambda^2
+
+where lambda is the mean of the ten areas.  A symbol is taken to lie on the ray
+k*(twoJ1, twoJ2)/g, where g is the greatest common divisor of its ten 2j values,
+at k = g.  Only multiples k with the same parity as g are used, since odd and
+even multiples of some shapes behave quite differently; a symbol with a small g
+has too few smaller multiples, and cannot be approximated.
+
+The sub-leading contributions from non-degenerate 4-simplices oscillate slowly,
+so the fit is only good to a few significant digits.  Its error is estimated as
+three times the larger of:
+
+	the difference between the four-term fit and a three-term fit (without c3)
+	at the lambda of interest, and
+
+	the error of a fit to all but the largest calibration symbol, in predicting
+	that symbol.
+
+The factor of three was chosen from the regular symbols up to 2j=60 and a few
+other shapes, for which the estimate then bounds the actual error.
+
+tenJAsymptoticFit(int *twoJ1, int *twoJ2, double budget, TenJAsymptotic *fit)
+calibrates the ray through a symbol, spending about budget seconds on exact values;
+it returns false if too few smaller multiples can be computed in that time.
+
+tenJAsymptotic(TenJAsymptotic *fit, int k, double &error) gives the approximate
+value of the multiple k of the fitted ray, with its estimated relative error, in
+O(1) time.
+
+This is not a closed-form asymptotic formula, and it only covers symbols that are
+large multiples of a small one:  the regular symbols, whose ray is {1,...,1}, and
+general symbols whose spins have a large common divisor.  A symbol whose ray has
+too few smaller multiples cannot be approximated at all.
+
+tenJAuto(int *twoJ1, int *twoJ2, double tolerance, TENJfloat &value, bool &asymptotic)
+chooses:  symbols whose exact value tenJPlan() predicts will take less time than
+calibrating a ray are computed exactly, as are symbols whose estimated error
+exceeds the tolerance; the rest are approximated.  For a symbol too large for
+tenJ.cpp's matrices, only the approximation is possible, so if its ray cannot be
+fitted, or the estimated error exceeds the tolerance, tenJAuto() returns false
+and sets value to NaN; tenJX() can still compute such a symbol exactly, slowly.
+Fits are kept for every ray used, and can be shared between threads.
+
+*/
+
+#include <mutex>
+#include <vector>
+#include "spin.h"
+
+//	Time to spend calibrating a ray for tenJAuto(), in seconds
+
+#define autoCalibrationSeconds 2.0
+
+//	Number of calibration symbols to use, at most and at least; the hold-out
+//	check needs more symbols than there are coefficients in the fit
+
+#define maxFit 8
+#define minFit 6
+
+//	Safety factor for error estimates
+
+#define errorSafety 3.0
+
+//	Helpers
+//	=======
+
+//	rayOf() reduces a symbol to the smallest one in the same direction, by
+//	dividing by the greatest common divisor of the spins, which it returns
+
+static int rayOf(int *twoJ1, int *twoJ2, int *ray1, int *ray2)
+{
+int g=0;
+for (int i=0;i<10;i++)
+	{
+	int a=i<5 ? twoJ1[i] : twoJ2[i-5], b=g;
+	while (b!=0) {int t=a%b; a=b; b=t;};
+	g=a;
+	};
+if (g==0) g=1;
+for (int i=0;i<5;i++)
+	{
+	ray1[i]=twoJ1[i]/g;
+	ray2[i]=twoJ2[i]/g;
+	};
+return g;
+}
+
+//	multiple() gives the multiple k of a ray, and its mean area
+
+static double multiple(int *ray1, int *ray2, int k, int *s1, int *s2)
+{
+double a=0.0;
+for (int i=0;i<5;i++)
+	{
+	s1[i]=k*ray1[i];
+	s2[i]=k*ray2[i];
+	a+=s1[i]+s2[i]+2;
+	};
+return a/10.0;
+}
+
+//	exactTenJ() computes a symbol exactly, with the faster routine for regular ones
+
+static TENJfloat exactTenJ(int *twoJ1, int *twoJ2)
+{
+bool regular=true;
+for (int i=0;i<5;i++) regular&=(twoJ1[i]==twoJ1[0] && twoJ2[i]==twoJ1[0]);
+if (regular) return tenJ(twoJ1[0]);
+return tenJ(twoJ1,twoJ2);
+}
+
+//	basis() gives the functions of lambda in the fit
+
+static void basis(double lambda, double *x)
+{
+x[0]=1.0;
+x[1]=log(lambda);
+x[2]=1.0/lambda;
+x[3]=1.0/(lambda*lambda);
+}
+
+static double model(double *c, int n, double lambda)
+{
+double x[4], v=0.0;
+basis(lambda,x);
+for (int i=0;i<n;i++) v+=c[i]*x[i];
+return exp(v);
+}
+
+//	fitLog() fits the first n coefficients c[] to log |y[]| at points lambda[] by
+//	least squares; it returns false if the equations are degenerate
+
+static bool fitLog(double *lambda, double *y, int m, int n, double *c)
+{
+double A[4][4], b[4];
+for (int r=0;r<n;r++)
+	{
+	b[r]=0.0;
+	for (int q=0;q<n;q++) A[r][q]=0.0;
+	};
+for (int k=0;k<m;k++)
+	{
+	double x[4], ly=log(fabs(y[k]));
+	basis(lambda[k],x);
+	for (int r=0;r<n;r++)
+		{
+		for (int q=0;q<n;q++) A[r][q]+=x[r]*x[q];
+		b[r]+=x[r]*ly;
+		};
+	};
+for (int p=0;p<n;p++)
+	{
+	if (A[p][p]==0.0) return false;
+	for (int r=p+1;r<n;r++)
+		{
+		double f=A[r][p]/A[p][p];
+		for (int q=p;q<n;q++) A[r][q]-=f*A[p][q];
+		b[r]-=f*b[p];
+		};
+	};
+for (int p=n-1;p>=0;p--)
+	{
+	double v=b[p];
+	for (int q=p+1;q<n;q++) v-=A[p][q]*c[q];
+	c[p]=v/A[p][p];
+	};
+return true;
+}
+
+//	tenJAsymptoticFit()
+//	===================
+
+bool tenJAsymptoticFit(int *twoJ1, int *twoJ2, double budget, TenJAsymptotic *fit)
+{
+int g=rayOf(twoJ1,twoJ2,fit->ray1,fit->ray2);
+fit->parity=g%2;
+fit->valid=false;
+
+//	Find the largest smaller multiple we can afford, with half the budget; the
+//	others cost much less, since the time grows with a high power of the spins
+
+int s1[5], s2[5], kTop=g-2;
+for (;kTop>=1;kTop-=2)
+	{
+	multiple(fit->ray1,fit->ray2,kTop,s1,s2);
+	TenJPlan plan;
+	tenJPlan(s1,s2,&plan);
+	if (plan.admissible && plan.seconds<=budget/2) break;
+	};
+
+//	Spread the calibration multiples between a third of that and that, largest
+//	first, keeping the parity of g
+
+int ks[maxFit], n=0;
+int nBand=(kTop-kTop/3)/2+1;
+for (int q=0;q<maxFit && q<nBand && kTop>=1;q++)
+	{
+	int k=kTop-2*(nBand<=maxFit ? q : (q*(nBand-1))/(maxFit-1));
+	if (n==0 || k!=ks[n-1]) ks[n++]=k;
+	};
+if (n<minFit) return false;
+
+//	Compute them exactly; they must all be non-zero and have the same sign
+
+double lambda[maxFit], y[maxFit];
+for (int q=0;q<n;q++)
+	{
+	lambda[q]=multiple(fit->ray1,fit->ray2,ks[q],s1,s2);
+	y[q]=exactTenJ(s1,s2);
+	if (y[q]==0.0 || (y[q]>0.0)!=(y[0]>0.0)) return false;
+	};
+fit->sign=y[0]>0.0 ? 1 : -1;
+
+//	The largest symbol is first; hold it out to check the fit
+
+double held[4];
+if (!fitLog(lambda+1,y+1,n-1,4,held)) return false;
+fit->holdError=fabs(model(held,4,lambda[0])-fabs(y[0]))/fabs(y[0]);
+
+if (!fitLog(lambda,y,n,4,fit->c)) return false;
+if (!fitLog(lambda,y,n,3,fit->c3)) return false;
+fit->nFit=n;
+fit->kMax=ks[0];
+fit->valid=true;
+return true;
+}
+
+//	tenJAsymptotic()
+//	================
+
+double tenJAsymptotic(TenJAsymptotic *fit, int k, double &error)
+{
+int s1[5], s2[5];
+double lambda=multiple(fit->ray1,fit->ray2,k,s1,s2);
+double v4=model(fit->c,4,lambda), v3=model(fit->c3,3,lambda);
+double spread=fabs(v4-v3)/v4;
+error=errorSafety*(spread>fit->holdError ? spread : fit->holdError);
+return fit->sign*v4;
+}
+
+//	tenJAuto()
+//	==========
+
+static std::vector<TenJAsymptotic> fits;
+static std::mutex fitsLock;
+
+bool tenJAuto(int *twoJ1, int *twoJ2, double tolerance, TENJfloat &value, bool &asymptotic)
+{
+asymptotic=false;
+
+//	Cheap symbols are computed exactly; symbols too large for tenJ() can only be
+//	approximated
+
+TenJPlan plan;
+tenJPlan(twoJ1,twoJ2,&plan);
+if (plan.admissible && plan.seconds<=autoCalibrationSeconds)
+	{
+	value=exactTenJ(twoJ1,twoJ2);
+	return true;
+	};
+
+//	Find or make the fit for this ray; a ray that cannot be fitted is recorded
+//	as invalid, so we only try once
+
+int ray1[5], ray2[5];
+int g=rayOf(twoJ1,twoJ2,ray1,ray2);
+TenJAsymptotic fit;
+bool found=false;
+	{
+	std::lock_guard<std::mutex> lock(fitsLock);
+	for (size_t q=0;q<fits.size() && !found;q++)
+		{
+		found=(fits[q].parity==g%2);
+		for (int i=0;i<5;i++)
+			found&=(fits[q].ray1[i]==ray1[i] && fits[q].ray2[i]==ray2[i]);
+		if (found) fit=fits[q];
+		};
+	}
+if (!found)
+	{
+	tenJAsymptoticFit(twoJ1,twoJ2,autoCalibrationSeconds,&fit);
+	std::lock_guard<std::mutex> lock(fitsLock);
+	fits.push_back(fit);
+	};
+
+//	Approximate if the fit is good enough, and we would be extrapolating
+
+if (fit.valid && g>fit.kMax)
+	{
+	double error, v=tenJAsymptotic(&fit,g,error);
+	if (error<=tolerance)
+		{
+		asymptotic=true;
+		value=v;
+		return true;
+		};
+	};
+if (!plan.admissible)
+	{
+	value=NAN;
+	return false;
+	};
+value=exactTenJ(twoJ1,twoJ2);
+return true;
+}
@@ -0,0 +1,119 @@
+/*
+
+asymptoticMain.cpp
+==================
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a main program that checks the asymptotic approximation in
+asymptotic.cpp against tenJ(), across the band of spins where tenJAuto() switches
+from one to the other.
+
+	10jasym [-b budget] [-r seconds] [-t tolerance] <twoJ1[0..4]> <twoJ2[0..4]>
+
+fits the ray through the given symbol, spending about budget seconds (default 2),
+and then computes the multiples of the ray from the largest one used in the fit up
+to the given symbol, both exactly and from the fit.  Symbols whose exact value
+tenJPlan() predicts would take more than the given number of seconds (default 60)
+end the report.  For each symbol it prints the multiple, the mean area lambda,
+both values, the actual and estimated relative errors, the time for the exact
+value, and which method tenJAuto() would choose for the tolerance (default 1e-3).
+
+The summary says how often the estimated error failed to bound the actual error,
+and how often the approximation would have been chosen but was out of tolerance.
+
+*/
+
+#include <string.h>
+#include "spin.h"
+
+void usage()
+{
+printf("usage:\t10jasym [-b budget] [-r seconds] [-t tolerance] <10 values of 2j>\n");
+exit(2);
+}
+
+int main(int argc, char **argv)
+{
+double budget=2.0, maxSeconds=60.0, tolerance=1e-3;
+int arg=1;
+while (arg<argc && argv[arg][0]=='-')
+	{
+	if (arg+1>=argc) usage();
+	if (strcmp(argv[arg],"-b")==0) budget=atof(argv[arg+1]);
+	else if (strcmp(argv[arg],"-r")==0) maxSeconds=atof(argv[arg+1]);
+	else if (strcmp(argv[arg],"-t")==0) tolerance=atof(argv[arg+1]);
+	else usage();
+	arg+=2;
+	};
+if (argc-arg!=10) usage();
+
+int twoJ1[5], twoJ2[5];
+for (int i=0;i<5;i++)
+	{
+	twoJ1[i]=atoi(argv[arg+i]);
+	twoJ2[i]=atoi(argv[arg+5+i]);
+	};
+
+TenJAsymptotic fit;
+if (!tenJAsymptoticFit(twoJ1,twoJ2,budget,&fit))
+	{
+	printf("Could not fit this ray within %g seconds\n",budget);
+	return 1;
+	};
+
+//	The given symbol is the multiple g of the ray
+
+int g=0;
+for (int i=0;i<5;i++) g+=twoJ1[i]+twoJ2[i];
+g/=fit.ray1[0]+fit.ray1[1]+fit.ray1[2]+fit.ray1[3]+fit.ray1[4]+
+	fit.ray2[0]+fit.ray2[1]+fit.ray2[2]+fit.ray2[3]+fit.ray2[4];
+
+printf("Ray {{%d,%d,%d,%d,%d},{%d,%d,%d,%d,%d}}, multiples up to %d\n",
+	fit.ray1[0],fit.ray1[1],fit.ray1[2],fit.ray1[3],fit.ray1[4],
+	fit.ray2[0],fit.ray2[1],fit.ray2[2],fit.ray2[3],fit.ray2[4],g);
+printf("Fitted %d multiples up to %d: power %.6f, hold-out error %.2e\n",
+	fit.nFit,fit.kMax,fit.c[1],fit.holdError);
+printf("%6s %8s %24s %24s %9s %9s %9s %s\n",
+	"k","lambda","exact","asymptotic","actual","estimate","seconds","choice");
+
+int nShown=0, nUnder=0, nWrong=0;
+for (int k=fit.kMax+2;k<=g;k+=2)
+	{
+	int s1[5], s2[5];
+	double lambda=0.0;
+	for (int i=0;i<5;i++)
+		{
+		s1[i]=k*fit.ray1[i];
+		s2[i]=k*fit.ray2[i];
+		lambda+=(s1[i]+s2[i]+2)/10.0;
+		};
+
+	TenJPlan plan;
+	tenJPlan(s1,s2,&plan);
+	if (!plan.admissible || plan.seconds>maxSeconds) break;
+
+	bool regular=true;
+	for (int i=0;i<5;i++) regular&=(s1[i]==s1[0] && s2[i]==s1[0]);
+	clock_t c0=clock();
+	TENJfloat exact=regular ? tenJ(s1[0]) : tenJ(s1,s2);
+	double seconds=(clock()-c0)/(double)CLOCKS_PER_SEC;
+	double estimate, approx=tenJAsymptotic(&fit,k,estimate);
+	double actual=fabs(approx-exact)/fabs(exact);
+	bool useAsymptotic=estimate<=tolerance;
+
+	printf("%6d %8.2f %24.17g %24.17g %9.2e %9.2e %9.3f %s\n",
+		k,lambda,(double)exact,approx,actual,estimate,seconds,
+		useAsymptotic ? "asymptotic" : "exact");
+	fflush(stdout);
+
+	nShown++;
+	if (actual>estimate) nUnder++;
+	if (useAsymptotic && actual>tolerance) nWrong++;
+	};
+
+printf("%d symbols; estimate below actual error for %d; asymptotic chosen but out of tolerance for %d\n",
+	nShown,nUnder,nWrong);
+return 0;
+}
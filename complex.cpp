@@ -0,0 +1,496 @@
+/*
+
+complex.cpp
+===========
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains routines that build triangulations of 3- and 4-manifolds from
+gluing tables, in the format written by Regina's dumpConstruction() (see hi.cpp),
+and precompute the incidences that state sums need, in flat arrays.
+
+	bool makeComplex(int dim, int nTop, const int *adjacencies, const int *gluings,
+		Complex *c)
+
+takes nTop top-dimensional simplices (tetrahedra for dim=3, 4-simplices for dim=4),
+each with dim+1 vertices numbered 0..dim.  Facet f of a simplex is the one opposite
+its vertex f; adjacencies[s*(dim+1)+f] is the simplex glued to simplex s along it,
+or -1 if it is on the boundary, and gluings[(s*(dim+1)+f)*(dim+1)+i] is the vertex
+of that simplex that vertex i of s is glued to.  These are the arrays
+adjacencies[nTop][dim+1] and gluings[nTop][dim+1][dim+1] of Regina's output, and
+as there, each gluing must be given from both sides.
+
+A state sum on such a triangulation labels its codimension-2 faces ("hinges":
+edges for dim=3, triangles for dim=4) with spins, weighs the facets (triangles,
+tets) and the top simplices (a 6j or 10j symbol each).  These are the faces, edges
+and vertices of the dual 2-skeleton.  The Complex holds:
+
+	topVertices, topFacets, topHinges	the vertices, facets and hinges of each
+		top simplex, dim+1, dim+1 and dim(dim+1)/2 of them, stored contiguously;
+		facet f is opposite vertex f, and the hinges are in the order of the
+		arguments of sixJ() (dim=3) or tenJ() (dim=4), as listed below
+	facetTops, facetHinges				the top simplices on the two sides of each
+		facet (the second -1 on the boundary), and its dim hinges, opposite its
+		vertices in increasing order
+	hingeTopStart, hingeTops			for each hinge, the top simplices around it,
+		in cyclic order:  these are the vertices of its dual face, and hingeTops
+		from hingeTopStart[h] to hingeTopStart[h+1]-1 lists them
+	hingeFacetStart, hingeFacets		likewise the facets around each hinge, the
+		edges of its dual face, where hingeFacets[k] joins hingeTops[k] to the next
+		top simplex; a hinge on the boundary has one more facet than top simplices,
+		both ends being boundary facets
+	vertexTopStart, vertexTops			the top simplices containing each vertex
+
+The variable-length lists are in compressed sparse row form:  one array of all the
+entries, and an array of nHinges+1 (or nVertices+1) offsets into it.  A state-sum
+loop therefore runs over contiguous arrays of ints, with no pointers to follow.
+
+Vertices, facets and hinges are identified by following the gluings: vertices by
+union-find, hinges by walking around each one through the top simplices that
+contain it, entering by one facet and leaving by the other.  The complex need not
+be simplicial:  a simplex may meet itself, or another simplex in several faces.
+
+For a tetrahedron with vertices 0..3, the hinges are the edges
+
+	j1 = 01, j2 = 02, j3 = 12, j4 = 23, j5 = 13, j6 = 03
+
+so that the tet's 6j symbol is sixJ(j1, ..., j6); for a 4-simplex, hinge n is the
+triangle opposite the vertices n, n+1 (n<5) or n-5, n-3 (n>=5), mod 5, the same
+order as in amplitude.cpp, so that its 10j symbol is tenJ() of the first five and
+the last five.
+
+complexTriangulation(Complex *c, Triangulation *tri) copies a 4-dimensional complex
+into a Triangulation, for dfkrLogAmplitude() and partitionSum(); the vertex labels
+in the Triangulation are the vertex classes of the complex.  triangulationComplex(
+Triangulation *tri, Complex *c) goes the other way, gluing the 4-simplices of a
+Triangulation along the tets they share; top simplex s is 4-simplex s, with its
+vertices in the same order, and the hinges and facets are numbered as the
+triangles and tets of the Triangulation, so that spins on its triangles can be
+used with the incidences of the Complex.  makeSphereComplex(int dim, Complex *c)
+glues up the boundary of a (dim+1)-simplex, and freeComplex() frees the arrays.
+
+*/
+
+#include <vector>
+#include "spin.h"
+
+//	The two vertices of a top simplex that each hinge is opposite
+
+static const int hingePairs3[6][2]={{2,3},{1,3},{0,3},{0,1},{0,2},{1,2}};
+static const int hingePairs4[10][2]={{0,1},{1,2},{2,3},{3,4},{4,0},
+	{0,2},{1,3},{2,4},{3,0},{4,1}};
+
+static const int (*hingePairs(int dim))[2]
+{
+return dim==3 ? hingePairs3 : hingePairs4;
+}
+
+//	Union-find with path halving
+
+static int findRoot(std::vector<int> &parent, int i)
+{
+while (parent[i]!=i)
+	{
+	parent[i]=parent[parent[i]];
+	i=parent[i];
+	};
+return i;
+}
+
+//	makeComplex()
+//	=============
+
+bool makeComplex(int dim, int nTop, const int *adjacencies, const int *gluings, Complex *c)
+{
+c->dim=dim;
+c->nTop=nTop;
+c->nFacets=c->nHinges=c->nVertices=0;
+if (dim!=3 && dim!=4)
+	{
+	printf("Only 3- and 4-dimensional complexes are supported, not %d\n",dim);
+	return false;
+	};
+int nV=dim+1, nH=dim*(dim+1)/2;
+const int (*pairs)[2]=hingePairs(dim);
+int pairIndex[5][5];
+for (int k=0;k<nH;k++)
+	pairIndex[pairs[k][0]][pairs[k][1]]=pairIndex[pairs[k][1]][pairs[k][0]]=k;
+
+//	Check that the gluings are permutations, and match from both sides
+
+for (int s=0;s<nTop;s++)
+	for (int f=0;f<nV;f++)
+		{
+		int t=adjacencies[s*nV+f];
+		if (t<0) continue;
+		const int *g=gluings+(s*nV+f)*nV;
+		int seen=0;
+		for (int i=0;i<nV;i++)
+			if (g[i]>=0 && g[i]<nV) seen|=1<<g[i];
+		if (t>=nTop || seen!=(1<<nV)-1)
+			{
+			printf("Facet %d of simplex %d has a bad gluing\n",f,s);
+			return false;
+			};
+		const int *h=gluings+(t*nV+g[f])*nV;
+		bool inverse=adjacencies[t*nV+g[f]]==s;
+		for (int i=0;inverse && i<nV;i++) inverse=h[g[i]]==i;
+		if (!inverse)
+			{
+			printf("Facet %d of simplex %d is not glued back to it by simplex %d\n",f,s,t);
+			return false;
+			};
+		};
+
+c->topVertices=new int[nTop*nV];
+c->topFacets=new int[nTop*nV];
+c->topHinges=new int[nTop*nH];
+
+//	Vertex classes
+
+std::vector<int> parent(nTop*nV);
+for (int i=0;i<nTop*nV;i++) parent[i]=i;
+for (int s=0;s<nTop;s++)
+	for (int f=0;f<nV;f++)
+		{
+		int t=adjacencies[s*nV+f];
+		if (t<0) continue;
+		const int *g=gluings+(s*nV+f)*nV;
+		for (int i=0;i<nV;i++)
+			if (i!=f)
+				{
+				int a=findRoot(parent,s*nV+i), b=findRoot(parent,t*nV+g[i]);
+				if (a!=b) parent[a]=b;
+				};
+		};
+std::vector<int> label(nTop*nV,-1);
+for (int i=0;i<nTop*nV;i++)
+	{
+	int r=findRoot(parent,i);
+	if (label[r]<0) label[r]=c->nVertices++;
+	c->topVertices[i]=label[r];
+	};
+
+//	Facets, each numbered from the first side we meet it
+
+for (int i=0;i<nTop*nV;i++) c->topFacets[i]=-1;
+std::vector<int> facetTops, facetFace;
+for (int s=0;s<nTop;s++)
+	for (int f=0;f<nV;f++)
+		{
+		if (c->topFacets[s*nV+f]>=0) continue;
+		int t=adjacencies[s*nV+f];
+		c->topFacets[s*nV+f]=c->nFacets;
+		facetTops.push_back(s);
+		facetTops.push_back(t);
+		facetFace.push_back(f);
+		if (t>=0) c->topFacets[t*nV+gluings[(s*nV+f)*nV+f]]=c->nFacets;
+		c->nFacets++;
+		};
+
+//	Hinges, by walking around each one.  The state (s,a,b) is the hinge of
+//	simplex s opposite vertices a and b, entered through the facet opposite a
+//	and left through the facet opposite b.
+
+for (int i=0;i<nTop*nH;i++) c->topHinges[i]=-1;
+std::vector<int> hingeTopStart(1,0), hingeTops, hingeFacetStart(1,0), hingeFacets;
+for (int s0=0;s0<nTop;s0++)
+	for (int k0=0;k0<nH;k0++)
+		{
+		if (c->topHinges[s0*nH+k0]>=0) continue;
+		int s=s0, a0=pairs[k0][0], b0=pairs[k0][1], a=a0, b=b0;
+
+		//	Go forwards until we are back where we started or reach the boundary
+
+		bool boundary=false;
+		while (true)
+			{
+			int t=adjacencies[s*nV+b];
+			if (t<0)
+				{
+				boundary=true;
+				break;
+				};
+			const int *g=gluings+(s*nV+b)*nV;
+			int na=g[b], nb=g[a];
+			s=t; a=na; b=nb;
+			if (s==s0 && a==a0 && b==b0) break;
+			};
+
+		//	On the boundary, start again from the end we reached, going back
+
+		if (boundary)
+			{
+			int t=a; a=b; b=t;
+			hingeFacets.push_back(c->topFacets[s*nV+a]);
+			};
+		int sStart=s, aStart=a, bStart=b;
+		while (true)
+			{
+			c->topHinges[s*nH+pairIndex[a][b]]=c->nHinges;
+			hingeTops.push_back(s);
+			hingeFacets.push_back(c->topFacets[s*nV+b]);
+			int t=adjacencies[s*nV+b];
+			if (t<0) break;
+			const int *g=gluings+(s*nV+b)*nV;
+			int na=g[b], nb=g[a];
+			s=t; a=na; b=nb;
+			if (s==sStart && a==aStart && b==bStart) break;
+			};
+		hingeTopStart.push_back((int)hingeTops.size());
+		hingeFacetStart.push_back((int)hingeFacets.size());
+		c->nHinges++;
+		};
+
+//	Copy the lists into flat arrays
+
+c->facetTops=new int[2*c->nFacets];
+c->facetHinges=new int[dim*c->nFacets];
+for (int e=0;e<c->nFacets;e++)
+	{
+	int s=facetTops[2*e], f=facetFace[e];
+	c->facetTops[2*e]=s;
+	c->facetTops[2*e+1]=facetTops[2*e+1];
+	for (int i=0,n=0;i<nV;i++)
+		if (i!=f) c->facetHinges[dim*e+n++]=c->topHinges[s*nH+pairIndex[f][i]];
+	};
+
+c->hingeTopStart=new int[c->nHinges+1];
+c->hingeFacetStart=new int[c->nHinges+1];
+c->hingeTops=new int[hingeTops.size()];
+c->hingeFacets=new int[hingeFacets.size()];
+for (int h=0;h<=c->nHinges;h++)
+	{
+	c->hingeTopStart[h]=hingeTopStart[h];
+	c->hingeFacetStart[h]=hingeFacetStart[h];
+	};
+for (size_t i=0;i<hingeTops.size();i++) c->hingeTops[i]=hingeTops[i];
+for (size_t i=0;i<hingeFacets.size();i++) c->hingeFacets[i]=hingeFacets[i];
+
+//	The top simplices around each vertex, counted then filled in
+
+c->vertexTopStart=new int[c->nVertices+1];
+for (int v=0;v<=c->nVertices;v++) c->vertexTopStart[v]=0;
+for (int s=0;s<nTop;s++)
+	for (int i=0;i<nV;i++)
+		{
+		bool repeat=false;
+		for (int k=0;k<i;k++) repeat|=c->topVertices[s*nV+k]==c->topVertices[s*nV+i];
+		if (!repeat) c->vertexTopStart[c->topVertices[s*nV+i]+1]++;
+		};
+for (int v=0;v<c->nVertices;v++) c->vertexTopStart[v+1]+=c->vertexTopStart[v];
+c->vertexTops=new int[c->vertexTopStart[c->nVertices]];
+std::vector<int> fill(c->vertexTopStart,c->vertexTopStart+c->nVertices);
+for (int s=0;s<nTop;s++)
+	for (int i=0;i<nV;i++)
+		{
+		bool repeat=false;
+		for (int k=0;k<i;k++) repeat|=c->topVertices[s*nV+k]==c->topVertices[s*nV+i];
+		if (!repeat) c->vertexTops[fill[c->topVertices[s*nV+i]]++]=s;
+		};
+return true;
+}
+
+void freeComplex(Complex *c)
+{
+delete [] c->topVertices;
+delete [] c->topFacets;
+delete [] c->topHinges;
+delete [] c->facetTops;
+delete [] c->facetHinges;
+delete [] c->hingeTopStart;
+delete [] c->hingeTops;
+delete [] c->hingeFacetStart;
+delete [] c->hingeFacets;
+delete [] c->vertexTopStart;
+delete [] c->vertexTops;
+c->nTop=c->nFacets=c->nHinges=c->nVertices=0;
+}
+
+//	makeSphereComplex()
+//	===================
+
+//	The boundary of the (dim+1)-simplex on vertices 0..dim+1:  simplex p omits
+//	vertex p, and its facet opposite the vertex q is shared with simplex q
+
+bool makeSphereComplex(int dim, Complex *c)
+{
+if (dim!=3 && dim!=4)
+	{
+	printf("Only 3- and 4-dimensional complexes are supported, not %d\n",dim);
+	return false;
+	};
+int nTop=dim+2, nV=dim+1;
+int vertices[6][5], place[6][6];
+for (int p=0;p<nTop;p++)
+	for (int i=0,k=0;i<nTop;i++)
+		{
+		place[p][i]=-1;
+		if (i!=p)
+			{
+			place[p][i]=k;
+			vertices[p][k++]=i;
+			};
+		};
+std::vector<int> adjacencies(nTop*nV), gluings(nTop*nV*nV);
+for (int p=0;p<nTop;p++)
+	for (int f=0;f<nV;f++)
+		{
+		int q=vertices[p][f];
+		adjacencies[p*nV+f]=q;
+		for (int i=0;i<nV;i++)
+			gluings[(p*nV+f)*nV+i]=i==f ? place[q][p] : place[q][vertices[p][i]];
+		};
+return makeComplex(dim,nTop,&adjacencies[0],&gluings[0],c);
+}
+
+//	complexTriangulation()
+//	======================
+
+bool complexTriangulation(Complex *c, Triangulation *tri)
+{
+if (c->dim!=4)
+	{
+	printf("Only a 4-dimensional complex can be used for DFKR amplitudes\n");
+	return false;
+	};
+const int (*pairs)[2]=hingePairs(4);
+tri->nPent=c->nTop;
+tri->nTets=c->nFacets;
+tri->nTriangles=c->nHinges;
+tri->pentVertices=new int[c->nTop][5];
+tri->pentTriangles=new int[c->nTop][10];
+tri->pentTets=new int[c->nTop][5];
+tri->triangleVertices=new int[c->nHinges][3];
+tri->tetVertices=new int[c->nFacets][4];
+tri->tetTriangles=new int[c->nFacets][4];
+for (int s=0;s<c->nTop;s++)
+	{
+	int *v=c->topVertices+5*s;
+	for (int i=0;i<5;i++)
+		{
+		tri->pentVertices[s][i]=v[i];
+		tri->pentTets[s][i]=c->topFacets[5*s+i];
+		};
+	for (int k=0;k<10;k++)
+		{
+		int h=c->topHinges[10*s+k];
+		tri->pentTriangles[s][k]=h;
+		for (int i=0,n=0;i<5;i++)
+			if (i!=pairs[k][0] && i!=pairs[k][1]) tri->triangleVertices[h][n++]=v[i];
+		};
+	};
+for (int e=0;e<c->nFacets;e++)
+	{
+	int s=c->facetTops[2*e], f=0;
+	while (c->topFacets[5*s+f]!=e) f++;
+	for (int i=0,n=0;i<5;i++)
+		if (i!=f) tri->tetVertices[e][n++]=c->topVertices[5*s+i];
+	for (int k=0;k<4;k++) tri->tetTriangles[e][k]=c->facetHinges[4*e+k];
+	};
+return true;
+}
+
+//	triangulationComplex()
+//	======================
+
+//	Put the rows of a compressed sparse row list in a new order, rows moving from
+//	h to order[h], and renumber the entries by map[] if it is given
+
+static void reorderRows(int n, const std::vector<int> &order, int *&start, int *&entries,
+	const std::vector<int> *map)
+{
+int *newStart=new int[n+1], *newEntries=new int[start[n]];
+newStart[0]=0;
+for (int h=0;h<n;h++) newStart[order[h]+1]=start[h+1]-start[h];
+for (int h=0;h<n;h++) newStart[h+1]+=newStart[h];
+for (int h=0;h<n;h++)
+	for (int k=start[h];k<start[h+1];k++)
+		newEntries[newStart[order[h]]+k-start[h]]=map ? (*map)[entries[k]] : entries[k];
+delete [] start;
+delete [] entries;
+start=newStart;
+entries=newEntries;
+}
+
+bool triangulationComplex(Triangulation *tri, Complex *c)
+{
+int nTop=tri->nPent;
+
+//	The two 4-simplices sharing each tet glue their facets together, matching the
+//	vertex labels
+
+std::vector<int> tetPents(2*tri->nTets,-1);
+for (int p=0;p<nTop;p++)
+	for (int f=0;f<5;f++)
+		{
+		int e=tri->pentTets[p][f];
+		tetPents[2*e+(tetPents[2*e]>=0 ? 1 : 0)]=p;
+		};
+std::vector<int> adjacencies(nTop*5), gluings(nTop*25,-1);
+for (int s=0;s<nTop;s++)
+	for (int f=0;f<5;f++)
+		{
+		int e=tri->pentTets[s][f];
+		int t=tetPents[2*e]==s ? tetPents[2*e+1] : tetPents[2*e];
+		adjacencies[s*5+f]=t;
+		if (t<0) continue;
+		for (int i=0;i<5;i++)
+			for (int g=0;g<5;g++)
+				if (i==f ? tri->pentTets[t][g]==e : tri->pentVertices[t][g]==tri->pentVertices[s][i])
+					gluings[(s*5+f)*5+i]=g;
+		};
+if (!makeComplex(4,nTop,&adjacencies[0],&gluings[0],c)) return false;
+
+//	Renumber the hinges and facets as the triangles and tets they are
+
+std::vector<int> hingeNew(c->nHinges,-1), facetNew(c->nFacets,-1);
+std::vector<bool> seenTriangle(tri->nTriangles,false), seenTet(tri->nTets,false);
+bool consistent=(c->nHinges==tri->nTriangles && c->nFacets==tri->nTets);
+for (int s=0;s<nTop && consistent;s++)
+	{
+	for (int k=0;k<10;k++)
+		{
+		int h=c->topHinges[10*s+k], t=tri->pentTriangles[s][k];
+		if (hingeNew[h]<0 && !seenTriangle[t])
+			{
+			hingeNew[h]=t;
+			seenTriangle[t]=true;
+			};
+		consistent&=(hingeNew[h]==t);
+		};
+	for (int f=0;f<5;f++)
+		{
+		int e=c->topFacets[5*s+f], t=tri->pentTets[s][f];
+		if (facetNew[e]<0 && !seenTet[t])
+			{
+			facetNew[e]=t;
+			seenTet[t]=true;
+			};
+		consistent&=(facetNew[e]==t);
+		};
+	};
+if (!consistent)
+	{
+	printf("The gluings of the triangulation do not give back its triangles and tets\n");
+	freeComplex(c);
+	return false;
+	};
+
+for (int i=0;i<10*nTop;i++) c->topHinges[i]=hingeNew[c->topHinges[i]];
+for (int i=0;i<5*nTop;i++) c->topFacets[i]=facetNew[c->topFacets[i]];
+int *facetTops=new int[2*c->nFacets], *facetHinges=new int[4*c->nFacets];
+for (int e=0;e<c->nFacets;e++)
+	{
+	for (int i=0;i<2;i++) facetTops[2*facetNew[e]+i]=c->facetTops[2*e+i];
+	for (int k=0;k<4;k++) facetHinges[4*facetNew[e]+k]=hingeNew[c->facetHinges[4*e+k]];
+	};
+delete [] c->facetTops;
+delete [] c->facetHinges;
+c->facetTops=facetTops;
+c->facetHinges=facetHinges;
+reorderRows(c->nHinges,hingeNew,c->hingeTopStart,c->hingeTops,NULL);
+reorderRows(c->nHinges,hingeNew,c->hingeFacetStart,c->hingeFacets,&facetNew);
+return true;
+}
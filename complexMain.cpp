@@ -0,0 +1,92 @@
+/*
+
+complexMain.cpp
+===============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a main program that builds the boundary of a 4- or 5-simplex
+with makeSphereComplex() and describes it.
+
+	10jcomplex <dim> [twoJ]
+
+prints the numbers of vertices, hinges, facets and top simplices, the Euler
+characteristic, and the sizes of the dual faces.  For dim=4, it also computes the
+DFKR amplitude with spin j on every triangle (default 1/2) through
+complexTriangulation(), and compares it with the same amplitude on makeSphere4().
+
+*/
+
+#include <vector>
+#include "spin.h"
+
+void usage()
+{
+printf("usage:\t10jcomplex <3 | 4> [twoJ]\n");
+exit(2);
+}
+
+int main(int argc, char **argv)
+{
+if (argc<2 || argc>3) usage();
+int dim=atoi(argv[1]), twoJ=argc==3 ? atoi(argv[2]) : 1;
+Complex c;
+if (!makeSphereComplex(dim,&c)) return 1;
+
+int euler;
+if (dim==3) euler=c.nVertices-c.nHinges+c.nFacets-c.nTop;
+else
+	{
+	//	Edges are not stored; count them as the vertex pairs of each top simplex,
+	//	which is right for a simplicial complex such as this one
+
+	int nEdges=0;
+	std::vector<bool> seen(c.nVertices*c.nVertices,false);
+	for (int s=0;s<c.nTop;s++)
+		for (int i=0;i<5;i++)
+			for (int k=i+1;k<5;k++)
+				{
+				int a=c.topVertices[5*s+i], b=c.topVertices[5*s+k];
+				if (!seen[a*c.nVertices+b])
+					{
+					seen[a*c.nVertices+b]=seen[b*c.nVertices+a]=true;
+					nEdges++;
+					};
+				};
+	euler=c.nVertices-nEdges+c.nHinges-c.nFacets+c.nTop;
+	};
+printf("%d vertices, %d hinges, %d facets, %d top simplices; Euler characteristic %d\n",
+	c.nVertices,c.nHinges,c.nFacets,c.nTop,euler);
+
+int smallest=c.nTop, largest=0;
+for (int h=0;h<c.nHinges;h++)
+	{
+	int n=c.hingeTopStart[h+1]-c.hingeTopStart[h];
+	if (n<smallest) smallest=n;
+	if (n>largest) largest=n;
+	};
+printf("Dual faces have %d to %d edges\n",smallest,largest);
+
+if (dim==4)
+	{
+	Triangulation t1, t2;
+	int sign1, sign2;
+	if (!complexTriangulation(&c,&t1) || !makeSphere4(&t2)) return 1;
+	std::vector<int> spins(c.nHinges,twoJ);
+	double a1=dfkrLogAmplitude(&t1,&spins[0],sign1);
+	double a2=dfkrLogAmplitude(&t2,&spins[0],sign2);
+	printf("log|amplitude| %.15g (sign %d) from the gluings, %.15g (sign %d) from makeSphere4()\n",
+		a1,sign1,a2,sign2);
+	freeTriangulation(&t1);
+	freeTriangulation(&t2);
+	if (isnan(a1) || isnan(a2))
+		{
+		printf("A 10j symbol needs matrices larger than maxC=%d\n",maxC);
+		freeComplex(&c);
+		return 1;
+		};
+	};
+freeComplex(&c);
+return 0;
+}
@@ -0,0 +1,483 @@
+/*
+
+engines.cpp
+===========
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains several algorithms for the 10j symbol besides the one in
+tenJ.cpp, behind a single interface, so they can be compared with each other on
+the same inputs:
+
+	TENJfloat tenJEngine(int engine, int *twoJ1, int *twoJ2, double &workBytes)
+
+computes the symbol with the engine numbered 0 to N_TENJ_ENGINES-1, whose name is
+tenJEngineNames[engine], and sets workBytes to the largest amount of working
+storage it held at once.  The spins are as for tenJ(), except that the symbol is
+zero, for every engine, unless the four spins at each vertex of the 4-simplex
+pair off into admissible triples with some c_i, which tenJ() takes for granted.
+
+All of the engines except "ce" use the expansion (2) of the Christensen-Egan
+paper, which writes the Spin(4) network as a sum over the spins c_i = 2 l_i of
+the squares of an SU(2) network, the decagon with nodes i and i' for each vertex
+i of the 4-simplex:
+
+	c_i			joins i' to i
+	twoJ1[i]	joins i' to i+1
+	twoJ2[i]	joins i' to i+2
+
+so that the ten edges around the decagon are the c's and twoJ1's, and the five
+twoJ2's make a pentagram inside it.  With the decagon D(c) normalised so that its
+nodes are Wigner 3j symbols, the symbol is
+
+	10j = sum_c  sign(c) prod_i (c_i+1) D(c)^2
+
+The engines differ in how they evaluate D(c):
+
+	"ce"		tenJ() itself; the sum over c is done by the traces of products
+				of matrices for each pair of m's, in O(j^5) time, O(j^2) space.
+
+	"decagon"	recoupling theory: D(c) is a single sum over a spin m crossing
+				all five chords of the pentagram, each term a product of five
+				tets, as in the paper's proof of (5), but with the sum over c
+				done outside the sum over m; O(j^6) time, O(1) space.
+
+	"direct"	direct contraction: a sum over the magnetic numbers on the five
+				chords and on c_0, with conservation at each node fixing the rest
+				as we go round the decagon; O(j^11) time, O(j^2) space for the
+				tables of 3j symbols.
+
+	"staged"	staged contraction: the 3j tensors at the nodes are contracted
+				one at a time, in order round the decagon, keeping a dense tensor
+				on the edges still open; up to five are open at once, so this
+				needs O(j^5) space.
+
+	"3cut"		the three edges crossed by a ray from the centre of the decagon
+	"2cut"		between nodes 0' and 1 (twoJ1[0], twoJ2[0], twoJ2[4]), or the
+				two between 0 and 0' (c_0, twoJ2[4]), are cut, and the trace of
+				the resulting operator is taken, one basis vector at a time, by
+				staged contraction with those magnetic numbers held fixed.
+
+The sign of each term, sign(c), is (-1)^(L_0 + twoJ2[4] + the sum of the ten
+2j's - m), where m is the lowest value allowed for the spin that crosses the
+chords in the recoupling form of D(c); this is tenJ()'s sign for the pair of m's,
+once its sum over them is split into a product of two sums.  The magnetic engines
+drop the sign of D(c) itself, which depends on conventions for the 3j symbols.
+
+The paper also describes Spin(4) versions of the elementary methods, with the
+Barrett-Crane intertwiners in bases for j (x) j; they take O(j^12) time, so only
+the SU(2) versions are here.  The magnetic engines compute their 3j symbols from
+factorials, and are only practical for 2j up to about 4; enginesMain.cpp times
+all of the engines and checks them against each other.
+
+*/
+
+#include <cstring>
+#include <vector>
+#include "spin.h"
+
+const char *tenJEngineNames[N_TENJ_ENGINES]={"ce","decagon","direct","staged","3cut","2cut"};
+
+//	tenJEngineNumber() returns the number of an engine from its name, or -1.
+
+int tenJEngineNumber(const char *name)
+{
+for (int e=0;e<N_TENJ_ENGINES;e++) if (strcmp(name,tenJEngineNames[e])==0) return e;
+return -1;
+}
+
+//	Is (a, b, c) an admissible triple of 2j's?
+
+static bool admissible(int a, int b, int c)
+{
+return (a+b+c)%2==0 && a<=b+c && b<=a+c && c<=a+b;
+}
+
+//	threeJ() computes the Wigner 3j symbol (j1 j2 j3; m1 m2 m3) by Racah's formula;
+//	all arguments are doubled.
+
+static double threeJ(int tj1, int tj2, int tj3, int tm1, int tm2, int tm3)
+{
+if (tm1+tm2+tm3!=0 || !admissible(tj1,tj2,tj3)) return 0.0;
+if (tm1<-tj1 || tm1>tj1 || tm2<-tj2 || tm2>tj2 || tm3<-tj3 || tm3>tj3) return 0.0;
+if ((tj1+tm1)%2!=0 || (tj2+tm2)%2!=0 || (tj3+tm3)%2!=0) return 0.0;
+
+int a=(tj1+tj2-tj3)/2, b=(tj1-tj2+tj3)/2, c=(-tj1+tj2+tj3)/2;
+int nn[9]={a,b,c,(tj1+tm1)/2,(tj1-tm1)/2,(tj2+tm2)/2,(tj2-tm2)/2,(tj3+tm3)/2,(tj3-tm3)/2};
+int dd[9]={(tj1+tj2+tj3)/2+1,0,0,0,0,0,0,0,0};
+double pre=sqrt((double)multiRatio(nn,dd,9));
+
+int k1=(tj3-tj2+tm1)/2, k2=(tj3-tj1-tm2)/2, k3=(tj1-tm1)/2, k4=(tj2+tm2)/2;
+int kMin=max(0,max(-k1,-k2)), kMax=min(a,min(k3,k4));
+double sum=0.0;
+for (int k=kMin;k<=kMax;k++)
+	{
+	int zero[6]={0,0,0,0,0,0}, den[6]={k,k1+k,k2+k,a-k,k3-k,k4-k};
+	double t=(double)multiRatio(zero,den,6);
+	sum+=(k%2==0) ? t : -t;
+	};
+return ((tj1-tj2-tm3)/2)%2==0 ? pre*sum : -pre*sum;
+}
+
+//	The decagon for one set of c's, as a network of 3j tensors.  Edges 0-4 are the
+//	c's, 5-9 the twoJ1's and 10-14 the twoJ2's; nodes 0-4 are i and 5-9 are i'.
+//	Every edge runs from a primed node to an unprimed one, and a 3j symbol at an
+//	unprimed node takes minus the magnetic numbers; since the three magnetic numbers
+//	at a primed node add up to zero, the usual factors (-1)^(j-m) on the edges come
+//	to a sign that depends only on the spins, which we can drop, as only D(c)^2 is
+//	needed.
+
+struct Decagon
+	{
+	int twoJ[15];
+	int edges[10][3];				//	Edges at each node
+	int ends[15][2];				//	Primed and unprimed node of each edge
+	std::vector<double> table[10];	//	3j's, by the first two magnetic numbers
+	};
+
+static void makeDecagon(int *c, int *twoJ1, int *twoJ2, Decagon *d)
+{
+for (int i=0;i<5;i++)
+	{
+	d->twoJ[i]=c[i];
+	d->twoJ[5+i]=twoJ1[i];
+	d->twoJ[10+i]=twoJ2[i];
+	d->edges[5+i][0]=i;
+	d->edges[5+i][1]=5+i;
+	d->edges[5+i][2]=10+i;
+	d->edges[i][0]=i;
+	d->edges[i][1]=5+mod5(i-1);
+	d->edges[i][2]=10+mod5(i-2);
+	d->ends[i][0]=5+i;			d->ends[i][1]=i;
+	d->ends[5+i][0]=5+i;		d->ends[5+i][1]=mod5(i+1);
+	d->ends[10+i][0]=5+i;		d->ends[10+i][1]=mod5(i+2);
+	};
+for (int v=0;v<10;v++)
+	{
+	int *e=d->edges[v], t0=d->twoJ[e[0]], t1=d->twoJ[e[1]], t2=d->twoJ[e[2]];
+	int s=v<5 ? -1 : 1;
+	d->table[v].assign((t0+1)*(t1+1),0.0);
+	for (int i0=0;i0<=t0;i0++)
+		for (int i1=0;i1<=t1;i1++)
+			{
+			int m0=2*i0-t0, m1=2*i1-t1;
+			d->table[v][i0*(t1+1)+i1]=threeJ(t0,t1,t2,s*m0,s*m1,-s*(m0+m1));
+			};
+	};
+}
+
+static double decagonTableBytes(Decagon *d)
+{
+double bytes=0.0;
+for (int v=0;v<10;v++) bytes+=d->table[v].size()*sizeof(double);
+return bytes;
+}
+
+//	The 3j tensor at node v, given the doubled magnetic numbers on the edges of the
+//	decagon; zero unless they are conserved.
+
+static inline double nodeValue(Decagon *d, int v, int m0, int m1, int m2)
+{
+int *e=d->edges[v], t0=d->twoJ[e[0]], t1=d->twoJ[e[1]], t2=d->twoJ[e[2]];
+if (m0+m1+m2!=0 || m2<-t2 || m2>t2) return 0.0;
+return d->table[v][((m0+t0)/2)*(t1+1)+(m1+t1)/2];
+}
+
+//	Direct contraction.  The free magnetic numbers are those on the chords and on
+//	c_0; going round the decagon from 0', each node fixes the next edge.
+
+static double directDecagon(Decagon *d)
+{
+int *tj=d->twoJ;
+double sum=0.0;
+int m[15];
+for (m[10]=-tj[10];m[10]<=tj[10];m[10]+=2)
+for (m[11]=-tj[11];m[11]<=tj[11];m[11]+=2)
+for (m[12]=-tj[12];m[12]<=tj[12];m[12]+=2)
+for (m[13]=-tj[13];m[13]<=tj[13];m[13]+=2)
+for (m[14]=-tj[14];m[14]<=tj[14];m[14]+=2)
+for (m[0]=-tj[0];m[0]<=tj[0];m[0]+=2)
+	{
+	double p=1.0;
+	for (int i=0;i<5 && p!=0.0;i++)
+		{
+		//	Node i' fixes twoJ1[i], then node i+1 fixes c_{i+1}
+
+		m[5+i]=-m[i]-m[10+i];
+		if (m[5+i]<-tj[5+i] || m[5+i]>tj[5+i]) {p=0.0; break;};
+		p*=nodeValue(d,5+i,m[i],m[5+i],m[10+i]);
+		int ip=mod5(i+1);
+		int mc=-m[5+i]-m[10+mod5(i-1)];
+		if (ip!=0)
+			{
+			if (mc<-tj[ip] || mc>tj[ip]) {p=0.0; break;};
+			m[ip]=mc;
+			}
+		else if (mc!=m[0]) {p=0.0; break;};
+		p*=nodeValue(d,ip,m[ip],m[5+i],m[10+mod5(i-1)]);
+		};
+	sum+=p;
+	};
+return sum;
+}
+
+//	contractDecagon() contracts the nodes of the decagon in the given order, keeping
+//	a dense tensor on the edges that join a node already contracted to one that is
+//	not; the edges with fixed[e] true have their magnetic numbers held at m[e], and
+//	are not part of the tensor.  It adds the size of the largest tensor into bytes.
+
+static double contractDecagon(Decagon *d, const int *order, const bool *fixed, int *m,
+	double &bytes)
+{
+int *tj=d->twoJ;
+bool done[10]={false};
+std::vector<int> open;
+std::vector<double> t(1,1.0), u;
+size_t largest=1;
+
+for (int step=0;step<10;step++)
+	{
+	int v=order[step];
+	done[v]=true;
+
+	//	Edges of the new tensor: those open before, and the new edges at v, less
+	//	those that v closes
+
+	std::vector<int> next;
+	for (size_t k=0;k<open.size();k++)
+		{
+		int e=open[k];
+		if (!(done[d->ends[e][0]] && done[d->ends[e][1]])) next.push_back(e);
+		};
+	int unknown[3], nUnknown=0;
+	for (int k=0;k<3;k++)
+		{
+		int e=d->edges[v][k];
+		bool isOpen=false;
+		for (size_t q=0;q<open.size();q++) if (open[q]==e) isOpen=true;
+		if (isOpen || fixed[e]) continue;
+		unknown[nUnknown++]=e;
+		if (!(done[d->ends[e][0]] && done[d->ends[e][1]])) next.push_back(e);
+		};
+
+	size_t size=1;
+	for (size_t k=0;k<next.size();k++) size*=tj[next[k]]+1;
+	u.assign(size,0.0);
+	if (size>largest) largest=size;
+
+	//	Run over the entries of the old tensor, and the magnetic numbers on the new
+	//	edges; the last of these is fixed by conservation at v
+
+	for (size_t idx=0;idx<t.size();idx++)
+		{
+		if (t[idx]==0.0) continue;
+		size_t r=idx;
+		for (int k=(int)open.size()-1;k>=0;k--)
+			{
+			int e=open[k];
+			m[e]=2*(int)(r%(tj[e]+1))-tj[e];
+			r/=tj[e]+1;
+			};
+
+		int nFree=nUnknown>0 ? nUnknown-1 : 0;
+		int count=1;
+		for (int k=0;k<nFree;k++) count*=tj[unknown[k]]+1;
+		for (int c=0;c<count;c++)
+			{
+			int r2=c;
+			for (int k=nFree-1;k>=0;k--)
+				{
+				int e=unknown[k];
+				m[e]=2*(r2%(tj[e]+1))-tj[e];
+				r2/=tj[e]+1;
+				};
+			int *ev=d->edges[v];
+			if (nUnknown>0)
+				{
+				int e=unknown[nUnknown-1], s=0;
+				for (int k=0;k<3;k++) if (ev[k]!=e) s+=m[ev[k]];
+				if (-s<-tj[e] || -s>tj[e]) continue;
+				m[e]=-s;
+				};
+			double val=nodeValue(d,v,m[ev[0]],m[ev[1]],m[ev[2]]);
+			if (val==0.0) continue;
+			size_t to=0;
+			for (size_t k=0;k<next.size();k++)
+				{
+				int e=next[k];
+				to=to*(tj[e]+1)+(m[e]+tj[e])/2;
+				};
+			u[to]+=t[idx]*val;
+			};
+		};
+	t.swap(u);
+	open.swap(next);
+	};
+bytes+=2.0*largest*sizeof(double);
+return t[0];
+}
+
+static double stagedDecagon(Decagon *d, double &bytes)
+{
+static const int order[10]={5,1,6,2,7,3,8,4,9,0};
+bool fixed[15]={false};
+int m[15];
+return contractDecagon(d,order,fixed,m,bytes);
+}
+
+//	The trace over the cut edges: a staged contraction for each basis vector of
+//	their tensor product, starting just after the cut.
+
+static double cutDecagon(Decagon *d, const int *order, const int *cut, int nCut,
+	double &bytes)
+{
+int *tj=d->twoJ;
+bool fixed[15]={false};
+for (int k=0;k<nCut;k++) fixed[cut[k]]=true;
+int count=1;
+for (int k=0;k<nCut;k++) count*=tj[cut[k]]+1;
+
+double trace=0.0, largest=0.0;
+int m[15];
+for (int c=0;c<count;c++)
+	{
+	int r=c;
+	for (int k=nCut-1;k>=0;k--)
+		{
+		m[cut[k]]=2*(r%(tj[cut[k]]+1))-tj[cut[k]];
+		r/=tj[cut[k]]+1;
+		};
+	double b=0.0;
+	trace+=contractDecagon(d,order,fixed,m,b);
+	if (b>largest) largest=b;
+	};
+bytes+=largest;
+return trace;
+}
+
+static double threeCutDecagon(Decagon *d, double &bytes)
+{
+static const int order[10]={1,6,2,7,3,8,4,9,0,5};
+static const int cut[3]={5,10,14};
+return cutDecagon(d,order,cut,3,bytes);
+}
+
+static double twoCutDecagon(Decagon *d, double &bytes)
+{
+static const int order[10]={5,1,6,2,7,3,8,4,9,0};
+static const int cut[2]={0,14};
+return cutDecagon(d,order,cut,2,bytes);
+}
+
+//	mRange() finds the range of the spin m that crosses the five chords in the
+//	recoupling form of the decagon, allowed with every triple (c_i, m, twoJ2[i-1]);
+//	it returns false if there is none, when the decagon is zero.
+
+static bool mRange(int *c, int *twoJ2, int &mMin, int &mMax)
+{
+for (int i=0;i<5;i++)
+	{
+	int j2m=twoJ2[mod5(i-1)];
+	int lo=abs(c[i]-j2m), hi=c[i]+j2m;
+	if (i==0 || lo>mMin) mMin=lo;
+	if (i==0 || hi<mMax) mMax=hi;
+	if ((c[i]+j2m)%2!=(c[0]+twoJ2[4])%2) return false;
+	};
+return mMin<=mMax;
+}
+
+//	The recoupling form of the decagon, as a sum over m of products of tets; this
+//	is the factor in tenJ()'s sum that belongs to one of m1, m2, with the thetas of
+//	the first or second kind in tenJMatrix().
+
+static TENJfloat recoupledDecagon(int *c, int *twoJ1, int *twoJ2, bool second)
+{
+int mMin, mMax;
+if (!mRange(c,twoJ2,mMin,mMax)) return 0.0;
+TENJfloat sum=0.0;
+for (int m=mMin;m<=mMax;m+=2)
+	{
+	TENJfloat p=(m+1)*((m-mMin)/2%2==0 ? 1 : -1);
+	for (int k=0;k<5;k++)
+		{
+		int ck=c[k], ckp=c[mod5(k+1)];
+		int j1=twoJ1[k], j1p=twoJ1[mod5(k+1)];
+		int j2=twoJ2[k], j2m=twoJ2[mod5(k-1)], j2p=twoJ2[mod5(k+1)];
+		if (second) p*=tetOnThetas(ck,j2,ckp,j2m,m,j1,j2,ckp,m,j2p,ckp,j1p);
+		else p*=tetOnThetas(ck,j2,ckp,j2m,m,j1,j2,ckp,m,j2m,ckp,j1);
+		};
+	sum+=p;
+	};
+return sum;
+}
+
+//	tenJEngine()
+//	============
+
+TENJfloat tenJEngine(int engine, int *twoJ1, int *twoJ2, double &workBytes)
+{
+workBytes=0.0;
+if (engine<0 || engine>=N_TENJ_ENGINES)
+	{
+	printf("tenJEngine() was given engine %d\n",engine);
+	return 0.0;
+	};
+
+//	The spins at each vertex of the 4-simplex must pair off into admissible triples
+//	with some c_i; tenJ() assumes they do, so we check here
+
+TenJSetup s;
+tenJSetup(twoJ1,twoJ2,&s);
+int *L=s.L, *H=s.H;
+for (int i=0;i<5;i++)
+	if (H[i]<L[i] || (twoJ1[i]+twoJ2[i]+twoJ1[mod5(i-1)]+twoJ2[mod5(i-2)])%2!=0) return 0.0;
+
+if (engine==0)
+	{
+	//	tenJ() holds five matrices for the ranges of the c's
+
+	int big=0;
+	for (int i=0;i<5;i++) if ((H[i]-L[i])/2+1>big) big=(H[i]-L[i])/2+1;
+	workBytes=5.0*big*big*sizeof(TENJfloat);
+	return tenJ(twoJ1,twoJ2);
+	};
+
+int parity=L[0]+twoJ2[4];
+for (int i=0;i<5;i++) parity+=twoJ1[i]+twoJ2[i];
+
+TENJfloat sum=0.0;
+int c[5];
+for (c[0]=L[0];c[0]<=H[0];c[0]+=2)
+for (c[1]=L[1];c[1]<=H[1];c[1]+=2)
+for (c[2]=L[2];c[2]<=H[2];c[2]+=2)
+for (c[3]=L[3];c[3]<=H[3];c[3]+=2)
+for (c[4]=L[4];c[4]<=H[4];c[4]+=2)
+	{
+	int mMin, mMax;
+	if (!mRange(c,twoJ2,mMin,mMax)) continue;
+	TENJfloat weight=(parity-mMin)%2==0 ? 1.0 : -1.0;
+	for (int i=0;i<5;i++) weight*=c[i]+1;
+
+	if (engine==1)
+		{
+		TENJfloat a=recoupledDecagon(c,twoJ1,twoJ2,false);
+		if (a!=0.0) sum+=weight*a*recoupledDecagon(c,twoJ1,twoJ2,true);
+		continue;
+		};
+
+	Decagon d;
+	makeDecagon(c,twoJ1,twoJ2,&d);
+	double bytes=decagonTableBytes(&d), dc=0.0;
+	switch (engine)
+		{
+		case 2:	dc=directDecagon(&d);				break;
+		case 3:	dc=stagedDecagon(&d,bytes);			break;
+		case 4:	dc=threeCutDecagon(&d,bytes);		break;
+		case 5:	dc=twoCutDecagon(&d,bytes);			break;
+		};
+	if (bytes>workBytes) workBytes=bytes;
+	sum+=weight*dc*dc;
+	};
+return sum;
+}
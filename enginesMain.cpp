@@ -0,0 +1,145 @@
+/*
+
+enginesMain.cpp
+===============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a main program that compares the 10j algorithms in engines.cpp
+on the same symbols, reporting the time and working storage each one takes, and
+checking that they all agree with tenJ().
+
+	10jengines <twoJMax> [budget [engine ...]]
+
+For each 2j from 1 to twoJMax, it computes the regular symbol and three others
+with random spins up to 2j (the same ones on every run), with each of the engines
+named, or all of them.  An engine is dropped for larger spins once a symbol takes
+it longer than budget seconds (default 10).  For each 2j it prints the fastest
+engine, and at the end the number of values that disagree with "ce" by more than
+a relative 1e-8; the exit status is 1 if there are any.
+
+*/
+
+#include <random>
+#include <vector>
+#include "spin.h"
+
+void usage()
+{
+printf("usage:\t10jengines <twoJMax> [budget [engine ...]]\n");
+exit(2);
+}
+
+//	Do the spins pair off into admissible triples at every vertex?
+
+static bool admissibleTenJ(int *twoJ1, int *twoJ2)
+{
+TenJSetup s;
+tenJSetup(twoJ1,twoJ2,&s);
+for (int i=0;i<5;i++)
+	if (s.H[i]<s.L[i] || (twoJ1[i]+twoJ2[i]+twoJ1[mod5(i-1)]+twoJ2[mod5(i-2)])%2!=0)
+		return false;
+return true;
+}
+
+//	Time one engine on one symbol, repeating it until it has taken at least 0.1
+//	seconds in all, or once if it is slower than that
+
+static double timeEngine(int engine, int *twoJ1, int *twoJ2, TENJfloat &value,
+	double &workBytes)
+{
+int n=0;
+clock_t c0=clock(), c1;
+do
+	{
+	value=tenJEngine(engine,twoJ1,twoJ2,workBytes);
+	n++;
+	c1=clock();
+	}
+while (c1-c0<CLOCKS_PER_SEC/10);
+return (c1-c0)/(double)CLOCKS_PER_SEC/n;
+}
+
+int main(int argc, char **argv)
+{
+if (argc<2) usage();
+int twoJMax=atoi(argv[1]);
+double budget=argc>2 ? atof(argv[2]) : 10.0;
+if (twoJMax<1 || budget<=0.0) usage();
+
+std::vector<int> engines;
+for (int a=3;a<argc;a++)
+	{
+	int e=tenJEngineNumber(argv[a]);
+	if (e<0)
+		{
+		printf("Unknown engine %s; the engines are",argv[a]);
+		for (int k=0;k<N_TENJ_ENGINES;k++) printf(" %s",tenJEngineNames[k]);
+		printf("\n");
+		return 2;
+		};
+	engines.push_back(e);
+	};
+if (engines.empty()) for (int e=0;e<N_TENJ_ENGINES;e++) engines.push_back(e);
+
+std::mt19937 rng(1);
+std::vector<bool> dropped(N_TENJ_ENGINES,false);
+int nDisagree=0;
+for (int twoJ=1;twoJ<=twoJMax;twoJ++)
+	{
+	std::vector<double> total(N_TENJ_ENGINES,0.0);
+	std::vector<int> timed(N_TENJ_ENGINES,0);
+	bool any=false;
+	for (int sample=0;sample<4;sample++)
+		{
+		int twoJ1[5], twoJ2[5];
+		if (sample==0) for (int i=0;i<5;i++) twoJ1[i]=twoJ2[i]=twoJ;
+		else
+			{
+			do
+				{
+				for (int i=0;i<5;i++)
+					{
+					twoJ1[i]=rng()%(twoJ+1);
+					twoJ2[i]=rng()%(twoJ+1);
+					};
+				twoJ1[rng()%5]=twoJ;
+				}
+			while (!admissibleTenJ(twoJ1,twoJ2));
+			};
+		printf("2j = [%d %d %d %d %d] [%d %d %d %d %d]\n",
+			twoJ1[0],twoJ1[1],twoJ1[2],twoJ1[3],twoJ1[4],
+			twoJ2[0],twoJ2[1],twoJ2[2],twoJ2[3],twoJ2[4]);
+
+		double bytes;
+		TENJfloat reference=tenJEngine(0,twoJ1,twoJ2,bytes);
+		for (size_t k=0;k<engines.size();k++)
+			{
+			int e=engines[k];
+			if (dropped[e]) continue;
+			TENJfloat value;
+			double seconds=timeEngine(e,twoJ1,twoJ2,value,bytes);
+			total[e]+=seconds;
+			timed[e]++;
+			any=true;
+			bool agree=fabs(value-reference)<=1e-8*fabs(reference)+1e-300;
+			if (!agree) nDisagree++;
+			printf("\t%-8s %24.17g %12.6f s %12.0f bytes%s\n",
+				tenJEngineNames[e],(double)value,seconds,bytes,agree ? "" : "  DISAGREES");
+			if (seconds>budget) dropped[e]=true;
+			};
+		};
+	if (!any) break;
+
+	int fastest=-1;
+	for (size_t k=0;k<engines.size();k++)
+		{
+		int e=engines[k];
+		if (timed[e]==4 && (fastest<0 || total[e]<total[fastest])) fastest=e;
+		};
+	if (fastest>=0) printf("2j = %d: fastest is %s\n",twoJ,tenJEngineNames[fastest]);
+	};
+printf("%d values disagree with ce\n",nDisagree);
+return nDisagree==0 ? 0 : 1;
+}
@@ -0,0 +1,776 @@
+/*
+
+exact.cpp
+=========
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a routine that computes the exact value of a 10j symbol, as a
+fraction, for use as a reference against which to measure the rounding error of
+tenJ():
+
+	bool tenJExact(int *twoJ1, int *twoJ2, int maxPrimes, TenJExact *result)
+
+Every quantity in tenJ() -- the tets, the thetas, the M matrices, their traces and
+the sum over the m's -- is a rational number whose denominator is a product of
+factorials of numbers no larger than a few times the largest spin.  So modulo any
+prime p larger than that, the whole calculation can be carried out exactly in the
+integers mod p, following the same formulae as tenJ(), but with each tet summed
+directly rather than relative to its largest term.
+
+We do this for batches of nLanes primes just below 2^31 at once, with the numbers
+for each prime in a separate "lane":  every operation is applied to all the lanes
+in a short loop, which the compiler can vectorise, using Montgomery multiplication
+so there are no divisions.  The results for all the primes so far are combined by
+the Chinese remainder theorem into the value mod their product, and a fraction
+N/D with |N| and D less than the square root of half that product is recovered
+from it by rational reconstruction (a truncated extended Euclidean algorithm).
+
+Once a fraction has been found, it is checked against the values mod the primes
+in the next batch; if it agrees with all of them, it is accepted.  A wrong fraction
+would have to agree by chance with nLanes independent primes, which has a
+probability of less than 2^(-30*nLanes).  Otherwise the batch is combined with the
+rest, and we try again, until maxPrimes primes have been used.
+
+The result is given as decimal strings for the numerator and denominator, in
+lowest terms, and as an XFloat.  tenJExactError(TenJExact *exact, TENJfloat approx)
+gives the relative error of an approximate value, such as the result of tenJ(),
+computed exactly from the fraction.  freeTenJExact() frees the strings.
+
+Each batch takes about 20 times as long as tenJ() (13 times at 2j=10, 22 at 2j=30),
+since the tets are summed directly rather than relative to their largest terms or
+by recursion along rows, and every operation is done for nLanes primes.  The number
+of batches needed grows with the size of the fraction, and so with the spins:  two
+at 2j=10, three up to 2j=30.
+
+*/
+
+#include <vector>
+#include <stdint.h>
+#include <string.h>
+#include "spin.h"
+
+//	Number of primes handled together
+
+#define nLanes 8
+
+//	----------------------------------------
+//	**** Arithmetic modulo several primes ***
+//	----------------------------------------
+
+//	Each prime p has its Montgomery constants:  pinv = -1/p mod 2^32, and
+//	r2 = 2^64 mod p.  Numbers mod p are held as x*2^32 mod p.
+
+struct Lanes
+	{
+	uint32_t p[nLanes], pinv[nLanes], r2[nLanes];
+	};
+
+static inline uint32_t redc(uint64_t t, uint32_t p, uint32_t pinv)
+{
+uint32_t m=(uint32_t)t*pinv;
+uint64_t u=(t+(uint64_t)m*p)>>32;
+return u>=p ? (uint32_t)(u-p) : (uint32_t)u;
+}
+
+static inline void lMul(uint32_t *r, const uint32_t *a, const uint32_t *b, const Lanes &L)
+{
+for (int l=0;l<nLanes;l++) r[l]=redc((uint64_t)a[l]*b[l],L.p[l],L.pinv[l]);
+}
+
+static inline void lAdd(uint32_t *r, const uint32_t *a, const uint32_t *b, const Lanes &L)
+{
+for (int l=0;l<nLanes;l++)
+	{
+	uint32_t s=a[l]+b[l];
+	r[l]=s>=L.p[l] ? s-L.p[l] : s;
+	};
+}
+
+static inline void lSub(uint32_t *r, const uint32_t *a, const uint32_t *b, const Lanes &L)
+{
+for (int l=0;l<nLanes;l++) r[l]=a[l]>=b[l] ? a[l]-b[l] : a[l]+L.p[l]-b[l];
+}
+
+//	lInt() sets r to a small non-negative integer n, in Montgomery form
+
+static inline void lInt(uint32_t *r, uint32_t n, const Lanes &L)
+{
+for (int l=0;l<nLanes;l++) r[l]=redc((uint64_t)(n%L.p[l])*L.r2[l],L.p[l],L.pinv[l]);
+}
+
+//	Ordinary modular arithmetic, for setting things up
+
+static uint32_t powMod(uint32_t a, uint32_t e, uint32_t p)
+{
+uint64_t r=1, b=a%p;
+while (e>0)
+	{
+	if (e&1) r=r*b%p;
+	b=b*b%p;
+	e>>=1;
+	};
+return (uint32_t)r;
+}
+
+static bool isPrime(uint32_t n)
+{
+if (n<2) return false;
+for (uint32_t d=2;d*d<=n;d++) if (n%d==0) return false;
+return true;
+}
+
+//	nextPrimes() finds the next nLanes primes below *from, and sets up their lanes
+
+static void nextPrimes(uint32_t &from, Lanes &L)
+{
+for (int l=0;l<nLanes;l++)
+	{
+	do from-=2; while (!isPrime(from));
+	uint32_t p=from, inv=p;
+	for (int k=0;k<5;k++) inv*=2-p*inv;
+	L.p[l]=p;
+	L.pinv[l]=(uint32_t)(0u-inv);
+	uint64_t r=((uint64_t)1<<32)%p;
+	L.r2[l]=(uint32_t)(r*r%p);
+	};
+}
+
+//	Tables of factorials and their inverses, in all lanes, up to nFact-1
+
+struct FactTables
+	{
+	Lanes L;
+	int nFact;
+	uint32_t *fact, *invFact;			//	nFact*nLanes entries each
+	};
+
+static void makeTables(FactTables &T, int nFact)
+{
+T.nFact=nFact;
+T.fact=new uint32_t[nFact*nLanes];
+T.invFact=new uint32_t[nFact*nLanes];
+uint32_t n[nLanes];
+lInt(T.fact,1,T.L);
+for (int k=1;k<nFact;k++)
+	{
+	lInt(n,k,T.L);
+	lMul(T.fact+k*nLanes,T.fact+(k-1)*nLanes,n,T.L);
+	};
+
+//	Invert the largest factorial by Fermat's little theorem, and work down
+
+uint32_t *top=T.invFact+(nFact-1)*nLanes;
+for (int l=0;l<nLanes;l++)
+	{
+	uint32_t p=T.L.p[l];
+	uint32_t f=redc(T.fact[(nFact-1)*nLanes+l],p,T.L.pinv[l]);
+	uint32_t inv=powMod(f,p-2,p);
+	top[l]=redc((uint64_t)inv*T.L.r2[l],p,T.L.pinv[l]);
+	};
+for (int k=nFact-1;k>0;k--)
+	{
+	lInt(n,k,T.L);
+	lMul(T.invFact+(k-1)*nLanes,T.invFact+k*nLanes,n,T.L);
+	};
+}
+
+static void freeTables(FactTables &T)
+{
+delete [] T.fact;
+delete [] T.invFact;
+}
+
+//	tetOnThetasMod() computes tetOnThetas() in all lanes; the sum over s is taken
+//	directly, and its common factor is multiplied in afterwards
+
+static void tetOnThetasMod(int a, int b, int c, int d, int e, int f,
+	int twoJ1a, int twoJ2a, int twoJ3a, int twoJ1b, int twoJ2b, int twoJ3b,
+	FactTables &T, uint32_t *result)
+{
+const Lanes &L=T.L;
+uint32_t *F=T.fact, *IF=T.invFact;
+int aa[]={(a+b+f)/2, (b+c+e)/2, (c+d+f)/2, (a+d+e)/2};
+int bb[]={(b+d+e+f)/2, (a+c+e+f)/2, (a+b+c+d)/2};
+
+int sumLo=aa[0], sumHi=bb[0];
+for (int i=1;i<4;i++) if (aa[i]>sumLo) sumLo=aa[i];
+for (int i=1;i<3;i++) if (bb[i]<sumHi) sumHi=bb[i];
+
+//	Alternating sum of (s+1)!/(prod (s-aa)! prod (bb-s)!)
+
+uint32_t sum[nLanes], t[nLanes];
+for (int l=0;l<nLanes;l++) sum[l]=0;
+for (int s=sumLo;s<=sumHi;s++)
+	{
+	lMul(t,F+(s+1)*nLanes,IF+(s-aa[0])*nLanes,L);
+	for (int i=1;i<4;i++) lMul(t,t,IF+(s-aa[i])*nLanes,L);
+	for (int j=0;j<3;j++) lMul(t,t,IF+(bb[j]-s)*nLanes,L);
+	if (s%2==0) lAdd(sum,sum,t,L); else lSub(sum,sum,t,L);
+	};
+
+//	Common factor, including the two thetas
+
+int sumJa=(twoJ1a+twoJ2a+twoJ3a)/2;
+int sumJb=(twoJ1b+twoJ2b+twoJ3b)/2;
+int nn[]={
+	bb[0]-aa[0], bb[0]-aa[1], bb[0]-aa[2], bb[0]-aa[3],
+	bb[1]-aa[0], bb[1]-aa[1], bb[1]-aa[2], bb[1]-aa[3],
+	bb[2]-aa[0], bb[2]-aa[1], bb[2]-aa[2], bb[2]-aa[3],
+	twoJ1a, twoJ2a, twoJ3a, twoJ1b, twoJ2b, twoJ3b
+	};
+int dd[]={a,b,c,d,e,f,
+	sumJa-twoJ1a, sumJa-twoJ2a, sumJa-twoJ3a, sumJa+1,
+	sumJb-twoJ1b, sumJb-twoJ2b, sumJb-twoJ3b, sumJb+1
+	};
+for (int i=0;i<18;i++) lMul(sum,sum,F+nn[i]*nLanes,L);
+for (int i=0;i<14;i++) lMul(sum,sum,IF+dd[i]*nLanes,L);
+
+if ((sumJa+sumJb)%2==1)
+	{
+	uint32_t zero[nLanes];
+	for (int l=0;l<nLanes;l++) zero[l]=0;
+	lSub(result,zero,sum,L);
+	}
+else
+	{
+	for (int l=0;l<nLanes;l++) result[l]=sum[l];
+	};
+}
+
+//	tenJMod() computes a 10j symbol in all lanes, following tenJTerm(), and sets
+//	residues[] to its value mod each prime.  The matrices and vectors are kept by
+//	each thread between calls, and grown when a symbol needs larger ones.
+
+static void tenJMod(TenJSetup *s, FactTables &T, uint32_t *residues)
+{
+static thread_local std::vector<uint32_t> mBuf, vBuf;
+const Lanes &L=T.L;
+int *twoJ1=s->twoJ1, *twoJ2=s->twoJ2;
+int LL[5], HH[5], dim[5];
+
+//	No matrix is larger than the limits independent of the m's allow
+
+int maxDim=1;
+for (int i=0;i<5;i++) if (1+(s->H[i]-s->L[i])/2>maxDim) maxDim=1+(s->H[i]-s->L[i])/2;
+if (mBuf.size()<(size_t)5*maxDim*maxDim*nLanes) mBuf.resize((size_t)5*maxDim*maxDim*nLanes);
+if (vBuf.size()<(size_t)2*maxDim*nLanes) vBuf.resize((size_t)2*maxDim*nLanes);
+uint32_t *M=mBuf.data(), *v0=vBuf.data(), *v1=v0+maxDim*nLanes;
+uint32_t sumOverM[nLanes], t1[nLanes], t2[nLanes], n[nLanes], acc[nLanes], trace[nLanes];
+for (int l=0;l<nLanes;l++) sumOverM[l]=0;
+
+#define MM(k,i,j) (M+(((k)*maxDim+(i))*maxDim+(j))*nLanes)
+
+for (int m1=s->mLow;m1<=s->mHigh;m1+=2)
+for (int m2=s->mLow;m2<=m1;m2+=2)
+	{
+	int lowDim=0;
+	bool compatible=true;
+	for (int i=0;i<5 && compatible;i++)
+		{
+		int j2m=twoJ2[mod5(i-1)];
+		LL[i]=max(max(abs(m1-j2m),abs(m2-j2m)),s->L[i]);
+		HH[i]=min(min(m1+j2m,m2+j2m),s->H[i]);
+		if (HH[i]<LL[i]) compatible=false;
+		dim[i]=1+(HH[i]-LL[i])/2;
+		if (dim[i]<dim[lowDim]) lowDim=i;
+		};
+	if (!compatible) continue;
+
+	//	The M matrices
+
+	for (int k=0;k<5;k++)
+		{
+		int kp1=(k+1)%5;
+		int d1=dim[kp1], d2=dim[k];
+		int j1=twoJ1[k], j1p=twoJ1[mod5(k+1)];
+		int j2=twoJ2[k], j2m=twoJ2[mod5(k-1)], j2p=twoJ2[mod5(k+1)];
+		for (int i=0;i<d1;i++)
+			{
+			int ckp=LL[kp1]+2*i;
+			lInt(n,ckp+1,L);
+			for (int j=0;j<d2;j++)
+				{
+				int ck=LL[k]+2*j;
+				tetOnThetasMod(ck,j2,ckp,j2m,m1,j1,j2,ckp,m1,j2m,ckp,j1,T,t1);
+				tetOnThetasMod(ck,j2,ckp,j2m,m2,j1,j2,ckp,m2,j2p,ckp,j1p,T,t2);
+				lMul(t1,t1,t2,L);
+				lMul(MM(k,i,j),t1,n,L);
+				};
+			};
+		};
+
+	//	The trace of their product
+
+	for (int l=0;l<nLanes;l++) trace[l]=0;
+	int d0=dim[lowDim], d1=dim[mod5(lowDim+1)];
+	for (int l0=0;l0<d0;l0++)
+		{
+		for (int i=0;i<d1;i++)
+			for (int l=0;l<nLanes;l++) v0[i*nLanes+l]=MM(lowDim,i,l0)[l];
+		uint32_t *vIn=v0, *vOut=v1, *tmp;
+		for (int k=1;k<=3;k++)
+			{
+			int ks=mod5(lowDim+k), dIn=dim[ks];
+			int ksp=mod5(lowDim+k+1), dOut=dim[ksp];
+			for (int i=0;i<dOut;i++)
+				{
+				for (int l=0;l<nLanes;l++) acc[l]=0;
+				for (int j=0;j<dIn;j++)
+					{
+					lMul(t1,MM(ks,i,j),vIn+j*nLanes,L);
+					lAdd(acc,acc,t1,L);
+					};
+				for (int l=0;l<nLanes;l++) vOut[i*nLanes+l]=acc[l];
+				};
+			tmp=vIn;
+			vIn=vOut;
+			vOut=tmp;
+			};
+		int m4=mod5(lowDim+4), dIn=dim[m4];
+		for (int j=0;j<dIn;j++)
+			{
+			lMul(t1,MM(m4,l0,j),vIn+j*nLanes,L);
+			lAdd(trace,trace,t1,L);
+			};
+		};
+
+	//	The term in the sum over the m's
+
+	lInt(n,(m1+1)*(m2+1)*(m1!=m2 ? 2 : 1),L);
+	lMul(trace,trace,n,L);
+	if ((s->overallParity-(m1+m2)/2)%2==0) lAdd(sumOverM,sumOverM,trace,L);
+	else lSub(sumOverM,sumOverM,trace,L);
+	};
+
+#undef MM
+
+for (int l=0;l<nLanes;l++) residues[l]=redc(sumOverM[l],L.p[l],L.pinv[l]);
+}
+
+//	--------------------------------------
+//	**** Large non-negative integers ***
+//	--------------------------------------
+
+//	Little-endian base 2^32 digits, with no leading zeros; zero is empty
+
+typedef std::vector<uint32_t> Nat;
+
+static void trim(Nat &a)
+{
+while (!a.empty() && a.back()==0) a.pop_back();
+}
+
+static int cmpNat(const Nat &a, const Nat &b)
+{
+if (a.size()!=b.size()) return a.size()<b.size() ? -1 : 1;
+for (int i=(int)a.size()-1;i>=0;i--)
+	if (a[i]!=b[i]) return a[i]<b[i] ? -1 : 1;
+return 0;
+}
+
+static Nat addNat(const Nat &a, const Nat &b)
+{
+Nat r((a.size()>b.size() ? a.size() : b.size())+1);
+uint64_t carry=0;
+for (size_t i=0;i<r.size();i++)
+	{
+	carry+=(uint64_t)(i<a.size() ? a[i] : 0)+(i<b.size() ? b[i] : 0);
+	r[i]=(uint32_t)carry;
+	carry>>=32;
+	};
+trim(r);
+return r;
+}
+
+//	subNat() requires a>=b
+
+static Nat subNat(const Nat &a, const Nat &b)
+{
+Nat r(a.size());
+int64_t borrow=0;
+for (size_t i=0;i<a.size();i++)
+	{
+	int64_t t=(int64_t)a[i]-(i<b.size() ? b[i] : 0)-borrow;
+	r[i]=(uint32_t)t;
+	borrow=t<0 ? 1 : 0;
+	};
+trim(r);
+return r;
+}
+
+static Nat mulNat(const Nat &a, const Nat &b)
+{
+if (a.empty() || b.empty()) return Nat();
+Nat r(a.size()+b.size(),0);
+for (size_t i=0;i<a.size();i++)
+	{
+	uint64_t carry=0;
+	for (size_t j=0;j<b.size();j++)
+		{
+		carry+=(uint64_t)a[i]*b[j]+r[i+j];
+		r[i+j]=(uint32_t)carry;
+		carry>>=32;
+		};
+	r[i+b.size()]=(uint32_t)carry;
+	};
+trim(r);
+return r;
+}
+
+//	mulSmall() sets a to a*m+add
+
+static void mulSmall(Nat &a, uint32_t m, uint32_t add)
+{
+uint64_t carry=add;
+for (size_t i=0;i<a.size();i++)
+	{
+	carry+=(uint64_t)a[i]*m;
+	a[i]=(uint32_t)carry;
+	carry>>=32;
+	};
+if (carry!=0) a.push_back((uint32_t)carry);
+trim(a);
+}
+
+//	divSmall() divides a by d in place, and returns the remainder
+
+static uint32_t divSmall(Nat &a, uint32_t d)
+{
+uint64_t rem=0;
+for (int i=(int)a.size()-1;i>=0;i--)
+	{
+	uint64_t cur=(rem<<32)|a[i];
+	a[i]=(uint32_t)(cur/d);
+	rem=cur%d;
+	};
+trim(a);
+return (uint32_t)rem;
+}
+
+static uint32_t modSmall(const Nat &a, uint32_t d)
+{
+uint64_t rem=0;
+for (int i=(int)a.size()-1;i>=0;i--) rem=((rem<<32)|a[i])%d;
+return (uint32_t)rem;
+}
+
+static int bitsNat(const Nat &a)
+{
+if (a.empty()) return 0;
+int b=32*((int)a.size()-1);
+for (uint32_t top=a.back();top!=0;top>>=1) b++;
+return b;
+}
+
+static Nat shiftLeft(const Nat &a, int bits)
+{
+if (a.empty()) return Nat();
+int words=bits/32, sh=bits%32;
+Nat r(a.size()+words+1,0);
+for (size_t i=0;i<a.size();i++)
+	{
+	uint64_t v=(uint64_t)a[i]<<sh;
+	r[i+words]|=(uint32_t)v;
+	r[i+words+1]|=(uint32_t)(v>>32);
+	};
+trim(r);
+return r;
+}
+
+//	divModNat() sets q and r to the quotient and remainder of a/b, for b non-zero,
+//	by Knuth's Algorithm D
+
+static void divModNat(const Nat &a, const Nat &b, Nat &q, Nat &r)
+{
+if (cmpNat(a,b)<0)
+	{
+	q.clear();
+	r=a;
+	return;
+	};
+if (b.size()==1)
+	{
+	q=a;
+	uint32_t rem=divSmall(q,b[0]);
+	r.assign(1,rem);
+	trim(r);
+	return;
+	};
+
+//	Normalise so the top digit of the divisor has its high bit set
+
+int s=0;
+for (uint32_t top=b.back();(top&0x80000000u)==0;top<<=1) s++;
+Nat bn=shiftLeft(b,s), an=shiftLeft(a,s);
+int n=(int)bn.size(), m=(int)a.size()-n;
+an.resize(a.size()+1,0);
+q.assign(m+1,0);
+
+for (int j=m;j>=0;j--)
+	{
+	uint64_t num=((uint64_t)an[j+n]<<32)|an[j+n-1];
+	uint64_t qhat=num/bn[n-1], rhat=num%bn[n-1];
+	while (qhat>=((uint64_t)1<<32) ||
+		qhat*bn[n-2]>((rhat<<32)|an[j+n-2]))
+		{
+		qhat--;
+		rhat+=bn[n-1];
+		if (rhat>=((uint64_t)1<<32)) break;
+		};
+
+	//	Multiply and subtract
+
+	int64_t borrow=0;
+	uint64_t carry=0;
+	for (int i=0;i<n;i++)
+		{
+		uint64_t p=qhat*bn[i]+carry;
+		carry=p>>32;
+		int64_t t=(int64_t)an[i+j]-(uint32_t)p-borrow;
+		an[i+j]=(uint32_t)t;
+		borrow=t<0 ? 1 : 0;
+		};
+	int64_t t=(int64_t)an[j+n]-(int64_t)carry-borrow;
+	an[j+n]=(uint32_t)t;
+
+	//	Add back if we subtracted too much
+
+	if (t<0)
+		{
+		qhat--;
+		carry=0;
+		for (int i=0;i<n;i++)
+			{
+			uint64_t s2=(uint64_t)an[i+j]+bn[i]+carry;
+			an[i+j]=(uint32_t)s2;
+			carry=s2>>32;
+			};
+		an[j+n]+=(uint32_t)carry;
+		};
+	q[j]=(uint32_t)qhat;
+	};
+trim(q);
+
+//	Unnormalise the remainder
+
+r.assign(n,0);
+for (int i=0;i<n;i++)
+	{
+	uint64_t v=an[i]>>s;
+	if (s>0 && i+1<(int)an.size()) v|=((uint64_t)an[i+1]<<(32-s))&0xffffffffu;
+	r[i]=(uint32_t)v;
+	};
+trim(r);
+}
+
+static Nat gcdNat(Nat a, Nat b)
+{
+Nat q, r;
+while (!b.empty())
+	{
+	divModNat(a,b,q,r);
+	a=b;
+	b=r;
+	};
+return a;
+}
+
+static char *toDecimal(Nat a, bool negative)
+{
+std::vector<uint32_t> chunks;
+while (!a.empty()) chunks.push_back(divSmall(a,1000000000u));
+char *s=new char[10*chunks.size()+3], *p=s;
+if (negative) *p++='-';
+if (chunks.empty()) p+=sprintf(p,"0");
+else
+	{
+	p+=sprintf(p,"%u",chunks.back());
+	for (int i=(int)chunks.size()-2;i>=0;i--) p+=sprintf(p,"%09u",chunks[i]);
+	};
+return s;
+}
+
+static Nat fromDecimal(const char *s)
+{
+Nat a;
+for (;*s;s++) if (*s>='0' && *s<='9') mulSmall(a,10,*s-'0');
+return a;
+}
+
+static XFloat toXFloat(const Nat &a)
+{
+if (a.empty()) return XFloat();
+int n=(int)a.size();
+double m=a[n-1];
+if (n>1) m=m*4294967296.0+a[n-2];
+if (n>2) m=m*4294967296.0+a[n-3];
+return XFloat(m,32*(n>3 ? n-3 : 0));
+}
+
+//	--------------------------
+//	**** Exact evaluation ***
+//	--------------------------
+
+//	reconstruct() finds N/D congruent to u mod M with |N|, D < sqrt(M/2), if there
+//	is one, by the extended Euclidean algorithm on M and u, stopped half way.
+//	The coefficients t alternate in sign, so only their magnitudes are tracked.
+
+static bool reconstruct(const Nat &M, const Nat &u, Nat &N, bool &negative, Nat &D)
+{
+int half=(bitsNat(M)-1)/2;
+Nat r0=M, r1=u, t0, t1(1,1), q, r;
+bool t1neg=false;
+while (bitsNat(r1)>half)
+	{
+	divModNat(r0,r1,q,r);
+	r0=r1;
+	r1=r;
+	Nat t=addNat(t0,mulNat(q,t1));		//	|t0 - q*t1|, since t0 and t1 differ in sign
+	t0=t1;
+	t1=t;
+	t1neg=!t1neg;
+	};
+if (t1.empty() || bitsNat(t1)>half) return false;
+N=r1;
+D=t1;
+negative=t1neg && !N.empty();
+return true;
+}
+
+//	agrees() checks N/D against residues mod a batch of primes
+
+static bool agrees(const Nat &N, bool negative, const Nat &D, Lanes &L, uint32_t *residues)
+{
+for (int l=0;l<nLanes;l++)
+	{
+	uint64_t p=L.p[l], n=modSmall(N,L.p[l]), d=modSmall(D,L.p[l]);
+	if (negative) n=(p-n)%p;
+	if (n!=residues[l]*d%p) return false;
+	};
+return true;
+}
+
+//	tenJExact()
+//	===========
+
+bool tenJExact(int *twoJ1, int *twoJ2, int maxPrimes, TenJExact *result)
+{
+result->ok=false;
+result->nPrimes=0;
+result->numerator=result->denominator=NULL;
+result->value=XFloat();
+
+//	The matrices are sized to the symbol, so one too large for tenJ() is no problem
+
+TenJSetup s;
+tenJSetup(twoJ1,twoJ2,&s);
+
+//	Every factorial argument is at most half the sum of six spins, each at most
+//	three times the largest
+
+int maxTwoJ=0;
+for (int i=0;i<5;i++)
+	{
+	if (twoJ1[i]>maxTwoJ) maxTwoJ=twoJ1[i];
+	if (twoJ2[i]>maxTwoJ) maxTwoJ=twoJ2[i];
+	};
+int nFact=9*maxTwoJ+4;
+
+Nat M(1,1), u, N, D;
+bool negative=false, haveCandidate=false;
+uint32_t from=0x7fffffffu+2u, residues[nLanes];
+FactTables T;
+
+while (result->nPrimes+nLanes<=maxPrimes)
+	{
+	nextPrimes(from,T.L);
+	makeTables(T,nFact);
+	tenJMod(&s,T,residues);
+	freeTables(T);
+	result->nPrimes+=nLanes;
+
+	//	Accept the candidate if this batch agrees with it
+
+	if (haveCandidate && agrees(N,negative,D,T.L,residues))
+		{
+		result->ok=true;
+		break;
+		};
+
+	//	Otherwise combine the batch with the previous ones by the Chinese remainder
+	//	theorem, and look for a new candidate
+
+	for (int l=0;l<nLanes;l++)
+		{
+		uint32_t p=T.L.p[l];
+		uint64_t um=modSmall(u,p), Mm=modSmall(M,p);
+		uint64_t k=(residues[l]+p-um)%p*powMod((uint32_t)Mm,p-2,p)%p;
+		Nat step=M;
+		mulSmall(step,(uint32_t)k,0);
+		u=addNat(u,step);
+		mulSmall(M,p,0);
+		};
+	haveCandidate=reconstruct(M,u,N,negative,D);
+	};
+if (!result->ok) return false;
+
+//	Reduce to lowest terms, which the reconstruction almost always gives already
+
+Nat g=gcdNat(N,D), q, r;
+if (!(g.size()==1 && g[0]==1) && !g.empty())
+	{
+	divModNat(N,g,q,r);
+	N=q;
+	divModNat(D,g,q,r);
+	D=q;
+	};
+
+result->numerator=toDecimal(N,negative);
+result->denominator=toDecimal(D,false);
+result->value=toXFloat(N)/toXFloat(D);
+if (negative) result->value=-result->value;
+return true;
+}
+
+//	tenJExactError()
+//	================
+//
+//	Returns |approx - N/D| / |N/D|, computing approx*D - N exactly.
+
+double tenJExactError(TenJExact *exact, TENJfloat approx)
+{
+Nat N=fromDecimal(exact->numerator), D=fromDecimal(exact->denominator);
+bool negative=exact->numerator[0]=='-';
+if (N.empty()) return approx==0.0 ? 0.0 : INFINITY;
+
+//	approx = a * 2^e exactly, with a a 64-bit integer
+
+int e;
+long double m=frexpl((long double)approx,&e);
+bool aNeg=m<0.0L;
+if (aNeg) m=-m;
+uint64_t a=(uint64_t)ldexpl(m,64);
+e-=64;
+Nat A;
+A.push_back((uint32_t)a);
+A.push_back((uint32_t)(a>>32));
+trim(A);
+
+//	Compare a*D*2^e with N, scaling whichever side has the negative power of 2
+
+Nat lhs=mulNat(A,D), rhs=N;
+if (e>=0) lhs=shiftLeft(lhs,e); else rhs=shiftLeft(rhs,-e);
+Nat diff;
+if (aNeg==negative) diff=cmpNat(lhs,rhs)>=0 ? subNat(lhs,rhs) : subNat(rhs,lhs);
+else diff=addNat(lhs,rhs);
+return (toXFloat(diff)/toXFloat(rhs)).toDouble();
+}
+
+void freeTenJExact(TenJExact *exact)
+{
+delete [] exact->numerator;
+delete [] exact->denominator;
+exact->numerator=exact->denominator=NULL;
+}
@@ -0,0 +1,116 @@
+/*
+
+exactMain.cpp
+=============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a main program that computes 10j symbols exactly, and measures
+the rounding error of tenJ() against them.
+
+	10jexact [-p maxPrimes] <twoJ1[0..4]> <twoJ2[0..4]>
+	10jexact [-p maxPrimes] <twoJ>
+
+computes a single symbol, general or regular; with no spins on the command line,
+it reads symbols from standard input, one per line, as 10 values of 2j or as a
+single value for a regular symbol.
+
+For each symbol it prints the exact value as a fraction, the number of primes
+needed (at most maxPrimes, default 4096), the value from tenJ(), its relative
+error, and the number of correct significant digits.
+
+*/
+
+#include <string.h>
+#include "spin.h"
+
+void usage()
+{
+printf("usage:\t10jexact [-p maxPrimes] [<10 values of 2j> | <2j>]\n");
+exit(2);
+}
+
+static int maxPrimes=4096;
+
+//	Compute and report on one symbol
+
+static void report(int *twoJ1, int *twoJ2)
+{
+bool regular=true;
+for (int i=0;i<5;i++) regular&=(twoJ1[i]==twoJ1[0] && twoJ2[i]==twoJ1[0]);
+
+printf("{{%d,%d,%d,%d,%d},{%d,%d,%d,%d,%d}}\n",
+	twoJ1[0],twoJ1[1],twoJ1[2],twoJ1[3],twoJ1[4],
+	twoJ2[0],twoJ2[1],twoJ2[2],twoJ2[3],twoJ2[4]);
+
+clock_t c0=clock();
+TenJExact exact;
+if (!tenJExact(twoJ1,twoJ2,maxPrimes,&exact))
+	{
+	printf("\tnot computed exactly with %d primes\n",exact.nPrimes);
+	fflush(stdout);
+	return;
+	};
+double exactSeconds=(clock()-c0)/(double)CLOCKS_PER_SEC;
+
+c0=clock();
+TENJfloat approx=regular ? tenJ(twoJ1[0]) : tenJ(twoJ1,twoJ2);
+double floatSeconds=(clock()-c0)/(double)CLOCKS_PER_SEC;
+double error=tenJExactError(&exact,approx);
+
+char buf[64];
+xToString(exact.value,17,buf);
+printf("\texact   = %s / %s\n",exact.numerator,exact.denominator);
+printf("\t        = %s  (%d primes, %.3f seconds)\n",buf,exact.nPrimes,exactSeconds);
+printf("\ttenJ    = %.17g  (%.3f seconds)\n",(double)approx,floatSeconds);
+printf("\terror   = %.3e  (%.1f digits)\n",error,error>0.0 ? -log10(error) : 99.0);
+fflush(stdout);
+freeTenJExact(&exact);
+}
+
+int main(int argc, char **argv)
+{
+int arg=1;
+while (arg<argc && argv[arg][0]=='-')
+	{
+	if (arg+1>=argc) usage();
+	if (strcmp(argv[arg],"-p")==0) maxPrimes=atoi(argv[arg+1]);
+	else usage();
+	arg+=2;
+	};
+
+int twoJ1[5], twoJ2[5];
+if (argc-arg==10)
+	{
+	for (int i=0;i<5;i++)
+		{
+		twoJ1[i]=atoi(argv[arg+i]);
+		twoJ2[i]=atoi(argv[arg+5+i]);
+		};
+	report(twoJ1,twoJ2);
+	}
+else if (argc-arg==1)
+	{
+	for (int i=0;i<5;i++) twoJ1[i]=twoJ2[i]=atoi(argv[arg]);
+	report(twoJ1,twoJ2);
+	}
+else if (argc-arg==0)
+	{
+	char line[512];
+	while (fgets(line,sizeof(line),stdin)!=NULL)
+		{
+		int v[10];
+		int n=sscanf(line,"%d %d %d %d %d %d %d %d %d %d",
+			v,v+1,v+2,v+3,v+4,v+5,v+6,v+7,v+8,v+9);
+		if (n==10)
+			for (int i=0;i<5;i++) {twoJ1[i]=v[i]; twoJ2[i]=v[5+i];}
+		else if (n==1)
+			for (int i=0;i<5;i++) twoJ1[i]=twoJ2[i]=v[0];
+		else continue;
+		report(twoJ1,twoJ2);
+		};
+	}
+else usage();
+return 0;
+}
@@ -29,11 +29,24 @@ numbers as integer powers of primes.
 The second implementation performs all computations using ordinary floating point
 arithmetic, of type FACTfloat.
 
+Both implementations also provide multiRatioX(), which returns the same product
+as an XFloat (see XFloat.h), with an exponent that cannot overflow.
+
 In both implementations, a cache of factorials is accumulated (in the PrimePowers
-implementation, this cache is handled in the PrimePowers code).
+implementation, this cache is handled in the PrimePowers code).  Both caches can
+be used by several threads at once.
+
+Factorials up to MAX_TABLE_FACTORIAL (see spin.h) come from tables that the compiler
+builds, so that small symbols need no allocation and no run-time growth of the
+caches:  the powers of the primes in each n! for the PrimePowers implementation,
+and the ratios n!/m! for the floating point one.  Both give the same values, bit
+for bit, as the caches they stand in for.
 
 */
 
+#include <atomic>
+#include <mutex>
+#include <vector>
 #include "spin.h"
 
 //	-----------------------------------
@@ -44,6 +57,115 @@ implementation, this cache is handled in the PrimePowers code).
 
 #include "PrimePowers.h"
 
+//	FactorialPrimeTable holds the primes up to MAX_TABLE_FACTORIAL, the number of
+//	them up to each n, and the power of each one in n! for every n up to
+//	MAX_TABLE_FACTORIAL, from Legendre's formula.
+
+constexpr int countPrimes(int n)
+{
+int count=0;
+for (int k=2;k<=n;k++)
+	{
+	bool isPrime=true;
+	for (int d=2;d*d<=k;d++) if (k%d==0) isPrime=false;
+	if (isPrime) count++;
+	};
+return count;
+}
+
+#define nTablePrimes countPrimes(MAX_TABLE_FACTORIAL)
+
+struct FactorialPrimeTable
+	{
+	int prime[nTablePrimes];
+	int primesTo[MAX_TABLE_FACTORIAL+1];
+	int power[MAX_TABLE_FACTORIAL+1][nTablePrimes];
+	
+	constexpr FactorialPrimeTable() : prime(), primesTo(), power()
+		{
+		int n=0;
+		for (int k=2;k<=MAX_TABLE_FACTORIAL;k++)
+			{
+			bool isPrime=true;
+			for (int i=0;i<n && prime[i]*prime[i]<=k;i++) if (k%prime[i]==0) isPrime=false;
+			if (isPrime) prime[n++]=k;
+			primesTo[k]=n;
+			};
+		for (int f=0;f<=MAX_TABLE_FACTORIAL;f++)
+			for (int i=0;i<nTablePrimes;i++)
+				for (int q=prime[i];q<=f;q*=prime[i]) power[f][i]+=f/q;
+		}
+	};
+
+static constexpr FactorialPrimeTable factorialTable;
+
+//	tableRatio() computes the product of several ratios of factorials, all of them
+//	in the table and none above top, with the primes multiplied or divided in the
+//	same order as in PrimePowers::evaluate()
+
+static FACTfloat tableRatio(int *nn, int *dd, int size, int top)
+{
+int power[nTablePrimes]={}, np=factorialTable.primesTo[top];
+for (int k=0;k<size;k++)
+	{
+	const int *pn=factorialTable.power[nn[k]], *pd=factorialTable.power[dd[k]];
+	for (int i=0;i<np;i++) power[i]+=pn[i]-pd[i];
+	};
+PPfloat prod=1;
+for (int i=0;i<np;i++)
+	{
+	int n=power[i];
+	if (n==0) continue;
+	PPfloat factor=factorialTable.prime[i];
+	if (n>0) for (int j=0;j<n;j++) prod=prod*factor;
+	else for (int j=0;j<-n;j++) prod=prod/factor;
+	};
+return (FACTfloat)prod;
+}
+
+//	factorialPowers() gives a table of the power of each prime in n!, for every n up
+//	to top, as rows of stride entries; nPrimes is set to the number of primes up to
+//	top, and primes to the list of them, in the order of PrimePowers::managedPrimes().
+//	Up to MAX_TABLE_FACTORIAL this is the compiler's table; above that, each thread
+//	builds its own, doubling it in size each time it is outgrown.
+
+const int *factorialPowers(int top, int &stride, int &nPrimes, const int *&primes)
+{
+if (top<=MAX_TABLE_FACTORIAL)
+	{
+	stride=nTablePrimes;
+	nPrimes=factorialTable.primesTo[top];
+	primes=factorialTable.prime;
+	return &factorialTable.power[0][0];
+	};
+
+static thread_local std::vector<int> tPrimes, tPowers;
+static thread_local int tTop=-1;
+if (top>tTop)
+	{
+	int newTop=2*tTop>top ? 2*tTop : top;
+	std::vector<bool> composite(newTop+1,false);
+	tPrimes.clear();
+	for (int k=2;k<=newTop;k++)
+		if (!composite[k])
+			{
+			tPrimes.push_back(k);
+			for (long long m=(long long)k*k;m<=newTop;m+=k) composite[m]=true;
+			};
+	int np=(int)tPrimes.size();
+	tPowers.assign((size_t)(newTop+1)*np,0);
+	for (int f=2;f<=newTop;f++)
+		for (int i=0;i<np && tPrimes[i]<=f;i++)
+			for (long long q=tPrimes[i];q<=f;q*=tPrimes[i]) tPowers[(size_t)f*np+i]+=f/q;
+	tTop=newTop;
+	};
+stride=(int)tPrimes.size();
+nPrimes=0;
+while (nPrimes<stride && tPrimes[nPrimes]<=top) nPrimes++;
+primes=&tPrimes[0];
+return &tPowers[0];
+}
+
 //	multiRatio()
 //	============
 //
@@ -51,6 +173,14 @@ implementation, this cache is handled in the PrimePowers code).
 
 FACTfloat multiRatio(int *nn, int *dd, int size)
 {
+int top=0;
+for (int i=0;i<size;i++)
+	{
+	if (nn[i]>top) top=nn[i];
+	if (dd[i]>top) top=dd[i];
+	};
+if (top<=MAX_TABLE_FACTORIAL) return tableRatio(nn,dd,size,top);
+
 //	Convert the lists of factorials in the numerator and denominator
 //	into a single list with positive and negative powers.
 
@@ -84,6 +214,43 @@ delete b;
 return result;
 }
 
+//	multiRatioX()
+//	=============
+//
+//	Return the product of several ratios of factorials, with an extended exponent
+
+XFloat multiRatioX(int *nn, int *dd, int size)
+{
+int *f=new int[2*size];
+int *p=new int[2*size];
+int n=0;
+for (int i=0;i<size;i++)
+	{
+	if (nn[i]!=0)
+		{
+		f[n]=nn[i];
+		p[n++]=1;
+		};
+	if (dd[i]!=0)
+		{
+		f[n]=dd[i];
+		p[n++]=-1;
+		};
+	};
+	
+PrimePowers *a=new PrimePowers();
+PrimePowers *b=a->multByFactorials(f,p,n);
+int e;
+double m=(double)b->evaluateScaled(e);
+XFloat result(m,e);
+
+delete [] f;
+delete [] p;
+delete a;
+delete b;
+return result;
+}
+
 #else
 
 //	--------------------------------------
@@ -92,6 +259,26 @@ return result;
 
 FACTfloat factorialRatio(int f, int g);
 
+//	FactorialRatioTable holds n!/m! for m <= n <= MAX_TABLE_FACTORIAL, built in the
+//	same way as the cache in factorialRatio() below.
+
+struct FactorialRatioTable
+	{
+	FACTfloat ratio[MAX_TABLE_FACTORIAL+1][MAX_TABLE_FACTORIAL+1];
+	
+	constexpr FactorialRatioTable() : ratio()
+		{
+		ratio[0][0]=1.0;
+		for (int top=1;top<=MAX_TABLE_FACTORIAL;top++)
+			{
+			for (int i=0;i<top;i++) ratio[top][i]=ratio[top-1][i]*top;
+			ratio[top][top]=1.0;
+			};
+		}
+	};
+
+static constexpr FactorialRatioTable factorialTable;
+
 //	factorial() returns factorial of non-negative integers.
 
 FACTfloat factorial(int f)
@@ -101,10 +288,16 @@ return factorialRatio(f,0);	//	Obtain factorial from cache as f!/0!
 
 //	factorialRatio() computes/caches ratios of factorials of non-negative integers.
 
-FACTfloat **fList=0;		/*	Array of factorial ratios	*/
-int topF=-1;				/*	Highest factorial for which we have data */
-int sFlist=0;				/*	Current size of array fList	*/
-int incFlist=100;			/*	Increment in size for fList */
+//	The cache is only extended while holding fLock, and topF is only increased
+//	once the new entries are complete; an enlarged fList array does not replace
+//	the old one until it holds copies of all its entries, and the old array is
+//	not deleted, since another thread might still be reading from it.
+
+std::atomic<FACTfloat **> fList(0);	/*	Array of factorial ratios	*/
+std::atomic<int> topF(-1);			/*	Highest factorial for which we have data */
+int sFlist=0;						/*	Current size of array fList	*/
+int incFlist=100;					/*	Increment in size for fList */
+std::mutex fLock;					/*	Lock held while extending fList */
 
 FACTfloat factorialRatio(int f, int g)
 {
@@ -121,11 +314,16 @@ if (g>f)
 	invert=true;
 	};
 
+if (f<=MAX_TABLE_FACTORIAL)
+	return invert ? 1.0/factorialTable.ratio[f][g] : factorialTable.ratio[f][g];
+
 int i, j, nsFlist;
 FACTfloat **tmp;
 
 if (f>topF)							/*	Don't yet have data for f!	*/
 	{
+	std::lock_guard<std::mutex> lock(fLock);
+	
 	if (f>=sFlist)					/*	Make room for lists to go up to f	*/
 		{
 		i=1+(f+1-sFlist)/incFlist;
@@ -135,7 +333,6 @@ if (f>topF)							/*	Don't yet have data for f!	*/
 		if (fList!=0)
 			{
 			for (j=0;j<sFlist;j++) tmp[j]=fList[j];
-			delete [] fList;
 			};
 		fList=tmp;
 		
@@ -146,19 +343,21 @@ if (f>topF)							/*	Don't yet have data for f!	*/
 	
 	if (topF<0)
 		{
-		topF=0;
 		fList[0]=new FACTfloat[1];
 		fList[0][0]=1.0;
+		topF=0;
 		};
 		
 	/*	Loop, creating new sets of factorial ratios */
 	
-	while (topF<f)
+	int top=topF;
+	while (top<f)
 		{
-		topF++;
-		FACTfloat *latest=fList[topF]=new FACTfloat[topF+1], *prev=fList[topF-1];
-		for (int i=0;i<topF;i++) latest[i]=prev[i]*topF;
-		latest[topF]=1.0;
+		top++;
+		FACTfloat *latest=fList[top]=new FACTfloat[top+1], *prev=fList[top-1];
+		for (int i=0;i<top;i++) latest[i]=prev[i]*top;
+		latest[top]=1.0;
+		topF=top;
 		};
 	};
 return invert ? 1.0/fList[f][g] : fList[f][g];
@@ -293,4 +492,33 @@ delete [] used;
 return result;
 }
 
+//	multiRatioX()
+//	=============
+//
+//	Return the product of several ratios of factorials, with an extended exponent;
+//	any ratio that is out of range for FACTfloat is multiplied in one factor at
+//	a time.
+
+XFloat multiRatioX(int *nn, int *dd, int size)
+{
+qsort(nn, size, sizeof(int), cmp);
+qsort(dd, size, sizeof(int), cmp);
+
+XFloat result(1.0);
+for (int k=0;k<size;k++)
+	{
+	FACTfloat r=factorialRatio(nn[k],dd[k]);
+	if (r!=0.0 && !isinf(r) && !isnan(r))
+		{
+		result*=XFloat((double)r);
+		continue;
+		};
+	if (nn[k]>dd[k])
+		for (int l=nn[k];l>dd[k];l--) result*=XFloat((double)l);
+	else
+		for (int l=dd[k];l>nn[k];l--) result/=XFloat((double)l);
+	};
+return result;
+}
+
 #endif
@@ -0,0 +1,113 @@
+/*
+
+foamMain.cpp
+============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a main program that computes the amplitudes of spin foams in
+the DFKR version of the Barrett-Crane model.
+
+	10jfoam <triangulation> <twoJ>
+	10jfoam <triangulation> <twoJ for each triangle>
+	10jfoam <triangulation> -r <count> <maxTwoJ>
+
+The triangulation is either S4, for the boundary of a 5-simplex, or the name of a
+file listing the five vertex labels of each 4-simplex, one 4-simplex per line.
+The first two forms compute the amplitude of a single foam, with the same spin on
+every triangle or with the given spins.  The third computes the amplitudes of
+count foams along a random walk, starting with the same integer spin on every
+triangle (the largest with 2j <= maxTwoJ) and changing one spin by +1 or -1 at
+each step, keeping 2j <= maxTwoJ and skipping foams whose amplitude is zero
+because some tetrahedron is inadmissible.  It reports the time
+taken and how often the 10j symbols were already in the cache, in batches, so
+the warm-up is visible.
+
+A foam with a 10j symbol too large for tenJ() (see maxC in spin.h) is reported,
+and the program stops with exit status 1.
+
+*/
+
+#include <string.h>
+#include "spin.h"
+
+void usage()
+{
+printf("usage:\t10jfoam <S4 | file> <2j | 2j for each triangle | -r count maxTwoJ>\n");
+exit(2);
+}
+
+static void printAmplitude(double logAmp, int sign)
+{
+if (isnan(logAmp)) printf("amplitude NaN:  a 10j symbol needs matrices larger than maxC=%d\n",maxC);
+else if (sign==0) printf("amplitude 0\n");
+else printf("log|amplitude| %.15g, amplitude %s%.15g\n",logAmp,sign<0 ? "-" : "",exp(logAmp));
+}
+
+int main(int argc, char **argv)
+{
+if (argc<3) usage();
+Triangulation tri;
+if (!readTriangulation(argv[1],&tri)) return 1;
+printf("%d 4-simplices, %d tetrahedra, %d triangles\n",tri.nPent,tri.nTets,tri.nTriangles);
+
+int *twoJ=new int[tri.nTriangles];
+int sign, status=0;
+if (strcmp(argv[2],"-r")!=0)
+	{
+	if (argc!=3 && argc!=3+tri.nTriangles) usage();
+	for (int f=0;f<tri.nTriangles;f++) twoJ[f]=atoi(argv[argc==3 ? 2 : 2+f]);
+	double logAmp=dfkrLogAmplitude(&tri,twoJ,sign);
+	printAmplitude(logAmp,sign);
+	status=isnan(logAmp) ? 1 : 0;
+	}
+else
+	{
+	if (argc!=5) usage();
+	int count=atoi(argv[3]), maxTwoJ=atoi(argv[4]);
+	int batch=count/10>0 ? count/10 : 1;
+	long long lastHits=0, lastMisses=0, entries, hits, misses;
+	srand(1);
+	if (maxTwoJ<2)
+		{
+		printf("maxTwoJ must be at least 2\n");
+		return 1;
+		};
+	for (int f=0;f<tri.nTriangles;f++) twoJ[f]=maxTwoJ-maxTwoJ%2;
+	clock_t c0=clock();
+	printf("%8s %10s %12s %10s\n","foams","seconds","cache hits","entries");
+	for (int n=1;n<=count;)
+		{
+		int f=rand()%tri.nTriangles, step=rand()%2==0 ? 2 : -2;
+		if (twoJ[f]+step<0 || twoJ[f]+step>maxTwoJ) continue;
+		twoJ[f]+=step;
+		double logAmp=dfkrLogAmplitude(&tri,twoJ,sign);
+		if (isnan(logAmp))
+			{
+			printAmplitude(logAmp,sign);
+			status=1;
+			break;
+			};
+		if (sign==0)
+			{
+			twoJ[f]-=step;
+			continue;
+			};
+		if (n%batch==0 || n==count)
+			{
+			tenJCacheInfo(entries,hits,misses);
+			long long dh=hits-lastHits, dm=misses-lastMisses;
+			printf("%8d %10.3f %11.1f%% %10lld\n",n,(clock()-c0)/(double)CLOCKS_PER_SEC,
+				dh+dm>0 ? 100.0*dh/(dh+dm) : 0.0,entries);
+			lastHits=hits;
+			lastMisses=misses;
+			};
+		n++;
+		};
+	};
+
+delete [] twoJ;
+freeTriangulation(&tri);
+return status;
+}
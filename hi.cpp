@@ -25,9 +25,11 @@ const int gluings[5][4][4] = {
 
 /**
  * The following code constructs a 3-dimensional triangulation
- * based on the information stored in the arrays above.
+ * based on the information stored in the arrays above, with
+ * makeComplex() (complex.cpp) in place of Regina's
+ * Triangulation<3>::insertConstruction().
  */
 
-Triangulation<3> tri;
-tri.insertConstruction(5, adjacencies, gluings);
+Complex tri;
+makeComplex(3, 5, &adjacencies[0][0], &gluings[0][0][0], &tri);
 
@@ -0,0 +1,220 @@
+/*
+
+incremental.cpp
+===============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains an evaluator for 10j symbols that are changed one spin at a
+time, as in Monte Carlo moves, parameter scans and propagator studies, keeping
+everything from the previous evaluation that the change leaves alone.
+
+	TenJIncremental *newTenJIncremental(int *twoJ1, int *twoJ2)
+
+computes the symbol as tenJ() does, and keeps, for every pair of m's, the five
+coefficient matrices and the trace of their product.
+
+	TENJfloat tenJIncrementalSet(TenJIncremental *inc, int edge, int twoJ)
+
+changes one spin, twoJ1[edge] for edge 0..4 or twoJ2[edge-5] for edge 5..9, and
+returns the new value of the symbol; tenJIncrementalValue() returns the current
+value.  The matrix M_k depends only on the spins twoJ1[k], twoJ1[k+1], twoJ2[k-1],
+twoJ2[k] and twoJ2[k+1], on the m's, and on the ranges of c_k and c_{k+1}, which
+the spin can also move (see tenJMatrix() in tenJ.cpp).  Each stored matrix is
+tagged with all of these, and is recomputed only if one of them differs; the
+trace is recomputed only if one of the five matrices was.  Pairs of m's that were
+not in the range before are computed in full, and those that leave it are kept,
+in case a later change brings them back.  The result is bit for bit the same as
+tenJ().
+
+Changing a spin twoJ1[i] alters at most M_{i-1}, M_i and M_{i+1}, and a spin
+twoJ2[i] at most M_{i-1} to M_{i+2}; for pairs of m's where the change does not
+move the ranges of the c's, fewer.  tenJIncrementalInfo() reports how many
+matrices were computed and how many reused.
+
+	int tenJVaryEdge(int *twoJ1, int *twoJ2, int edge, int twoJMin, int twoJMax,
+		TENJfloat *values)
+
+computes the symbol for each 2j = twoJMin, twoJMin+2, ... up to twoJMax on one
+edge, with the other spins as given, by successive calls to tenJIncrementalSet(),
+and returns the number of values.
+
+*/
+
+#include <vector>
+#include <unordered_map>
+#include "spin.h"
+
+//	The matrix M_k for one pair of m's, with everything it depends on
+
+struct IncrementalBlock
+	{
+	bool valid;
+	int tag[9];					//	Spins, LL and dim it was computed for
+	std::vector<TENJfloat> M;	//	Stored with row stride dim[k]
+
+	IncrementalBlock() : valid(false) {}
+	};
+
+struct IncrementalStep
+	{
+	IncrementalBlock block[5];
+	bool traceValid;
+	TENJfloat trace;
+
+	IncrementalStep() : traceValid(false), trace(0.0) {}
+	};
+
+struct TenJIncremental
+	{
+	TenJSetup s;
+	std::unordered_map<int,IncrementalStep> steps;	//	Keyed by (m1, m2)
+	std::vector<TENJfloat> v0, v1;
+	TENJfloat value;
+	long long computed, reused;
+	};
+
+//	Evaluate the symbol with the current spins, reusing what we can
+
+static void evaluate(TenJIncremental *inc)
+{
+int twoJ1[5], twoJ2[5];
+for (int i=0;i<5;i++)
+	{
+	twoJ1[i]=inc->s.twoJ1[i];
+	twoJ2[i]=inc->s.twoJ2[i];
+	};
+TenJSetup *s=&inc->s;
+tenJSetup(twoJ1,twoJ2,s);
+
+TENJfloat sumOverM=0.0;
+for (int m1=s->mLow;m1<=s->mHigh;m1+=2)
+for (int m2=s->mLow;m2<=m1;m2+=2)
+	{
+	int LL[5], dim[5], lowDim;
+	if (!tenJLimits(s,m1,m2,LL,dim,lowDim)) continue;
+
+	IncrementalStep &step=inc->steps[(m1<<16)|m2];
+	bool changed=false;
+	for (int k=0;k<5;k++)
+		{
+		int kp1=(k+1)%5;
+		int tag[9]={twoJ1[k],twoJ1[kp1],twoJ2[mod5(k-1)],twoJ2[k],twoJ2[kp1],
+			LL[k],LL[kp1],dim[k],dim[kp1]};
+		IncrementalBlock &b=step.block[k];
+		bool same=b.valid;
+		for (int i=0;same && i<9;i++) same=b.tag[i]==tag[i];
+		if (same)
+			{
+			inc->reused++;
+			continue;
+			};
+		for (int i=0;i<9;i++) b.tag[i]=tag[i];
+		b.M.resize(dim[kp1]*dim[k]);
+		tenJMatrix(s,k,m1,m2,LL,dim,&b.M[0],dim[k]);
+		b.valid=true;
+		changed=true;
+		inc->computed++;
+		};
+
+	if (changed || !step.traceValid)
+		{
+		TENJfloat *M[5];
+		int stride[5], big=0;
+		for (int k=0;k<5;k++)
+			{
+			M[k]=&step.block[k].M[0];
+			stride[k]=dim[k];
+			if (dim[k]>big) big=dim[k];
+			};
+		if ((int)inc->v0.size()<big)
+			{
+			inc->v0.resize(big);
+			inc->v1.resize(big);
+			};
+		step.trace=tenJTrace(M,stride,dim,lowDim,&inc->v0[0],&inc->v1[0]);
+		step.traceValid=true;
+		};
+
+	//	The term in the sum over the m's, as in tenJTerm()
+
+	TENJfloat term=(m1+1)*(m2+1)*step.trace*
+		((s->overallParity-(m1+m2)/2)%2==0?1:-1);
+	if (m1!=m2) term*=2;
+	sumOverM+=term;
+	};
+inc->value=sumOverM;
+}
+
+//	newTenJIncremental()
+//	====================
+
+TenJIncremental *newTenJIncremental(int *twoJ1, int *twoJ2)
+{
+TenJIncremental *inc=new TenJIncremental;
+for (int i=0;i<5;i++)
+	{
+	inc->s.twoJ1[i]=twoJ1[i];
+	inc->s.twoJ2[i]=twoJ2[i];
+	};
+inc->computed=inc->reused=0;
+evaluate(inc);
+return inc;
+}
+
+void deleteTenJIncremental(TenJIncremental *inc)
+{
+delete inc;
+}
+
+TENJfloat tenJIncrementalValue(TenJIncremental *inc)
+{
+return inc->value;
+}
+
+void tenJIncrementalInfo(TenJIncremental *inc, long long &computed, long long &reused)
+{
+computed=inc->computed;
+reused=inc->reused;
+}
+
+//	tenJIncrementalSet()
+//	====================
+
+TENJfloat tenJIncrementalSet(TenJIncremental *inc, int edge, int twoJ)
+{
+if (edge<0 || edge>=10 || twoJ<0)
+	{
+	printf("tenJIncrementalSet() was given edge %d and 2j %d\n",edge,twoJ);
+	return inc->value;
+	};
+int *spin=edge<5 ? &inc->s.twoJ1[edge] : &inc->s.twoJ2[edge-5];
+if (*spin==twoJ) return inc->value;
+*spin=twoJ;
+evaluate(inc);
+return inc->value;
+}
+
+//	tenJVaryEdge()
+//	==============
+
+int tenJVaryEdge(int *twoJ1, int *twoJ2, int edge, int twoJMin, int twoJMax,
+	TENJfloat *values)
+{
+if (edge<0 || edge>=10 || twoJMin<0 || twoJMax<twoJMin) return 0;
+int start1[5], start2[5];
+for (int i=0;i<5;i++)
+	{
+	start1[i]=twoJ1[i];
+	start2[i]=twoJ2[i];
+	};
+if (edge<5) start1[edge]=twoJMin; else start2[edge-5]=twoJMin;
+
+TenJIncremental *inc=newTenJIncremental(start1,start2);
+int n=0;
+values[n++]=inc->value;
+for (int twoJ=twoJMin+2;twoJ<=twoJMax;twoJ+=2) values[n++]=tenJIncrementalSet(inc,edge,twoJ);
+deleteTenJIncremental(inc);
+return n;
+}
@@ -0,0 +1,81 @@
+/*
+
+incrementalMain.cpp
+===================
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a main program that computes a 10j symbol for a range of one
+of its spins with tenJVaryEdge(), and compares the values and the time taken
+with separate calls to tenJ().
+
+	10jvary <edge> <twoJMin> <twoJMax> <twoJ1[0..4]> <twoJ2[0..4]>
+
+The edge is 0..4 for twoJ1[edge] or 5..9 for twoJ2[edge-5]; its value among the
+ten spins given is ignored.  It then changes each of the ten spins in turn by +2
+and back with tenJIncrementalSet(), and reports how many of the coefficient
+matrices were reused.
+
+*/
+
+#include <vector>
+#include "spin.h"
+
+void usage()
+{
+printf("usage:\t10jvary <edge> <twoJMin> <twoJMax> <twoJ1[0..4]> <twoJ2[0..4]>\n");
+exit(2);
+}
+
+int main(int argc, char **argv)
+{
+if (argc!=14) usage();
+int edge=atoi(argv[1]), twoJMin=atoi(argv[2]), twoJMax=atoi(argv[3]);
+int twoJ1[5], twoJ2[5];
+for (int i=0;i<5;i++)
+	{
+	twoJ1[i]=atoi(argv[4+i]);
+	twoJ2[i]=atoi(argv[9+i]);
+	};
+if (edge<0 || edge>=10 || twoJMin<0 || twoJMax<twoJMin) usage();
+
+std::vector<TENJfloat> values((twoJMax-twoJMin)/2+1), direct(values.size());
+clock_t c0=clock();
+int n=tenJVaryEdge(twoJ1,twoJ2,edge,twoJMin,twoJMax,&values[0]);
+double tVary=(clock()-c0)/(double)CLOCKS_PER_SEC;
+
+c0=clock();
+for (int i=0;i<n;i++)
+	{
+	if (edge<5) twoJ1[edge]=twoJMin+2*i; else twoJ2[edge-5]=twoJMin+2*i;
+	direct[i]=tenJ(twoJ1,twoJ2);
+	};
+double tDirect=(clock()-c0)/(double)CLOCKS_PER_SEC;
+
+int nDiffer=0;
+for (int i=0;i<n;i++)
+	{
+	printf("%4d %24.17g\n",twoJMin+2*i,(double)values[i]);
+	if (values[i]!=direct[i]) nDiffer++;
+	};
+printf("%d values in %.3f seconds, against %.3f seconds for tenJ(); %d differ\n",
+	n,tVary,tDirect,nDiffer);
+
+//	Change each spin by +2 and back
+
+TenJIncremental *inc=newTenJIncremental(twoJ1,twoJ2);
+long long computed0, reused0, computed, reused;
+tenJIncrementalInfo(inc,computed0,reused0);
+for (int e=0;e<10;e++)
+	{
+	int twoJ=e<5 ? twoJ1[e] : twoJ2[e-5];
+	tenJIncrementalSet(inc,e,twoJ+2);
+	tenJIncrementalSet(inc,e,twoJ);
+	};
+tenJIncrementalInfo(inc,computed,reused);
+printf("Changing each spin and back: %lld matrices recomputed, %lld reused (%.1f%%)\n",
+	computed-computed0,reused-reused0,100.0*(reused-reused0)/(computed-computed0+reused-reused0));
+deleteTenJIncremental(inc);
+return nDiffer==0 ? 0 : 1;
+}
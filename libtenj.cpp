@@ -0,0 +1,339 @@
+/*
+
+libtenj.cpp
+===========
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains the C interface of libtenj, declared in tenj.h, on top of the
+C++ routines of the package.
+
+A context holds a pool of worker threads, started once and kept waiting on a
+condition variable between calls.  A batch is run by giving every worker the same
+job, which takes records one at a time from a shared counter, as in parallel.cpp,
+and doing the same job in the calling thread; the call returns when all of them
+have finished.  Each record is computed entirely in one thread, so the values are
+the same whatever the number of threads.  The records of a batch of 10j symbols
+are handed out in order of the time tenJPlan() predicts for them, largest first,
+so that a long symbol near the end of the input does not leave the other threads
+idle while it runs; each value still goes to the record's own place in the output.
+
+No C++ exception or call to exit() crosses the interface:  symbols that would make
+tenJ() exit are checked for first with tenJSetup(), negative spins and triads that
+are not admissible are caught before they reach theta(), tet() or sixJ(), and
+failures to allocate are returned as TENJ_NO_MEMORY.  Jobs catch their own
+exceptions, so a batch always waits for every thread to finish before returning.
+
+To build the libraries, compile every file of the package except the main
+programs, with this one, and collect the objects:
+
+	g++ -O2 -fPIC -fvisibility=hidden -pthread -c <library .cpp files> libtenj.cpp
+	g++ -shared -pthread -o libtenj.so *.o
+	ar rcs libtenj.a *.o
+
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+#include "spin.h"
+#include "tenj.h"
+
+struct tenj_context
+	{
+	int nThreads;						//	Including the caller's
+	std::vector<std::thread> workers;
+	std::mutex call;					//	Held for the whole of each call
+	std::mutex lock;					//	Guards the fields below
+	std::condition_variable started, finished;
+	const std::function<void()> *job;	//	The current job, owned by runJob()
+	long long generation;				//	Counts the jobs handed out
+	int running;						//	Workers still on the current job
+	bool quit;
+	};
+
+//	Each worker runs every job handed out, until it is told to quit
+
+static void worker(tenj_context *ctx)
+{
+long long seen=0;
+while (true)
+	{
+	const std::function<void()> *job;
+	{
+	std::unique_lock<std::mutex> lock(ctx->lock);
+	ctx->started.wait(lock,[&]{return ctx->quit || ctx->generation!=seen;});
+	if (ctx->quit) return;
+	seen=ctx->generation;
+	job=ctx->job;
+	}
+	(*job)();
+	std::lock_guard<std::mutex> lock(ctx->lock);
+	if (--ctx->running==0) ctx->finished.notify_one();
+	};
+}
+
+//	Run a job in every thread of the context, and wait for all of them; the job
+//	must not throw
+
+static void runJob(tenj_context *ctx, const std::function<void()> &job)
+{
+if (ctx->workers.empty())
+	{
+	job();
+	return;
+	};
+{
+std::lock_guard<std::mutex> lock(ctx->lock);
+ctx->job=&job;
+ctx->running=(int)ctx->workers.size();
+ctx->generation++;
+}
+ctx->started.notify_all();
+job();
+std::unique_lock<std::mutex> lock(ctx->lock);
+ctx->finished.wait(lock,[&]{return ctx->running==0;});
+ctx->job=NULL;
+}
+
+//	A 10j symbol, or NaN if it is too large for tenJ(); the faster routine is
+//	used for regular symbols
+
+static double evaluate(const int *twoJ)
+{
+int twoJ1[5], twoJ2[5];
+bool regular=true;
+for (int i=0;i<5;i++)
+	{
+	twoJ1[i]=twoJ[i];
+	twoJ2[i]=twoJ[5+i];
+	regular&=(twoJ1[i]==twoJ[0] && twoJ2[i]==twoJ[0]);
+	};
+TenJSetup s;
+if (!tenJSetup(twoJ1,twoJ2,&s)) return NAN;
+return regular ? tenJ(twoJ1[0]) : tenJ(twoJ1,twoJ2);
+}
+
+//	The time tenJPlan() predicts for a 10j symbol, or 0 if it is too large for
+//	tenJ() and so costs nothing
+
+static double cost(const int *twoJ)
+{
+int twoJ1[5], twoJ2[5];
+for (int i=0;i<5;i++)
+	{
+	twoJ1[i]=twoJ[i];
+	twoJ2[i]=twoJ[5+i];
+	};
+TenJPlan plan;
+tenJPlan(twoJ1,twoJ2,&plan);
+return plan.admissible ? plan.seconds : 0.0;
+}
+
+static bool nonNegative(const int *twoJ, long long n)
+{
+for (long long k=0;k<n;k++) if (twoJ[k]<0) return false;
+return true;
+}
+
+static bool triad(int a, int b, int c)
+{
+return (a+b+c)%2==0 && a<=b+c && b<=a+c && c<=a+b;
+}
+
+//	Contexts
+//	========
+
+int tenj_abi_version(void)
+{
+return TENJ_ABI_VERSION;
+}
+
+const char *tenj_status_string(int status)
+{
+switch (status)
+	{
+	case TENJ_OK:			return "success";
+	case TENJ_TOO_LARGE:	return "symbol too large for the coefficient matrices in tenJ.cpp";
+	case TENJ_INVALID:		return "null pointer, negative spin or negative count";
+	case TENJ_NO_MEMORY:	return "could not allocate storage or threads";
+	case TENJ_IO_ERROR:		return "could not reach the server";
+	default:				return "unknown status";
+	};
+}
+
+tenj_context *tenj_context_new(int n_threads)
+{
+if (n_threads<1) n_threads=(int)std::thread::hardware_concurrency();
+if (n_threads<1) n_threads=1;
+
+tenj_context *ctx=new(std::nothrow) tenj_context;
+if (ctx==NULL) return NULL;
+ctx->nThreads=n_threads;
+ctx->job=NULL;
+ctx->generation=0;
+ctx->running=0;
+ctx->quit=false;
+try
+	{
+	for (int t=1;t<n_threads;t++) ctx->workers.push_back(std::thread(worker,ctx));
+	}
+catch (...)
+	{
+	tenj_context_free(ctx);
+	return NULL;
+	};
+return ctx;
+}
+
+void tenj_context_free(tenj_context *ctx)
+{
+if (ctx==NULL) return;
+{
+std::lock_guard<std::mutex> lock(ctx->lock);
+ctx->quit=true;
+}
+ctx->started.notify_all();
+for (size_t t=0;t<ctx->workers.size();t++) ctx->workers[t].join();
+delete ctx;
+}
+
+int tenj_context_threads(const tenj_context *ctx)
+{
+return ctx==NULL ? 1 : ctx->nThreads;
+}
+
+//	Single values
+//	=============
+
+//	Negative spins, and failures to allocate, give NaN; triads that are not
+//	admissible give 0
+
+double tenj_theta(int a, int b, int c)
+{
+if (a<0 || b<0 || c<0) return NAN;
+if (!triad(a,b,c)) return 0.0;
+try {return theta(a,b,c);} catch (...) {return NAN;};
+}
+
+double tenj_tet(int a, int b, int c, int d, int e, int f)
+{
+int twoJ[6]={a,b,c,d,e,f};
+if (!nonNegative(twoJ,6)) return NAN;
+if (!(triad(a,b,f) && triad(b,c,e) && triad(c,d,f) && triad(a,d,e))) return 0.0;
+try {return tet(a,b,c,d,e,f);} catch (...) {return NAN;};
+}
+
+double tenj_sixj(int j1, int j2, int j3, int j4, int j5, int j6)
+{
+int twoJ[6]={j1,j2,j3,j4,j5,j6};
+if (!nonNegative(twoJ,6)) return NAN;
+try {return sixJ(j1,j2,j3,j4,j5,j6);} catch (...) {return NAN;};
+}
+
+//	The context is not needed for a single symbol, which is computed in the
+//	calling thread
+
+int tenj_tenj(tenj_context *, const int *two_j, double *value)
+{
+if (two_j==NULL || value==NULL || !nonNegative(two_j,10)) return TENJ_INVALID;
+try
+	{
+	*value=evaluate(two_j);
+	}
+catch (...)
+	{
+	*value=NAN;
+	return TENJ_NO_MEMORY;
+	};
+return *value!=*value ? TENJ_TOO_LARGE : TENJ_OK;
+}
+
+//	Batches
+//	=======
+
+int tenj_tenj_batch(tenj_context *ctx, long long n, const int *two_j, double *values)
+{
+if (ctx==NULL || n<0 || (n>0 && (two_j==NULL || values==NULL)) ||
+	!nonNegative(two_j,10*n)) return TENJ_INVALID;
+
+std::lock_guard<std::mutex> call(ctx->call);
+std::atomic<long long> next(0);
+std::atomic<bool> tooLarge(false), failed(false);
+try
+	{
+	//	The records, most expensive first, keeping the input order among equals
+
+	std::vector<double> costs(n);
+	std::vector<long long> order(n);
+	for (long long k=0;k<n;k++)
+		{
+		costs[k]=cost(two_j+10*k);
+		order[k]=k;
+		};
+	std::stable_sort(order.begin(),order.end(),
+		[&](long long a, long long b){return costs[a]>costs[b];});
+
+	runJob(ctx,[&]()
+		{
+		try
+			{
+			for (long long i=next++;i<n;i=next++)
+				{
+				long long k=order[i];
+				values[k]=evaluate(two_j+10*k);
+				if (values[k]!=values[k]) tooLarge=true;
+				};
+			}
+		catch (...)
+			{
+			failed=true;
+			};
+		});
+	}
+catch (...)
+	{
+	return TENJ_NO_MEMORY;			//	Sorting or making the job failed; nothing is running
+	};
+if (failed) return TENJ_NO_MEMORY;
+return tooLarge ? TENJ_TOO_LARGE : TENJ_OK;
+}
+
+int tenj_sixj_batch(tenj_context *ctx, long long n, const int *two_j, double *values)
+{
+if (ctx==NULL || n<0 || (n>0 && (two_j==NULL || values==NULL)) ||
+	!nonNegative(two_j,6*n)) return TENJ_INVALID;
+
+std::lock_guard<std::mutex> call(ctx->call);
+std::atomic<long long> next(0);
+std::atomic<bool> failed(false);
+try
+	{
+	runJob(ctx,[&]()
+		{
+		try
+			{
+			for (long long k=next++;k<n;k=next++)
+				{
+				const int *j=two_j+6*k;
+				values[k]=sixJ(j[0],j[1],j[2],j[3],j[4],j[5]);
+				};
+			}
+		catch (...)
+			{
+			failed=true;
+			};
+		});
+	}
+catch (...)
+	{
+	return TENJ_NO_MEMORY;			//	Making the job failed; nothing is running
+	};
+return failed ? TENJ_NO_MEMORY : TENJ_OK;
+}
@@ -0,0 +1,242 @@
+/*
+
+loadMain.cpp
+============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a main program that puts a 10jd server (serverMain.cpp) under
+load from several clients at once, and measures its throughput and latency.
+
+	10jload [-s socket] [-c clients] [-q queries] [-r records] [-p pool]
+		[-j maxTwoJ] [-d] [-v]
+
+It makes a pool of "pool" distinct records (default 2000):  thetas, tets and 6j
+symbols with 2j <= 3 maxTwoJ, and one in ten a 10j symbol with 2j <= maxTwoJ
+(default 8).  Each of "clients" threads (default 8) opens its own connection and
+sends "queries" queries (default 200) of "records" records each (default 16),
+drawn from the pool with a bias towards its start, so that clients often ask for
+the same values at the same time, as jobs scanning overlapping ranges do.
+
+It prints the records per second, the mean and 99th percentile latency of a query,
+and the server's counts of records answered from its table, coalesced and computed.
+With -d, there is no server:  each client computes its records itself, in a new
+thread with cold caches and nothing shared, as separate jobs would.  With -v, each
+value from the server is checked against one computed directly, and the exit
+status is 1 if any differ.
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+#include <string.h>
+#include "spin.h"
+#include "tenj.h"
+
+void usage()
+{
+printf("usage:\t10jload [-s socket] [-c clients] [-q queries] [-r records] [-p pool]\n"
+	"\t\t[-j maxTwoJ] [-d] [-v]\n");
+exit(2);
+}
+
+struct Record
+	{
+	int kind, twoJ[10];
+	};
+
+//	The value of a record, computed in this process
+
+static double direct(const Record &r)
+{
+const int *j=r.twoJ;
+double value;
+switch (r.kind)
+	{
+	case TENJ_THETA:	return tenj_theta(j[0],j[1],j[2]);
+	case TENJ_TET:		return tenj_tet(j[0],j[1],j[2],j[3],j[4],j[5]);
+	case TENJ_SIXJ:		return tenj_sixj(j[0],j[1],j[2],j[3],j[4],j[5]);
+	default:			tenj_tenj(NULL,j,&value); return value;
+	};
+}
+
+static bool triad(int a, int b, int c)
+{
+return (a+b+c)%2==0 && a<=b+c && b<=a+c && c<=a+b;
+}
+
+//	A random c <= maxTwoJ with (a,b,c) admissible
+
+static int thirdSpin(std::mt19937 &rng, int a, int b, int maxTwoJ)
+{
+int lo=a>b ? a-b : b-a, hi=a+b;
+if (hi>maxTwoJ) hi-=2*((hi-maxTwoJ+1)/2);
+return lo+2*(rng()%((hi-lo)/2+1));
+}
+
+//	A random record with admissible triads
+
+static Record randomRecord(std::mt19937 &rng, int maxTwoJ)
+{
+Record r;
+memset(&r,0,sizeof(r));
+int m=3*maxTwoJ, *j=r.twoJ;
+if (rng()%10==0)
+	{
+	r.kind=TENJ_TENJ;
+	while (true)
+		{
+		for (int i=0;i<10;i++) j[i]=rng()%(maxTwoJ+1);
+		TenJSetup s;
+		tenJSetup(j,j+5,&s);
+		bool ok=true;
+		for (int i=0;i<5;i++)
+			ok&=s.H[i]>=s.L[i] && (j[i]+j[5+i]+j[mod5(i-1)]+j[5+mod5(i-2)])%2==0;
+		if (ok) return r;
+		};
+	};
+r.kind=TENJ_THETA+rng()%3;
+j[0]=rng()%(m+1);
+j[1]=rng()%(m+1);
+if (r.kind==TENJ_THETA)
+	j[2]=thirdSpin(rng,j[0],j[1],m);
+else
+	{
+	//	Tet[a b e; c d f] has triads (a,b,f), (b,c,e), (c,d,f), (a,d,e); the 6j
+	//	symbol {j1 j2 j3; j4 j5 j6} has (j1,j2,j3), (j1,j5,j6), (j4,j2,j6), (j4,j5,j3)
+
+	int a=j[0], b=j[1], f=thirdSpin(rng,a,b,m), c, d, e;
+	do
+		{
+		d=rng()%(m+1);
+		e=thirdSpin(rng,a,d,m);
+		c=rng()%(m+1);
+		}
+	while (!triad(b,c,e) || !triad(c,d,f));
+	int tetJ[6]={a,b,c,d,e,f}, sixJ[6]={a,b,f,c,d,e};
+	memcpy(j,r.kind==TENJ_TET ? tetJ : sixJ,sizeof(tetJ));
+	};
+return r;
+}
+
+int main(int argc, char **argv)
+{
+const char *path=NULL;
+int nClients=8, nQueries=200, nRecords=16, poolSize=2000, maxTwoJ=8;
+bool noServer=false, verify=false;
+for (int a=1;a<argc;a++)
+	{
+	if (argv[a][0]!='-' || argv[a][2]!=0) usage();
+	char option=argv[a][1];
+	if (option=='d') {noServer=true; continue;};
+	if (option=='v') {verify=true; continue;};
+	if (++a>=argc) usage();
+	switch (option)
+		{
+		case 's': path=argv[a]; break;
+		case 'c': nClients=atoi(argv[a]); break;
+		case 'q': nQueries=atoi(argv[a]); break;
+		case 'r': nRecords=atoi(argv[a]); break;
+		case 'p': poolSize=atoi(argv[a]); break;
+		case 'j': maxTwoJ=atoi(argv[a]); break;
+		default: usage();
+		};
+	};
+if (nClients<1 || nQueries<1 || nRecords<1 || poolSize<1 || maxTwoJ<1) usage();
+
+std::mt19937 rng(1);
+std::vector<Record> pool(poolSize);
+for (int p=0;p<poolSize;p++) pool[p]=randomRecord(rng,maxTwoJ);
+
+std::vector<std::vector<double>> latencies(nClients);
+std::vector<int> failures(nClients,0), mismatches(nClients,0);
+
+auto client=[&](int c)
+	{
+	std::mt19937 crng(100+c);
+	std::uniform_real_distribution<double> u(0.0,1.0);
+	tenj_client *server=noServer ? NULL : tenj_client_connect(path);
+	if (!noServer && server==NULL)
+		{
+		failures[c]++;
+		return;
+		};
+	std::vector<int> kinds(nRecords), twoJ(10*nRecords);
+	std::vector<double> values(nRecords);
+	std::vector<const Record *> picked(nRecords);
+	for (int q=0;q<nQueries;q++)
+		{
+		for (int k=0;k<nRecords;k++)
+			{
+			double x=u(crng);
+			picked[k]=&pool[(int)(x*x*poolSize)];
+			kinds[k]=picked[k]->kind;
+			memcpy(&twoJ[10*k],picked[k]->twoJ,10*sizeof(int));
+			};
+		auto t0=std::chrono::steady_clock::now();
+		if (noServer)
+			for (int k=0;k<nRecords;k++) values[k]=direct(*picked[k]);
+		else if (tenj_client_query(server,nRecords,&kinds[0],&twoJ[0],&values[0])!=TENJ_OK)
+			{
+			failures[c]++;
+			break;
+			};
+		auto t1=std::chrono::steady_clock::now();
+		latencies[c].push_back(std::chrono::duration<double>(t1-t0).count());
+		if (verify && !noServer)
+			for (int k=0;k<nRecords;k++)
+				{
+				double v=direct(*picked[k]);
+				if (!(v==values[k] || (v!=v && values[k]!=values[k]))) mismatches[c]++;
+				};
+		};
+	tenj_client_close(server);
+	};
+
+auto t0=std::chrono::steady_clock::now();
+std::vector<std::thread> threads;
+for (int c=0;c<nClients;c++) threads.push_back(std::thread(client,c));
+for (int c=0;c<nClients;c++) threads[c].join();
+double seconds=std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+
+std::vector<double> all;
+int nFailed=0, nWrong=0;
+for (int c=0;c<nClients;c++)
+	{
+	all.insert(all.end(),latencies[c].begin(),latencies[c].end());
+	nFailed+=failures[c];
+	nWrong+=mismatches[c];
+	};
+if (nFailed>0) printf("%d clients could not reach the server\n",nFailed);
+if (all.empty()) return 1;
+std::sort(all.begin(),all.end());
+double mean=0.0;
+for (size_t i=0;i<all.size();i++) mean+=all[i];
+mean/=all.size();
+
+printf("%s: %d clients x %d queries x %d records in %.3f s:  %.0f records/s\n",
+	noServer ? "direct" : "server",nClients,nQueries,nRecords,seconds,
+	all.size()*(double)nRecords/seconds);
+printf("query latency:  mean %.3f ms, 99th percentile %.3f ms\n",
+	1e3*mean,1e3*all[(size_t)(0.99*(all.size()-1))]);
+
+if (!noServer)
+	{
+	tenj_client *server=tenj_client_connect(path);
+	int kinds[6]={0,0,0,0,0,0}, twoJ[60];
+	double counts[6];
+	memset(twoJ,0,sizeof(twoJ));
+	for (int i=0;i<6;i++) twoJ[10*i]=i;
+	if (server!=NULL && tenj_client_query(server,6,kinds,twoJ,counts)==TENJ_OK)
+		printf("server totals:  %.0f records, %.0f from the table, %.0f coalesced, "
+			"%.0f computed in %.0f batches, %.0f values kept\n",
+			counts[0],counts[1],counts[2],counts[3],counts[4],counts[5]);
+	tenj_client_close(server);
+	};
+if (verify && !noServer) printf("%d values differ from direct computation\n",nWrong);
+return nFailed>0 || nWrong>0 ? 1 : 0;
+}
@@ -0,0 +1,432 @@
+/*
+
+montecarlo.cpp
+==============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a Metropolis sampler for expectation values of observables in
+the DFKR model on a triangulated 4-manifold, over the spin foams with every
+2j <= maxTwoJ:
+
+	<O> = sum over F of O(F) Z(F) / sum over F of Z(F)
+
+	bool foamMonteCarlo(Triangulation *tri, int *startTwoJ, int maxTwoJ,
+		int nChains, int nThreads, unsigned long long seed, int burnIn,
+		int batchSweeps, int nBatches, int nObservables,
+		FoamObservable *observables, MonteCarloEstimate *estimates, bool report)
+
+Since 10j symbols can be negative, the chains sample foams with probability
+proportional to |Z(F)|, and each observable is estimated as <O s>/<s>, where s is
+the sign of Z(F); the mean sign is reported too, as a small mean sign makes every
+estimate noisy.
+
+There are two kinds of move, proposed equally often.  One picks a triangle at
+random and changes its 2j by 2 up or down.  The other picks an edge at random and
+changes 2j by 1, up or down independently, on every triangle around it; a tet
+containing one of those triangles contains the edge, and so exactly two of them,
+so the parity of every tet is kept.  Moves of the second kind connect the
+foams whose 2j have different parities:  on a manifold with H^2(M;Z_2)=0, such as
+S4, any two labellings that are admissible on every tet differ in parity by a sum
+of edge moves, while on other manifolds the chains keep to the classes in
+H^2(M;Z_2) of startTwoJ's parities.  Each move is undone by the same move with the
+opposite steps, which is proposed with the same probability, so the proposals are
+symmetric.  The ratio of amplitudes involves only the face
+factors of the changed triangles, the 4j factors of the tets around them and the
+10j symbols of the 4-simplices around them, taken from a Complex built from the
+triangulation by triangulationComplex(); the new 10j symbols come from
+tenJCached(), which all the chains share, and the current ones are kept with the
+chain.  A move to a spin outside 0..maxTwoJ, or to a foam whose amplitude is
+zero, is rejected.  On S4 with 2j <= 1 every one of the 1024 foams with nonzero
+amplitude can be reached from any other, and the estimates agree with exact sums
+over all foams (mean spin 0.387698 for 2j <= 1, 0.694407 for 2j <= 2).  A sweep
+is one proposed move per triangle.
+
+There are nChains independent chains, all starting from startTwoJ, each with its
+own random number stream seeded from (seed, chain number), so the results are
+the same for any number of threads.  After burnIn sweeps, the observables are
+measured after every sweep and summed over batches of batchSweeps sweeps.  The
+chains are advanced a batch at a time, nThreads at once; after each round the
+batches of all the chains so far are combined.  Treating the batch sums as
+independent, the error of the ratio <O s>/<s> comes from the usual first-order
+formula, and the integrated autocorrelation time of O s (in sweeps) from the
+variance of the batch means compared with that of single measurements:
+
+	tau = batchSweeps * var(batch means) / (2 var(single measurements))
+
+which is 0.5 for uncorrelated measurements; the error is only trustworthy if
+batchSweeps is several times tau.  If report is true, the estimates are printed
+after every round.  If a chain proposes a foam with a 10j symbol too large for
+tenJ(), the run is abandoned and foamMonteCarlo() returns false.
+
+foamMeanSpin() and foamMeanArea() are two observables:  the average over the
+triangles of j, and of sqrt(j(j+1)), the area in Planck units.
+
+*/
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <map>
+#include <random>
+#include <stdint.h>
+#include "spin.h"
+
+//	foamMeanSpin(), foamMeanArea()
+//	==============================
+
+double foamMeanSpin(Triangulation *tri, int *twoJ)
+{
+double sum=0.0;
+for (int f=0;f<tri->nTriangles;f++) sum+=twoJ[f]/2.0;
+return sum/tri->nTriangles;
+}
+
+double foamMeanArea(Triangulation *tri, int *twoJ)
+{
+double sum=0.0;
+for (int f=0;f<tri->nTriangles;f++) sum+=sqrt(twoJ[f]/2.0*(twoJ[f]/2.0+1.0));
+return sum/tri->nTriangles;
+}
+
+//	The triangles around each edge, in compressed sparse rows; a Complex lists the
+//	faces around each triangle, but not the triangles around an edge
+
+static void makeEdges(Triangulation *tri, std::vector<int> &edgeStart,
+	std::vector<int> &edgeTriangles)
+{
+std::map<std::pair<int,int>,std::vector<int> > edges;
+for (int f=0;f<tri->nTriangles;f++)
+	for (int i=0;i<3;i++)
+		{
+		int a=tri->triangleVertices[f][i], b=tri->triangleVertices[f][(i+1)%3];
+		edges[a<b ? std::make_pair(a,b) : std::make_pair(b,a)].push_back(f);
+		};
+edgeStart.assign(1,0);
+edgeTriangles.clear();
+for (std::map<std::pair<int,int>,std::vector<int> >::iterator it=edges.begin();it!=edges.end();it++)
+	{
+	edgeTriangles.insert(edgeTriangles.end(),it->second.begin(),it->second.end());
+	edgeStart.push_back((int)edgeTriangles.size());
+	};
+}
+
+//	One chain
+
+struct FoamChain
+	{
+	std::mt19937_64 rng;
+	std::vector<int> twoJ;
+	std::vector<TENJfloat> pentValue;	//	Current 10j symbol of each 4-simplex
+	std::vector<TENJfloat> newValue;	//	Proposed ones, for a single move
+	std::vector<int> tets, pents;		//	Tets and 4-simplices a move changes
+	std::vector<int> tetMark, pentMark;	//	Last move that listed each one
+	int mark;
+	int sign;							//	Sign of the current amplitude
+	bool tooLarge;						//	A 10j symbol was too large for tenJ()
+	long long nProposed, nAccepted;
+	std::vector<double> batchOS;		//	Sum over the batch of O*s, for each O
+	std::vector<double> sumSquares;		//	Sum over all measurements of (O*s)^2
+	double batchS;						//	Sum over the batch of s
+	};
+
+static TENJfloat pentTenJ(Triangulation *tri, int *twoJ, int p)
+{
+int *t=tri->pentTriangles[p], twoJ1[5], twoJ2[5];
+for (int i=0;i<5;i++)
+	{
+	twoJ1[i]=twoJ[t[i]];
+	twoJ2[i]=twoJ[t[5+i]];
+	};
+return tenJCached(twoJ1,twoJ2);
+}
+
+//	Propose changing 2j on the n triangles changed[] by step[], and accept or
+//	reject it
+
+static void move(Triangulation *tri, Complex *cx, FoamChain *c, int maxTwoJ, int n,
+	const int *changed, const int *step, std::uniform_real_distribution<double> &uniform)
+{
+c->nProposed++;
+for (int k=0;k<n;k++)
+	if (c->twoJ[changed[k]]+step[k]<0 || c->twoJ[changed[k]]+step[k]>maxTwoJ) return;
+
+//	The tets and 4-simplices around the changed triangles, each listed once
+
+int nTets=0, nPents=0;
+c->mark++;
+for (int k=0;k<n;k++)
+	{
+	int f=changed[k];
+	for (int i=cx->hingeFacetStart[f];i<cx->hingeFacetStart[f+1];i++)
+		if (c->tetMark[cx->hingeFacets[i]]!=c->mark)
+			{
+			c->tetMark[cx->hingeFacets[i]]=c->mark;
+			c->tets[nTets++]=cx->hingeFacets[i];
+			};
+	for (int i=cx->hingeTopStart[f];i<cx->hingeTopStart[f+1];i++)
+		if (c->pentMark[cx->hingeTops[i]]!=c->mark)
+			{
+			c->pentMark[cx->hingeTops[i]]=c->mark;
+			c->pents[nPents++]=cx->hingeTops[i];
+			};
+	};
+
+double delta=0.0;
+int *twoJ=&c->twoJ[0];
+for (int k=0;k<nTets;k++)
+	{
+	int *t=tri->tetTriangles[c->tets[k]];
+	delta+=log((double)fourJ(twoJ[t[0]],twoJ[t[1]],twoJ[t[2]],twoJ[t[3]]));
+	};
+for (int k=0;k<n;k++)
+	{
+	int old=twoJ[changed[k]];
+	twoJ[changed[k]]+=step[k];
+	delta+=2.0*log((twoJ[changed[k]]+1.0)/(old+1.0));
+	};
+
+bool accept=true;
+for (int k=0;k<nTets && accept;k++)
+	{
+	int *t=tri->tetTriangles[c->tets[k]];
+	int after=fourJ(twoJ[t[0]],twoJ[t[1]],twoJ[t[2]],twoJ[t[3]]);
+	if (after==0) accept=false;
+	else delta-=log((double)after);
+	};
+
+int sign=c->sign;
+TENJfloat *newValue=&c->newValue[0];
+for (int k=0;k<nPents && accept;k++)
+	{
+	int p=c->pents[k];
+	newValue[k]=pentTenJ(tri,twoJ,p);
+	if (newValue[k]==0.0 || isnan(newValue[k]))
+		{
+		c->tooLarge|=isnan(newValue[k]);
+		accept=false;
+		break;
+		};
+	delta+=log(fabs(newValue[k]/c->pentValue[p]));
+	if ((newValue[k]<0.0)!=(c->pentValue[p]<0.0)) sign=-sign;
+	};
+if (accept && delta<0.0 && uniform(c->rng)>=exp(delta)) accept=false;
+
+if (!accept)
+	{
+	for (int k=0;k<n;k++) twoJ[changed[k]]-=step[k];
+	return;
+	};
+for (int k=0;k<nPents;k++) c->pentValue[c->pents[k]]=newValue[k];
+c->sign=sign;
+c->nAccepted++;
+}
+
+//	Half the moves change 2j on one triangle by 2, the other half change 2j on
+//	every triangle around an edge by 1, each up or down at random
+
+static void sweep(Triangulation *tri, Complex *cx, std::vector<int> &edgeStart,
+	std::vector<int> &edgeTriangles, FoamChain *c, int maxTwoJ)
+{
+std::uniform_int_distribution<int> pick(0,tri->nTriangles-1);
+std::uniform_int_distribution<int> pickEdge(0,(int)edgeStart.size()-2);
+std::uniform_real_distribution<double> uniform(0.0,1.0);
+std::vector<int> step(tri->nTriangles);
+for (int n=0;n<tri->nTriangles;n++)
+	{
+	uint64_t bits=c->rng();
+	if (bits&1)
+		{
+		int f=pick(c->rng);
+		step[0]=(bits&2) ? 2 : -2;
+		move(tri,cx,c,maxTwoJ,1,&f,&step[0],uniform);
+		}
+	else
+		{
+		int e=pickEdge(c->rng), nE=edgeStart[e+1]-edgeStart[e];
+		for (int k=0;k<nE;k++) step[k]=(c->rng()&1) ? 1 : -1;
+		move(tri,cx,c,maxTwoJ,nE,&edgeTriangles[edgeStart[e]],&step[0],uniform);
+		};
+	};
+}
+
+//	Combine the batches so far into estimates
+
+static void combine(std::vector<std::vector<double> > &os, std::vector<double> &s,
+	std::vector<double> &sumSquares, long long nMeasured, int batchSweeps,
+	int nObservables, MonteCarloEstimate *estimates, double &meanSign)
+{
+int n=(int)s.size();
+double totalS=0.0;
+for (int i=0;i<n;i++) totalS+=s[i];
+meanSign=totalS/((double)n*batchSweeps);
+for (int o=0;o<nObservables;o++)
+	{
+	double totalOS=0.0;
+	for (int i=0;i<n;i++) totalOS+=os[i][o];
+	double r=totalOS/totalS, var=0.0, varBatch=0.0, mOS=totalOS/((double)n*batchSweeps);
+	for (int i=0;i<n;i++)
+		{
+		double d=os[i][o]-r*s[i], b=os[i][o]/batchSweeps-mOS;
+		var+=d*d;
+		varBatch+=b*b;
+		};
+	estimates[o].mean=r;
+	estimates[o].error=n>1 ? sqrt(var*n/(n-1))/fabs(totalS) : INFINITY;
+	double varSingle=sumSquares[o]/nMeasured-mOS*mOS;
+	estimates[o].tau=n>1 && varSingle>0.0 ? batchSweeps*(varBatch/(n-1))/(2.0*varSingle) : 0.0;
+	};
+}
+
+//	foamMonteCarlo()
+//	================
+
+bool foamMonteCarlo(Triangulation *tri, int *startTwoJ, int maxTwoJ, int nChains,
+	int nThreads, unsigned long long seed, int burnIn, int batchSweeps, int nBatches,
+	int nObservables, FoamObservable *observables, MonteCarloEstimate *estimates,
+	bool report)
+{
+int sign;
+if (isnan(dfkrLogAmplitude(tri,startTwoJ,sign)))
+	{
+	printf("A 10j symbol of the starting spin foam needs matrices larger than maxC=%d\n",maxC);
+	return false;
+	};
+if (sign==0)
+	{
+	printf("The starting spin foam has zero amplitude\n");
+	return false;
+	};
+for (int f=0;f<tri->nTriangles;f++)
+	if (startTwoJ[f]<0 || startTwoJ[f]>maxTwoJ)
+		{
+		printf("The starting spins must have 0 <= 2j <= %d\n",maxTwoJ);
+		return false;
+		};
+if (nChains<1 || batchSweeps<1 || nBatches<1)
+	{
+	printf("Need at least one chain, one batch and one sweep per batch\n");
+	return false;
+	};
+if (nThreads<1) nThreads=1;
+
+Complex cx;
+if (!triangulationComplex(tri,&cx)) return false;
+std::vector<int> edgeStart, edgeTriangles;
+makeEdges(tri,edgeStart,edgeTriangles);
+
+std::vector<FoamChain> chains(nChains);
+for (int c=0;c<nChains;c++)
+	{
+	FoamChain &ch=chains[c];
+	std::seed_seq seq{(unsigned)(seed>>32),(unsigned)seed,(unsigned)c};
+	ch.rng.seed(seq);
+	ch.twoJ.assign(startTwoJ,startTwoJ+tri->nTriangles);
+	ch.pentValue.resize(tri->nPent);
+	ch.newValue.resize(tri->nPent);
+	ch.tets.resize(tri->nTets);
+	ch.pents.resize(tri->nPent);
+	ch.tetMark.assign(tri->nTets,0);
+	ch.pentMark.assign(tri->nPent,0);
+	ch.mark=0;
+	ch.sign=1;
+	ch.tooLarge=false;
+	for (int p=0;p<tri->nPent;p++)
+		{
+		ch.pentValue[p]=pentTenJ(tri,startTwoJ,p);
+		if (ch.pentValue[p]<0.0) ch.sign=-ch.sign;
+		};
+	ch.nProposed=ch.nAccepted=0;
+	ch.batchOS.assign(nObservables,0.0);
+	ch.sumSquares.assign(nObservables,0.0);
+	};
+
+//	Advance every chain by a number of sweeps, measuring if asked, with the
+//	chains handed out to the threads from a counter
+
+auto advance=[&](int nSweeps, bool measure)
+	{
+	std::atomic<int> next(0);
+	auto work=[&]()
+		{
+		for (int c=next++;c<nChains;c=next++)
+			{
+			FoamChain &ch=chains[c];
+			ch.batchS=0.0;
+			for (int o=0;o<nObservables;o++) ch.batchOS[o]=0.0;
+			for (int n=0;n<nSweeps && !ch.tooLarge;n++)
+				{
+				sweep(tri,&cx,edgeStart,edgeTriangles,&ch,maxTwoJ);
+				if (!measure) continue;
+				ch.batchS+=ch.sign;
+				for (int o=0;o<nObservables;o++)
+					{
+					double v=ch.sign*observables[o].value(tri,&ch.twoJ[0]);
+					ch.batchOS[o]+=v;
+					ch.sumSquares[o]+=v*v;
+					};
+				};
+			};
+		};
+	std::vector<std::thread> threads;
+	for (int t=1;t<nThreads;t++) threads.push_back(std::thread(work));
+	work();
+	for (int t=1;t<nThreads;t++) threads[t-1].join();
+	for (int c=0;c<nChains;c++)
+		if (chains[c].tooLarge)
+			{
+			printf("A chain reached a 10j symbol that needs matrices larger than maxC=%d\n",maxC);
+			return false;
+			};
+	return true;
+	};
+
+if (!advance(burnIn,false))
+	{
+	freeComplex(&cx);
+	return false;
+	};
+
+std::vector<std::vector<double> > os;
+std::vector<double> s, sumSquares(nObservables);
+long long nMeasured=0;
+double meanSign=0.0;
+if (report)
+	{
+	printf("%8s","sweeps");
+	for (int o=0;o<nObservables;o++) printf("   %-34s",observables[o].name);
+	printf(" %10s %10s\n","mean sign","accepted");
+	};
+for (int b=0;b<nBatches;b++)
+	{
+	if (!advance(batchSweeps,true))
+		{
+		freeComplex(&cx);
+		return false;
+		};
+	long long proposed=0, accepted=0;
+	for (int o=0;o<nObservables;o++) sumSquares[o]=0.0;
+	for (int c=0;c<nChains;c++)
+		{
+		os.push_back(chains[c].batchOS);
+		s.push_back(chains[c].batchS);
+		for (int o=0;o<nObservables;o++) sumSquares[o]+=chains[c].sumSquares[o];
+		proposed+=chains[c].nProposed;
+		accepted+=chains[c].nAccepted;
+		};
+	nMeasured+=(long long)nChains*batchSweeps;
+	combine(os,s,sumSquares,nMeasured,batchSweeps,nObservables,estimates,meanSign);
+	if (report)
+		{
+		printf("%8d",(b+1)*batchSweeps);
+		for (int o=0;o<nObservables;o++)
+			printf("   %11.6f +- %-9.2g tau %5.1f",estimates[o].mean,estimates[o].error,
+				estimates[o].tau);
+		printf(" %10.4f %9.1f%%\n",meanSign,100.0*accepted/proposed);
+		fflush(stdout);
+		};
+	};
+freeComplex(&cx);
+return true;
+}
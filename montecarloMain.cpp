@@ -0,0 +1,60 @@
+/*
+
+montecarloMain.cpp
+==================
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a main program that estimates the mean spin and mean area of
+spin foams in the DFKR model by foamMonteCarlo().
+
+	10jmc <triangulation> <maxTwoJ> <startTwoJ> [chains [batches [batchSweeps [seed]]]]
+
+The triangulation is either S4, for the boundary of a 5-simplex, or the name of a
+file listing the five vertex labels of each 4-simplex, one 4-simplex per line, as
+for 10jfoam.  Every chain starts with 2j = startTwoJ on every triangle, and moves
+between foams of either parity.  The defaults are 8
+chains, 20 batches of 1000 sweeps and seed 1; the burn-in is one batch, and there
+is one thread for each processor.
+
+*/
+
+#include <thread>
+#include <vector>
+#include "spin.h"
+
+void usage()
+{
+printf("usage:\t10jmc <S4 | file> <maxTwoJ> <startTwoJ> [chains [batches [batchSweeps [seed]]]]\n");
+exit(2);
+}
+
+int main(int argc, char **argv)
+{
+if (argc<4 || argc>8) usage();
+Triangulation tri;
+if (!readTriangulation(argv[1],&tri)) return 1;
+printf("%d 4-simplices, %d tetrahedra, %d triangles\n",tri.nPent,tri.nTets,tri.nTriangles);
+
+int maxTwoJ=atoi(argv[2]), startTwoJ=atoi(argv[3]);
+int nChains=argc>4 ? atoi(argv[4]) : 8;
+int nBatches=argc>5 ? atoi(argv[5]) : 20;
+int batchSweeps=argc>6 ? atoi(argv[6]) : 1000;
+unsigned long long seed=argc>7 ? strtoull(argv[7],NULL,10) : 1;
+int nThreads=(int)std::thread::hardware_concurrency();
+
+std::vector<int> start(tri.nTriangles,startTwoJ);
+FoamObservable observables[2]={{"mean spin",foamMeanSpin},{"mean area",foamMeanArea}};
+MonteCarloEstimate estimates[2];
+time_t t0=time(NULL);
+if (!foamMonteCarlo(&tri,&start[0],maxTwoJ,nChains,nThreads,seed,batchSweeps,
+	batchSweeps,nBatches,2,observables,estimates,true)) return 1;
+
+long long entries, hits, misses;
+tenJCacheInfo(entries,hits,misses);
+printf("%lld distinct 10j symbols, %.2f%% of lookups from the cache, %ld seconds\n",
+	entries,hits+misses>0 ? 100.0*hits/(hits+misses) : 0.0,(long)(time(NULL)-t0));
+freeTriangulation(&tri);
+return 0;
+}
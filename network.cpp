@@ -0,0 +1,564 @@
+/*
+
+network.cpp
+===========
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a routine that evaluates any closed trivalent spin network, in
+the recoupling theory of Kauffman and Lins with A = -1 (the conventions of theta()
+and tet()), by reducing it with recoupling moves.
+
+	TETfloat spinNetwork(int nVertices, const int *vertexEdges, const int *twoJ,
+		SpinNetworkCache *cache, SpinNetworkInfo *info)
+
+The network has nVertices vertices, and vertexEdges[3*v], [3*v+1], [3*v+2] are
+the edges at vertex v, in anticlockwise order; every edge number from 0 to the
+largest must appear exactly twice (twice at one vertex for a loop), and twoJ[e]
+is double the spin on edge e.  At A = -1 a crossing can be changed freely and a
+curl costs nothing, so the value depends only on the graph and the cyclic order
+at each vertex, which is the order in which its edges leave it in any drawing.
+Reversing the order at a vertex with spins a, b, c multiplies the value by the
+twist factor
+
+	lambda(a,b;c) = (-1)^((a+b-c)/2) (-1)^((a(a+2)+b(b+2)-c(c+2))/2)
+
+which is the same whichever two of the three edges are swapped.  The theta net
+is two vertices with orders (a,c,b) and (a,b,c); the tet of tet() is as drawn
+there, with every vertex anticlockwise in the plane.
+
+The network is first simplified by moves that do not need a sum:  an edge with
+spin 0 is removed, joining the other two edges at each end; a loop at a vertex
+gives zero (its third edge would have spin 0 and be removed first); two vertices
+joined by two edges b, c, with third edges a and d, are replaced by a single edge
+a times theta(a,b,c)/Delta_a if d = a, and zero otherwise; and a triangle is
+removed by a recoupling move with only one nonzero term, which leaves a bubble.
+Circles left with no vertices give Delta_a = (-1)^a (a+1) each.  Once none of
+these apply, the network is split into connected pieces, which are evaluated
+separately.
+
+A connected piece with no cycles shorter than four is reduced by a recoupling
+(F) move on one edge e of a shortest cycle:
+
+	a\     /d              a\   /d
+	  u-e-v     = sum_f  F    f|          F = Tet[a b e] Delta_f / (theta(a,d,f) theta(b,c,f))
+	b/     \c              b/   \c                  [c d f]
+
+taking the edges a and d to be the cycle's edges at u and v, so that the cycle
+loses an edge; the vertices are twisted first, if their orders do not match the
+picture.  Among all the edges on shortest cycles, the one with the fewest values
+of f is chosen, to keep the sums narrow.  Each term is a smaller problem of the
+same kind.
+
+Every connected piece that needs a sum is memoised, by a canonical code for the
+graph with its spins and cyclic orders:  starting from each end of each edge, in
+both orientations, the vertices are numbered in the order that a breadth-first
+walk meets them, taking the edges at each vertex in cyclic order from the one it
+was entered by, and the smallest code of spins and neighbours over all starts is
+kept.  Mirror images have the same value, since A = 1/A.  The cache can be kept
+between calls, with newSpinNetworkCache(), or be NULL, for one used by a single
+call.  If info is not NULL, it gets the number of F moves, the number of terms
+in their sums, the number of pieces found in the cache, and the deepest nesting
+of sums.
+
+Reference:	L. Kauffman and S. Lins, Temperley-Lieb Recoupling Theory and
+			invariants of 3-Manifolds, Princeton University Press,
+			Princeton,  1994.
+
+*/
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "spin.h"
+
+struct SpinNetworkCache
+	{
+	std::unordered_map<std::string,TETfloat> values;
+	};
+
+//	A network as the ends of its edges ("darts"):  the darts of vertex v are 3v,
+//	3v+1, 3v+2 in anticlockwise order, and partner[] pairs up the two ends of
+//	each edge
+
+struct Net
+	{
+	std::vector<int> partner, label;
+	std::vector<char> alive;
+	};
+
+struct NetworkRun
+	{
+	SpinNetworkCache *cache;
+	SpinNetworkInfo info;
+	};
+
+static inline int nextDart(int d)
+{
+return d%3==2 ? d-2 : d+1;
+}
+
+static bool triad(int a, int b, int c)
+{
+return (a+b+c)%2==0 && a<=b+c && b<=a+c && c<=a+b;
+}
+
+static TETfloat delta(int a)
+{
+return a%2==0 ? a+1 : -(a+1);
+}
+
+//	The factor for reversing the cyclic order at a vertex
+
+static TETfloat twist(int a, int b, int c)
+{
+int n=(a+b-c)/2+(a*(a+2)+b*(b+2)-c*(c+2))/2;
+return n%2==0 ? 1.0 : -1.0;
+}
+
+//	Reverse the cyclic order at the vertex of dart keep, by swapping its other two
+//	darts, and return the factor that this costs
+
+static TETfloat flip(Net &n, int keep)
+{
+int x=nextDart(keep), y=nextDart(x), px=n.partner[x], py=n.partner[y];
+TETfloat factor=twist(n.label[x],n.label[y],n.label[keep]);
+int lx=n.label[x];
+n.label[x]=n.label[y];
+n.label[y]=lx;
+if (px==y) return factor;
+n.partner[x]=py;
+n.partner[py]=x;
+n.partner[y]=px;
+n.partner[px]=y;
+return factor;
+}
+
+//	Remove vertex v, joining the far ends of its darts x and y, and return the
+//	factor for a circle if they were the two ends of one edge
+
+static TETfloat join(Net &n, int x, int y)
+{
+int px=n.partner[x], py=n.partner[y];
+if (px==y) return delta(n.label[x]);
+n.partner[px]=py;
+n.partner[py]=px;
+return 1.0;
+}
+
+//	Apply an F move to the edge at dart eu, taking its dart p at u and q at v to
+//	the same new vertex, with spin f on the new edge; return the coefficient
+
+static TETfloat fMove(Net &n, int eu, int p, int q, int f)
+{
+int u=eu/3, ev=n.partner[eu], v=ev/3;
+TETfloat factor=1.0;
+
+//	Twist so that u has (e, p, p') and v has (e, q', q) in anticlockwise order
+
+if (nextDart(eu)!=p)
+	{
+	factor*=flip(n,eu);
+	p=nextDart(eu);
+	};
+ev=n.partner[eu];
+if (nextDart(nextDart(ev))!=q)
+	{
+	factor*=flip(n,ev);
+	q=nextDart(nextDart(ev));
+	};
+int pp=nextDart(p), qq=nextDart(ev);
+int e=n.label[eu], a=n.label[p], b=n.label[pp], c=n.label[qq], d=n.label[q];
+
+//	The new vertices are u = (f, d, a) and v = (f, b, c); map the old darts of u
+//	and v to their new places
+
+int oldDart[6]={eu,q,p,ev,pp,qq}, newDart[6]={3*u,3*u+1,3*u+2,3*v,3*v+1,3*v+2};
+int newLabel[6]={f,d,a,f,b,c}, oldPartner[6];
+for (int k=0;k<6;k++) oldPartner[k]=n.partner[oldDart[k]];
+int map[6];
+for (int k=0;k<6;k++)
+	{
+	map[k]=oldPartner[k];
+	for (int i=0;i<6;i++)
+		if (oldDart[i]==oldPartner[k])
+			{
+			map[k]=newDart[i];
+			break;
+			};
+	};
+for (int k=0;k<6;k++)
+	{
+	n.partner[newDart[k]]=map[k];
+	n.label[newDart[k]]=newLabel[k];
+	n.partner[map[k]]=newDart[k];
+	};
+n.partner[3*u]=3*v;
+n.partner[3*v]=3*u;
+
+return factor*tetOnThetas(a,b,c,d,f,e,a,d,f,b,c,f)*delta(f);
+}
+
+//	Apply the moves that need no sum until none is left; return the product of
+//	their factors, which is zero if the network vanishes
+
+static TETfloat simplify(Net &n)
+{
+TETfloat factor=1.0;
+int nV=(int)n.alive.size();
+bool changed=true;
+while (changed && factor!=0.0)
+	{
+	changed=false;
+	for (int v=0;v<nV && factor!=0.0;v++)
+		{
+		if (!n.alive[v]) continue;
+
+		//	An edge with spin 0
+
+		int z=-1;
+		for (int k=0;k<3;k++) if (n.label[3*v+k]==0) z=3*v+k;
+		if (z>=0)
+			{
+			int pz=n.partner[z], w=pz/3;
+			int x=nextDart(z), y=nextDart(x);
+			if (n.label[x]!=n.label[y]) {factor=0.0; break;};
+			n.alive[v]=0;
+			if (w==v)
+				{
+				//	A loop of spin 0: the third edge has spin 0 too, and is now
+				//	dangling at its other end
+
+				int t=(x==pz) ? y : x;
+				int pt=n.partner[t], wt=pt/3;
+				int xt=nextDart(pt), yt=nextDart(xt);
+				if (n.label[xt]!=n.label[yt]) {factor=0.0; break;};
+				n.alive[wt]=0;
+				factor*=join(n,xt,yt);
+				}
+			else
+				{
+				factor*=join(n,x,y);
+				int xw=nextDart(pz), yw=nextDart(xw);
+				if (n.label[xw]!=n.label[yw]) {factor=0.0; break;};
+				n.alive[w]=0;
+				factor*=join(n,xw,yw);
+				};
+			changed=true;
+			continue;
+			};
+
+		//	A loop at the vertex, whose third edge is not 0
+
+		bool loop=false;
+		for (int k=0;k<3;k++) if (n.partner[3*v+k]/3==v) loop=true;
+		if (loop) {factor=0.0; break;};
+
+		//	Two or three edges to the same vertex
+
+		int nb[3];
+		for (int k=0;k<3;k++) nb[k]=n.partner[3*v+k]/3;
+		int a=-1;
+		if (nb[0]==nb[1]) a=3*v+2;
+		else if (nb[1]==nb[2]) a=3*v;
+		else if (nb[0]==nb[2]) a=3*v+1;
+		if (a>=0)
+			{
+			int c=nextDart(a), b=nextDart(c), w=n.partner[c]/3;
+			int pa=n.partner[a], d=-1;
+			bool theta3=pa/3==w;
+			for (int k=0;k<3;k++)
+				if (3*w+k!=n.partner[b] && 3*w+k!=n.partner[c]) d=3*w+k;
+			int la=n.label[a], ld=n.label[d], lb=n.label[b], lc=n.label[c];
+			if (la!=ld) {factor=0.0; break;};
+			if (nextDart(d)!=n.partner[b]) factor*=twist(lb,lc,ld);
+			factor*=theta(la,lb,lc);
+			n.alive[v]=0;
+			n.alive[w]=0;
+			if (!theta3)
+				{
+				factor/=delta(la);
+				int pd=n.partner[d];
+				n.partner[pa]=pd;
+				n.partner[pd]=pa;
+				};
+			changed=true;
+			continue;
+			};
+
+		//	A triangle:  an F move on the edge from v to one neighbour, pairing the
+		//	edges to a neighbour of both, has only the term where f is the spin on
+		//	that neighbour's third edge
+
+		for (int k=0;k<3 && !changed;k++)
+			{
+			int eu=3*v+k, ev=n.partner[eu], u2=ev/3;
+			for (int i=1;i<3 && !changed;i++)
+				{
+				int p=3*v+(k+i)%3, w=n.partner[p]/3;
+				for (int m=0;m<3;m++)
+					{
+					int q=3*u2+m;
+					if (q==ev || n.partner[q]/3!=w) continue;
+					int r=-1;
+					for (int s=0;s<3;s++)
+						if (3*w+s!=n.partner[p] && 3*w+s!=n.partner[q]) r=3*w+s;
+					int f=n.label[r];
+					int a=n.label[p], d=n.label[q];
+					int b=n.label[3*v+(k+3-i)%3], c=-1;
+					for (int s=0;s<3;s++) if (3*u2+s!=ev && 3*u2+s!=q) c=n.label[3*u2+s];
+					if (!triad(a,d,f) || !triad(b,c,f)) {factor=0.0; changed=true; break;};
+					factor*=fMove(n,eu,p,q,f);
+					changed=true;
+					break;
+					};
+				};
+			};
+		};
+	};
+return factor;
+}
+
+//	The connected pieces of the live part of n, each renumbered from 0
+
+static void pieces(Net &n, std::vector<Net> &out)
+{
+int nV=(int)n.alive.size();
+std::vector<int> piece(nV,-1), number(nV);
+out.clear();
+for (int s=0;s<nV;s++)
+	{
+	if (!n.alive[s] || piece[s]>=0) continue;
+	std::vector<int> vertices(1,s);
+	piece[s]=(int)out.size();
+	for (size_t i=0;i<vertices.size();i++)
+		for (int k=0;k<3;k++)
+			{
+			int w=n.partner[3*vertices[i]+k]/3;
+			if (piece[w]<0)
+				{
+				piece[w]=piece[s];
+				vertices.push_back(w);
+				};
+			};
+	Net p;
+	int m=(int)vertices.size();
+	for (int i=0;i<m;i++) number[vertices[i]]=i;
+	p.partner.resize(3*m);
+	p.label.resize(3*m);
+	p.alive.assign(m,1);
+	for (int i=0;i<m;i++)
+		for (int k=0;k<3;k++)
+			{
+			int d=n.partner[3*vertices[i]+k];
+			p.partner[3*i+k]=3*number[d/3]+d%3;
+			p.label[3*i+k]=n.label[3*vertices[i]+k];
+			};
+	out.push_back(p);
+	};
+}
+
+//	The canonical code of a connected network with every vertex alive
+
+static std::string canonicalCode(Net &n)
+{
+int nD=(int)n.partner.size(), nV=nD/3;
+std::vector<int> code, best, number(nV), entry(nV), order;
+for (int start=0;start<nD;start++)
+for (int mirror=0;mirror<2;mirror++)
+	{
+	code.clear();
+	order.clear();
+	for (int v=0;v<nV;v++) number[v]=-1;
+	number[start/3]=0;
+	entry[start/3]=start;
+	order.push_back(start/3);
+	int state=best.empty() ? -1 : 0;		//	-1 once the code is below best
+	for (size_t i=0;i<order.size() && state<=0;i++)
+		{
+		int v=order[i], d=entry[v];
+		for (int k=0;k<3 && state<=0;k++)
+			{
+			int pd=n.partner[d], w=pd/3;
+			if (number[w]<0)
+				{
+				number[w]=(int)order.size();
+				entry[w]=pd;
+				order.push_back(w);
+				};
+			int pos=0;
+			for (int e=entry[w];e!=pd;e=mirror ? (e%3==0 ? e+2 : e-1) : nextDart(e)) pos++;
+			code.push_back(n.label[d]);
+			code.push_back(3*number[w]+pos);
+			for (size_t c=code.size()-2;c<code.size() && state==0;c++)
+				if (code[c]!=best[c]) state=code[c]<best[c] ? -1 : 1;
+			d=mirror ? (d%3==0 ? d+2 : d-1) : nextDart(d);
+			};
+		};
+	if (state<0) best=code;
+	};
+return std::string((const char *)&best[0],best.size()*sizeof(int));
+}
+
+static TETfloat evaluate(NetworkRun &run, Net &n, int depth);
+
+//	A connected network with none of the moves in simplify() left:  an F move on
+//	an edge of a shortest cycle, with the fewest values of f
+
+static TETfloat evaluatePiece(NetworkRun &run, Net &n, int depth)
+{
+std::string key=canonicalCode(n);
+auto found=run.cache->values.find(key);
+if (found!=run.cache->values.end())
+	{
+	run.info.hits++;
+	return found->second;
+	};
+
+int nD=(int)n.partner.size(), nV=nD/3;
+int bestE=-1, bestP=-1, bestQ=-1, bestLength=nV+1, bestCount=0, bestLo=0;
+std::vector<int> dist(nV), via(nV);
+for (int eu=0;eu<nD;eu++)
+	{
+	int ev=n.partner[eu], u=eu/3, v=ev/3;
+	if (ev<eu) continue;
+
+	//	Breadth-first search from v to u without the edge, remembering the dart by
+	//	which each vertex was first reached
+
+	for (int w=0;w<nV;w++) dist[w]=-1;
+	std::vector<int> queue(1,v);
+	dist[v]=0;
+	via[v]=-1;
+	for (size_t i=0;i<queue.size() && dist[u]<0;i++)
+		{
+		int w=queue[i];
+		for (int k=0;k<3;k++)
+			{
+			int d=3*w+k, pd=n.partner[d];
+			if (d==ev || d==eu) continue;
+			int x=pd/3;
+			if (dist[x]>=0) continue;
+			dist[x]=dist[w]+1;
+			via[x]=pd;
+			queue.push_back(x);
+			};
+		};
+	if (dist[u]<0 || dist[u]+1>bestLength) continue;
+
+	//	The path's darts at u and v
+
+	int p=via[u], x=u;
+	while (n.partner[via[x]]/3!=v) x=n.partner[via[x]]/3;
+	int q=n.partner[via[x]];
+
+	int a=n.label[p], d=n.label[q], b=-1, c=-1;
+	for (int k=0;k<3;k++)
+		{
+		if (3*u+k!=eu && 3*u+k!=p) b=n.label[3*u+k];
+		if (3*v+k!=ev && 3*v+k!=q) c=n.label[3*v+k];
+		};
+	int lo=max(abs(a-d),abs(b-c)), hi=min(a+d,b+c);
+	int count=hi>=lo ? (hi-lo)/2+1 : 0;
+	if (dist[u]+1<bestLength || count<bestCount)
+		{
+		bestLength=dist[u]+1;
+		bestE=eu;
+		bestP=p;
+		bestQ=q;
+		bestCount=count;
+		bestLo=lo;
+		};
+	};
+
+TETfloat sum=0.0;
+if (bestE>=0)
+	{
+	run.info.moves++;
+	if (depth+1>run.info.depth) run.info.depth=depth+1;
+	for (int i=0;i<bestCount;i++)
+		{
+		Net m=n;
+		TETfloat coefficient=fMove(m,bestE,bestP,bestQ,bestLo+2*i);
+		run.info.terms++;
+		if (coefficient!=0.0) sum+=coefficient*evaluate(run,m,depth+1);
+		};
+	};
+run.cache->values[key]=sum;
+return sum;
+}
+
+static TETfloat evaluate(NetworkRun &run, Net &n, int depth)
+{
+TETfloat value=simplify(n);
+if (value==0.0) return 0.0;
+std::vector<Net> parts;
+pieces(n,parts);
+for (size_t i=0;i<parts.size() && value!=0.0;i++)
+	value*=evaluatePiece(run,parts[i],depth);
+return value;
+}
+
+//	newSpinNetworkCache(), deleteSpinNetworkCache()
+//	===============================================
+
+SpinNetworkCache *newSpinNetworkCache()
+{
+return new SpinNetworkCache;
+}
+
+void deleteSpinNetworkCache(SpinNetworkCache *cache)
+{
+delete cache;
+}
+
+//	spinNetwork()
+//	=============
+
+TETfloat spinNetwork(int nVertices, const int *vertexEdges, const int *twoJ,
+	SpinNetworkCache *cache, SpinNetworkInfo *info)
+{
+//	Pair up the ends of each edge
+
+int nEdges=0;
+for (int d=0;d<3*nVertices;d++) if (vertexEdges[d]+1>nEdges) nEdges=vertexEdges[d]+1;
+std::vector<int> first(nEdges,-1), count(nEdges,0);
+Net n;
+n.partner.resize(3*nVertices);
+n.label.resize(3*nVertices);
+n.alive.assign(nVertices,1);
+for (int d=0;d<3*nVertices;d++)
+	{
+	int e=vertexEdges[d];
+	if (e<0 || count[e]>=2 || twoJ[e]<0)
+		{
+		printf("spinNetwork() was given edge %d at vertex %d\n",e,d/3);
+		return 0.0;
+		};
+	n.label[d]=twoJ[e];
+	if (count[e]++==0) first[e]=d;
+	else
+		{
+		n.partner[d]=first[e];
+		n.partner[first[e]]=d;
+		};
+	};
+for (int e=0;e<nEdges;e++)
+	if (count[e]!=2)
+		{
+		printf("spinNetwork(): edge %d has %d ends\n",e,count[e]);
+		return 0.0;
+		};
+for (int v=0;v<nVertices;v++)
+	if (!triad(n.label[3*v],n.label[3*v+1],n.label[3*v+2])) return 0.0;
+
+NetworkRun run;
+run.cache=cache!=NULL ? cache : new SpinNetworkCache;
+run.info.moves=run.info.terms=run.info.hits=0;
+run.info.depth=0;
+TETfloat value=evaluate(run,n,0);
+if (cache==NULL) delete run.cache;
+if (info!=NULL) *info=run.info;
+return value;
+}
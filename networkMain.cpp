@@ -0,0 +1,251 @@
+/*
+
+networkMain.cpp
+===============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a main program that evaluates trivalent spin networks with
+spinNetwork().
+
+	10jnet <file>
+
+reads a network from a file:  the number of vertices and the number of edges,
+then three edge numbers for each vertex, in anticlockwise order, then double the
+spin on each edge, all separated by white space; it prints the value, and the
+number of F moves, terms and cache hits it took.
+
+	10jnet -c <twoJMax>
+
+checks spinNetwork() against the routines for fixed networks, with spins up to
+twoJMax:  every tet, with each subset of its vertices reversed, against tet()
+times the twist factors; the utility graph K_3,3 against the 9j symbol, as a sum
+of three 6j symbols, allowing for the normalisation of the vertices; and the
+regular 10j symbol, and a random one for each 2j, against tenJ(), by expanding
+each 4-valent vertex of the 4-simplex network into two trivalent ones joined by
+an edge c, as in the Barrett-Crane intertwiner
+
+	10j = sum over c_0..c_4 of prod_i Delta_c_i / (theta(.,.,c_i) theta(.,.,c_i)) N(c)^2
+
+where N(c) is the decagonal network of Christensen and Egan.  One cache is kept
+for all the decagons.  The exit status is 1 if any of the checks fail.
+
+*/
+
+#include <random>
+#include <vector>
+#include <string.h>
+#include "spin.h"
+
+void usage()
+{
+printf("usage:\t10jnet <file>\n");
+printf("\t10jnet -c <twoJMax>\n");
+exit(2);
+}
+
+static bool triad(int a, int b, int c)
+{
+return (a+b+c)%2==0 && a<=b+c && b<=a+c && c<=a+b;
+}
+
+static bool agree(double a, double b)
+{
+return fabs(a-b)<=1e-9*(fabs(a)+fabs(b))+1e-300;
+}
+
+static int twistSign(int a, int b, int c)
+{
+return ((a+b-c)/2+(a*(a+2)+b*(b+2)-c*(c+2))/2)%2==0 ? 1 : -1;
+}
+
+//	The 10j symbol by expanding the 4-valent vertices; vertex i of the decagon has
+//	edges c_i, twoJ1[i-1], twoJ2[i-2] and vertex 5+i has c_i, twoJ1[i], twoJ2[i]
+
+static double decagonTenJ(int *twoJ1, int *twoJ2, SpinNetworkCache *cache,
+	SpinNetworkInfo &total)
+{
+int edges[30], twoJ[15], lo[5], hi[5];
+for (int i=0;i<5;i++)
+	{
+	edges[3*i]=i;
+	edges[3*i+1]=5+mod5(i-1);
+	edges[3*i+2]=10+mod5(i-2);
+	edges[3*(5+i)]=i;
+	edges[3*(5+i)+1]=5+i;
+	edges[3*(5+i)+2]=10+i;
+	twoJ[5+i]=twoJ1[i];
+	twoJ[10+i]=twoJ2[i];
+	int a=twoJ1[mod5(i-1)], b=twoJ2[mod5(i-2)], c=twoJ1[i], d=twoJ2[i];
+	lo[i]=max(abs(a-b),abs(c-d));
+	hi[i]=min(a+b,c+d);
+	};
+double sum=0.0;
+int c[5];
+for (c[0]=lo[0];c[0]<=hi[0];c[0]+=2)
+for (c[1]=lo[1];c[1]<=hi[1];c[1]+=2)
+for (c[2]=lo[2];c[2]<=hi[2];c[2]+=2)
+for (c[3]=lo[3];c[3]<=hi[3];c[3]+=2)
+for (c[4]=lo[4];c[4]<=hi[4];c[4]+=2)
+	{
+	double weight=1.0;
+	for (int i=0;i<5;i++)
+		{
+		twoJ[i]=c[i];
+		weight*=theta(0,c[i],c[i])/theta(twoJ1[mod5(i-1)],twoJ2[mod5(i-2)],c[i])/
+			theta(twoJ1[i],twoJ2[i],c[i]);
+		};
+	SpinNetworkInfo info;
+	double n=spinNetwork(10,edges,twoJ,cache,&info);
+	total.moves+=info.moves;
+	total.terms+=info.terms;
+	total.hits+=info.hits;
+	if (info.depth>total.depth) total.depth=info.depth;
+	sum+=weight*n*n;
+	};
+return sum;
+}
+
+static int check(int twoJMax)
+{
+std::mt19937 rng(1);
+int nBad=0;
+
+//	Tets, with every subset of vertices reversed; the vertices are those of the
+//	picture in tet.cpp, edges a..f numbered 0..5
+
+int n=0, bad=0, J[9];
+static const int tetEdges[12]={4,1,2, 5,1,0, 2,5,3, 3,0,4};
+for (int k=0;k<2000;k++)
+	{
+	for (int i=0;i<6;i++) J[i]=rng()%(twoJMax+1);
+	if (!triad(J[1],J[2],J[4]) || !triad(J[0],J[1],J[5]) ||
+		!triad(J[2],J[3],J[5]) || !triad(J[0],J[3],J[4])) continue;
+	double t=tet(J[0],J[1],J[2],J[3],J[4],J[5]);
+	for (int mask=0;mask<16;mask++)
+		{
+		int edges[12];
+		double expected=t;
+		for (int v=0;v<4;v++)
+			{
+			const int *e=&tetEdges[3*v];
+			bool reverse=(mask>>v)&1;
+			edges[3*v]=e[0];
+			edges[3*v+1]=reverse ? e[2] : e[1];
+			edges[3*v+2]=reverse ? e[1] : e[2];
+			if (reverse) expected*=twistSign(J[e[1]],J[e[2]],J[e[0]]);
+			};
+		n++;
+		if (!agree(spinNetwork(4,edges,J,NULL,NULL),expected)) bad++;
+		};
+	};
+printf("%d tets, %d wrong\n",n,bad);
+nBad+=bad;
+
+//	K_3,3:  edge 3r+c joins row vertex r to column vertex c
+
+n=bad=0;
+static const int k33Edges[18]={0,1,2, 3,4,5, 6,7,8, 0,3,6, 1,4,7, 2,5,8};
+for (int k=0;k<20000 && n<500;k++)
+	{
+	for (int i=0;i<9;i++) J[i]=rng()%(twoJMax+1);
+	bool ok=true;
+	for (int v=0;v<6;v++) ok&=triad(J[k33Edges[3*v]],J[k33Edges[3*v+1]],J[k33Edges[3*v+2]]);
+	if (!ok) continue;
+	double nineJ=0.0, thetas=1.0;
+	for (int x=0;x<=2*twoJMax;x++)
+		nineJ+=theta(0,x,x)*sixJ(J[0],J[3],J[6],J[7],J[8],x)*
+			sixJ(J[1],J[4],J[7],J[3],x,J[5])*sixJ(J[2],J[5],J[8],x,J[0],J[1]);
+	for (int v=0;v<6;v++)
+		thetas*=fabs(theta(J[k33Edges[3*v]],J[k33Edges[3*v+1]],J[k33Edges[3*v+2]]));
+	double value=spinNetwork(6,k33Edges,J,NULL,NULL)/sqrt(thetas);
+	n++;
+	if (fabs(fabs(value)-fabs(nineJ))>1e-9*fabs(nineJ)+1e-12) bad++;
+	};
+printf("%d 9j symbols, %d wrong\n",n,bad);
+nBad+=bad;
+
+//	10j symbols
+
+SpinNetworkCache *cache=newSpinNetworkCache();
+SpinNetworkInfo total;
+total.moves=total.terms=total.hits=0;
+total.depth=0;
+n=bad=0;
+for (int twoJ=1;twoJ<=twoJMax;twoJ++)
+	for (int sample=0;sample<2;sample++)
+		{
+		int twoJ1[5], twoJ2[5];
+		if (sample==0) for (int i=0;i<5;i++) twoJ1[i]=twoJ2[i]=twoJ;
+		else
+			{
+			bool ok;
+			do
+				{
+				for (int i=0;i<5;i++)
+					{
+					twoJ1[i]=rng()%(twoJ+1);
+					twoJ2[i]=rng()%(twoJ+1);
+					};
+				TenJSetup s;
+				tenJSetup(twoJ1,twoJ2,&s);
+				ok=true;
+				for (int i=0;i<5;i++)
+					ok&=s.H[i]>=s.L[i] &&
+						(twoJ1[i]+twoJ2[i]+twoJ1[mod5(i-1)]+twoJ2[mod5(i-2)])%2==0;
+				}
+			while (!ok);
+			};
+		double expand=decagonTenJ(twoJ1,twoJ2,cache,total), direct=tenJ(twoJ1,twoJ2);
+		n++;
+		bool ok=agree(expand,direct);
+		if (!ok) bad++;
+		printf("[%d %d %d %d %d] [%d %d %d %d %d] %24.17g %24.17g%s\n",
+			twoJ1[0],twoJ1[1],twoJ1[2],twoJ1[3],twoJ1[4],
+			twoJ2[0],twoJ2[1],twoJ2[2],twoJ2[3],twoJ2[4],expand,direct,ok ? "" : "  WRONG");
+		};
+printf("%d 10j symbols, %d wrong; %lld F moves, %lld terms, %lld cache hits, depth %d\n",
+	n,bad,total.moves,total.terms,total.hits,total.depth);
+deleteSpinNetworkCache(cache);
+nBad+=bad;
+return nBad;
+}
+
+int main(int argc, char **argv)
+{
+if (argc==3 && strcmp(argv[1],"-c")==0)
+	{
+	int twoJMax=atoi(argv[2]);
+	if (twoJMax<1) usage();
+	return check(twoJMax)==0 ? 0 : 1;
+	};
+if (argc!=2) usage();
+
+FILE *fp=fopen(argv[1],"r");
+if (fp==NULL)
+	{
+	printf("Could not open %s\n",argv[1]);
+	return 1;
+	};
+int nVertices, nEdges;
+bool ok=fscanf(fp,"%d %d",&nVertices,&nEdges)==2 && nVertices>0 && nEdges>0;
+std::vector<int> edges(ok ? 3*nVertices : 0), twoJ(ok ? nEdges : 0);
+for (size_t i=0;ok && i<edges.size();i++) ok=fscanf(fp,"%d",&edges[i])==1;
+for (size_t i=0;ok && i<twoJ.size();i++) ok=fscanf(fp,"%d",&twoJ[i])==1;
+fclose(fp);
+for (size_t i=0;ok && i<edges.size();i++) ok=edges[i]>=0 && edges[i]<nEdges;
+if (!ok)
+	{
+	printf("%s is not a valid spin network file\n",argv[1]);
+	return 1;
+	};
+
+SpinNetworkInfo info;
+clock_t c0=clock();
+double value=spinNetwork(nVertices,&edges[0],&twoJ[0],NULL,&info);
+printf("%.17g\n",value);
+printf("%lld F moves, %lld terms, %lld cache hits, depth %d, %.3f seconds\n",
+	info.moves,info.terms,info.hits,info.depth,(clock()-c0)/(double)CLOCKS_PER_SEC);
+return 0;
+}
@@ -0,0 +1,102 @@
+/*
+
+parallel.cpp
+============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a version of tenJ() that shares the sum over m1, m2 for a single
+10j symbol between several threads:
+
+	TENJfloat tenJThreads(int *twoJ1, int *twoJ2, int nThreads, bool reproducible)
+
+The threads take (m1, m2) steps one at a time from a shared counter, so which
+thread computes which term depends on how they happen to be scheduled.  Each term
+is computed entirely within one thread (including the alternating sums inside
+the tets), so the terms themselves are always the same; only the order in which
+they are added can change.
+
+If reproducible is false, each thread adds up the terms it computed, and the
+partial sums of the threads are added at the end.  The result can then differ in
+the last few digits from run to run, since the sum over m is heavily cancelling.
+
+If reproducible is true, each term is stored in an array indexed by step number,
+and the array is summed by pairwise summation, splitting each range at the same
+midpoint whatever the number of threads.  The result is then identical, bit for
+bit, for any number of threads and any scheduling.  This needs one TENJfloat per
+step, and the same number of additions as the ordinary sum; pairwise summation
+also has a smaller rounding error than adding the terms in sequence.
+
+Symbols too large for the coefficient matrices in tenJ.cpp give NaN, rather than
+stopping the program as tenJ() does.  10jstream (streamMain.cpp) uses this routine
+for its -T option, and with -v checks that the values are the same with one thread.
+
+*/
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "spin.h"
+
+//	pairwiseSum() adds up n terms along a fixed tree
+
+static TENJfloat pairwiseSum(TENJfloat *terms, int n)
+{
+if (n<=8)
+	{
+	TENJfloat sum=0.0;
+	for (int i=0;i<n;i++) sum+=terms[i];
+	return sum;
+	};
+int half=n/2;
+return pairwiseSum(terms,half)+pairwiseSum(terms+half,n-half);
+}
+
+//	tenJThreads()
+//	=============
+
+TENJfloat tenJThreads(int *twoJ1, int *twoJ2, int nThreads, bool reproducible)
+{
+TenJSetup s;
+if (!tenJSetup(twoJ1,twoJ2,&s)) return NAN;
+if (nThreads<1) nThreads=1;
+
+int nSteps=s.nSteps;
+TENJfloat *terms=reproducible ? new TENJfloat[nSteps] : NULL;
+TENJfloat *partial=new TENJfloat[nThreads];
+std::atomic<int> nextStep(0);
+
+auto work=[&](int t)
+	{
+	TenJWork *w=newTenJWork();
+	TENJfloat sum=0.0;
+	for (int step=nextStep++;step<nSteps;step=nextStep++)
+		{
+		int m1, m2;
+		tenJStepM(&s,step,m1,m2);
+		TENJfloat term=tenJTerm(&s,m1,m2,w);
+		if (reproducible) terms[step]=term; else sum+=term;
+		};
+	partial[t]=sum;
+	deleteTenJWork(w);
+	};
+
+std::vector<std::thread> threads;
+for (int t=1;t<nThreads;t++) threads.push_back(std::thread(work,t));
+work(0);
+for (int t=1;t<nThreads;t++) threads[t-1].join();
+
+TENJfloat result=0.0;
+if (reproducible)
+	{
+	result=pairwiseSum(terms,nSteps);
+	delete [] terms;
+	}
+else
+	{
+	for (int t=0;t<nThreads;t++) result+=partial[t];
+	};
+delete [] partial;
+return result;
+}
@@ -0,0 +1,464 @@
+/*
+
+partition.cpp
+=============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a routine that computes the cutoff partition function of the
+DFKR model on a triangulated 4-manifold M:
+
+	Z_J(M) = sum over spin foams F with every 2j <= maxTwoJ of Z(F)
+
+where Z(F) is the amplitude computed by dfkrLogAmplitude() (amplitude.cpp).
+
+	bool partitionSum(Triangulation *tri, int maxTwoJ, int nThreads,
+		double reportSeconds, PartitionSum *result)
+
+The spins are assigned one triangle at a time, in an order that completes the
+tetrahedra and 4-simplices as early as possible:  the 4-simplices are taken in
+breadth-first order through the tetrahedra they share, and the new triangles of
+each one are added tet by tet.  When a triangle completes a tet, the spins on the
+tet's other three triangles fix the parity of its spin and bound it above by their
+sum and below by the excess of the largest over the other two; only those values
+are tried, so every tet that is complete has a nonzero 4j.  A tet that is only
+partly labelled is checked against the largest value its free triangles could
+take.  Each labelling carries the product of the amplitudes of everything it has
+completed, so a leaf only costs the factors for its last triangle, and a branch
+where some 10j symbol vanishes is cut off at once.
+
+The search tree is split between threads by work stealing.  Each thread keeps a
+deque of subtrees; down to a fixed depth, the children of a node are pushed onto
+the owner's deque rather than searched, and below it the search is an ordinary
+recursion.  A thread takes work from the back of its own deque, and when that is
+empty steals from the front of another's, where the largest subtrees are; when
+there is nothing to steal, it sleeps until a subtree is pushed or the last one is
+finished.
+
+The 10j symbols come from tenJCached(), behind a small table in each thread keyed
+by the ten spins exactly as they appear, which avoids the locks and the search for
+a canonical form on the great majority of lookups.
+
+The sum is kept as an XFloat, since Z_J grows very quickly with the cutoff.  If
+reportSeconds is positive, the number of foams and the partial sum of the subtrees
+finished so far are printed at that interval.  If any 10j symbol is too large for
+tenJ(), the search is abandoned and partitionSum() returns false.
+
+*/
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <chrono>
+#include <unordered_map>
+#include <stdint.h>
+#include "spin.h"
+
+//	Subtrees are handed out by the threads down to a depth where there are
+//	about this many of them for each thread
+
+#define tasksPerThread 256
+
+//	What to do at each depth of the search
+
+struct ZDepth
+	{
+	int triangle;						//	Triangle labelled at this depth
+	std::vector<int> completeTets;		//	Tets it completes
+	std::vector<int> partialTets;		//	Other tets it belongs to
+	std::vector<int> completePents;		//	4-simplices it completes
+	};
+
+struct ZTask
+	{
+	int depth;
+	XFloat partial;						//	Amplitude of what has been completed
+	std::vector<int> twoJ;				//	Spins of the triangles labelled so far
+	};
+
+struct ZWorker
+	{
+	std::mutex lock;
+	std::deque<ZTask> tasks;
+	std::vector<int> twoJ;
+	std::unordered_map<uint64_t,TENJfloat> tenJMemo;
+	XFloat z;
+	long long nFoams, nNodes;
+	};
+
+struct ZSearch
+	{
+	Triangulation *tri;
+	int maxTwoJ, nDepths, splitDepth, nThreads;
+	std::vector<ZDepth> depths;
+	std::vector<int> position;			//	Depth at which each triangle is labelled
+	std::vector<ZWorker> workers;
+	std::atomic<long long> outstanding, nSteals;
+	std::atomic<bool> tooLarge;			//	A 10j symbol was too large for tenJ()
+	std::mutex totalLock;
+	PartitionSum total;
+	std::mutex idleLock;				//	Guards nQueued, for idle threads
+	std::condition_variable idle;
+	long long nQueued;					//	Subtrees waiting in the deques
+
+	ZSearch(int n) : workers(n), outstanding(0), nSteals(0), tooLarge(false), nQueued(0) {}
+	};
+
+//	Order the triangles, and list what each one completes
+
+static void planSearch(ZSearch *s)
+{
+Triangulation *tri=s->tri;
+int nT=tri->nTriangles;
+
+//	4-simplices in breadth-first order, starting again in each component
+
+std::vector<std::vector<int> > tetPents(tri->nTets);
+for (int p=0;p<tri->nPent;p++)
+	for (int i=0;i<5;i++) tetPents[tri->pentTets[p][i]].push_back(p);
+std::vector<int> pentOrder;
+std::vector<bool> seenPent(tri->nPent,false);
+for (int p0=0;p0<tri->nPent;p0++)
+	{
+	if (seenPent[p0]) continue;
+	seenPent[p0]=true;
+	pentOrder.push_back(p0);
+	for (size_t q=pentOrder.size()-1;q<pentOrder.size();q++)
+		{
+		int p=pentOrder[q];
+		for (int i=0;i<5;i++)
+			{
+			std::vector<int> &next=tetPents[tri->pentTets[p][i]];
+			for (size_t k=0;k<next.size();k++)
+				if (!seenPent[next[k]])
+					{
+					seenPent[next[k]]=true;
+					pentOrder.push_back(next[k]);
+					};
+			};
+		};
+	};
+
+//	Triangles, tet by tet
+
+std::vector<int> order;
+s->position.assign(nT,-1);
+for (size_t q=0;q<pentOrder.size();q++)
+	for (int i=0;i<5;i++)
+		{
+		int *t=tri->tetTriangles[tri->pentTets[pentOrder[q]][i]];
+		for (int k=0;k<4;k++)
+			if (s->position[t[k]]<0)
+				{
+				s->position[t[k]]=(int)order.size();
+				order.push_back(t[k]);
+				};
+		};
+
+//	The depth at which each tet and 4-simplex is completed
+
+s->nDepths=nT;
+s->depths.resize(nT);
+for (int d=0;d<nT;d++) s->depths[d].triangle=order[d];
+for (int e=0;e<tri->nTets;e++)
+	{
+	int last=0;
+	for (int k=0;k<4;k++)
+		if (s->position[tri->tetTriangles[e][k]]>last) last=s->position[tri->tetTriangles[e][k]];
+	for (int k=0;k<4;k++)
+		{
+		int d=s->position[tri->tetTriangles[e][k]];
+		if (d==last) s->depths[d].completeTets.push_back(e);
+		else s->depths[d].partialTets.push_back(e);
+		};
+	};
+for (int p=0;p<tri->nPent;p++)
+	{
+	int last=0;
+	for (int n=0;n<10;n++)
+		if (s->position[tri->pentTriangles[p][n]]>last) last=s->position[tri->pentTriangles[p][n]];
+	s->depths[last].completePents.push_back(p);
+	};
+
+//	Hand out subtrees down to the depth where there are enough of them
+
+double nTasks=1.0;
+s->splitDepth=0;
+while (s->splitDepth<nT-1 && nTasks<(double)tasksPerThread*s->nThreads)
+	{
+	nTasks*=s->maxTwoJ+1;
+	s->splitDepth++;
+	};
+}
+
+//	The 10j symbol of a 4-simplex, from the thread's own table if possible
+
+static TENJfloat pentTenJ(ZSearch *s, ZWorker *w, int p)
+{
+int *t=s->tri->pentTriangles[p], twoJ1[5], twoJ2[5];
+for (int i=0;i<5;i++)
+	{
+	twoJ1[i]=w->twoJ[t[i]];
+	twoJ2[i]=w->twoJ[t[5+i]];
+	};
+if (s->maxTwoJ>=64) return tenJCached(twoJ1,twoJ2);
+
+uint64_t key=0;
+for (int i=0;i<5;i++) key=(key<<12)|(uint64_t)(twoJ1[i]<<6|twoJ2[i]);
+std::unordered_map<uint64_t,TENJfloat>::iterator it=w->tenJMemo.find(key);
+if (it!=w->tenJMemo.end()) return it->second;
+TENJfloat value=tenJCached(twoJ1,twoJ2);
+w->tenJMemo[key]=value;
+return value;
+}
+
+//	Can a partly labelled tet still be completed?
+
+static bool tetPossible(ZSearch *s, ZWorker *w, int e)
+{
+int *t=s->tri->tetTriangles[e];
+int sum=0, largest=0, nFree=0;
+for (int k=0;k<4;k++)
+	{
+	int j=w->twoJ[t[k]];
+	if (j<0)
+		{
+		nFree++;
+		continue;
+		};
+	sum+=j;
+	if (j>largest) largest=j;
+	};
+return largest<=sum-largest+nFree*s->maxTwoJ;
+}
+
+static void pushTask(ZSearch *s, ZWorker *w, ZTask &task)
+{
+s->outstanding++;
+	{
+	std::lock_guard<std::mutex> lock(w->lock);
+	w->tasks.push_back(task);
+	}
+	{
+	std::lock_guard<std::mutex> lock(s->idleLock);
+	s->nQueued++;
+	}
+s->idle.notify_one();
+}
+
+//	Label the triangle at depth d, and everything below it
+
+static void search(ZSearch *s, ZWorker *w, int d, XFloat partial)
+{
+if (s->tooLarge) return;
+w->nNodes++;
+if (d==s->nDepths)
+	{
+	w->z+=partial;
+	w->nFoams++;
+	return;
+	};
+ZDepth &depth=s->depths[d];
+int f=depth.triangle;
+
+//	The spins allowed by the tets completed here
+
+int lo=0, hi=s->maxTwoJ, parity=-1;
+for (size_t i=0;i<depth.completeTets.size();i++)
+	{
+	int *t=s->tri->tetTriangles[depth.completeTets[i]], sum=0, largest=0;
+	for (int k=0;k<4;k++)
+		if (t[k]!=f)
+			{
+			sum+=w->twoJ[t[k]];
+			if (w->twoJ[t[k]]>largest) largest=w->twoJ[t[k]];
+			};
+	if (2*largest-sum>lo) lo=2*largest-sum;
+	if (sum<hi) hi=sum;
+	if (parity>=0 && parity!=sum%2) return;
+	parity=sum%2;
+	};
+int step=1;
+if (parity>=0)
+	{
+	if (lo%2!=parity) lo++;
+	step=2;
+	};
+
+for (int x=lo;x<=hi;x+=step)
+	{
+	w->twoJ[f]=x;
+	bool possible=true;
+	for (size_t i=0;i<depth.partialTets.size();i++)
+		possible&=tetPossible(s,w,depth.partialTets[i]);
+	if (!possible) continue;
+
+	double factor=(double)(x+1)*(x+1);
+	for (size_t i=0;i<depth.completeTets.size();i++)
+		{
+		int *t=s->tri->tetTriangles[depth.completeTets[i]];
+		factor/=fourJ(w->twoJ[t[0]],w->twoJ[t[1]],w->twoJ[t[2]],w->twoJ[t[3]]);
+		};
+	for (size_t i=0;i<depth.completePents.size();i++)
+		factor*=pentTenJ(s,w,depth.completePents[i]);
+	if (isnan(factor))
+		{
+		s->tooLarge=true;
+		break;
+		};
+	if (factor==0.0) continue;
+
+	if (d<s->splitDepth)
+		{
+		ZTask task;
+		task.depth=d+1;
+		task.partial=partial*XFloat(factor);
+		task.twoJ=w->twoJ;
+		pushTask(s,w,task);
+		}
+	else search(s,w,d+1,partial*XFloat(factor));
+	};
+w->twoJ[f]=-1;
+}
+
+//	Take a task from the back of our own deque, or steal one from the front of
+//	another thread's
+
+static bool takeTask(ZSearch *s, int me, ZTask &task)
+{
+	{
+	ZWorker &w=s->workers[me];
+	std::lock_guard<std::mutex> lock(w.lock);
+	if (!w.tasks.empty())
+		{
+		task=w.tasks.back();
+		w.tasks.pop_back();
+		return true;
+		};
+	}
+for (int k=1;k<s->nThreads;k++)
+	{
+	ZWorker &v=s->workers[(me+k)%s->nThreads];
+	std::lock_guard<std::mutex> lock(v.lock);
+	if (!v.tasks.empty())
+		{
+		task=v.tasks.front();
+		v.tasks.pop_front();
+		s->nSteals++;
+		return true;
+		};
+	};
+return false;
+}
+
+static void work(ZSearch *s, int me)
+{
+ZWorker *w=&s->workers[me];
+ZTask task;
+while (true)
+	{
+	if (!takeTask(s,me,task))
+		{
+		//	Sleep until there is something to take, or nothing left to do;
+		//	nQueued can be briefly negative, if a task is taken before its
+		//	owner has counted it
+
+		std::unique_lock<std::mutex> lock(s->idleLock);
+		s->idle.wait(lock,[s]{return s->nQueued>0 || s->outstanding==0;});
+		if (s->outstanding==0) break;
+		continue;
+		};
+	{
+	std::lock_guard<std::mutex> lock(s->idleLock);
+	s->nQueued--;
+	}
+	w->twoJ=task.twoJ;
+	search(s,w,task.depth,task.partial);
+
+	//	Add what this subtree found to the total, apart from any subtrees it
+	//	handed out, which will add their own
+
+	{
+	std::lock_guard<std::mutex> lock(s->totalLock);
+	s->total.z+=w->z;
+	s->total.nFoams+=w->nFoams;
+	s->total.nNodes+=w->nNodes;
+	}
+	w->z=XFloat();
+	w->nFoams=w->nNodes=0;
+	if (--s->outstanding==0)
+		{
+		std::lock_guard<std::mutex> lock(s->idleLock);
+		s->idle.notify_all();
+		};
+	};
+}
+
+//	partitionSum()
+//	==============
+
+bool partitionSum(Triangulation *tri, int maxTwoJ, int nThreads, double reportSeconds,
+	PartitionSum *result)
+{
+if (maxTwoJ<0 || tri->nTriangles==0)
+	{
+	printf("Nothing to sum\n");
+	return false;
+	};
+if (nThreads<1) nThreads=1;
+
+ZSearch s(nThreads);
+s.tri=tri;
+s.maxTwoJ=maxTwoJ;
+s.nThreads=nThreads;
+s.total.z=XFloat();
+s.total.nFoams=s.total.nNodes=s.total.nSteals=0;
+planSearch(&s);
+for (int t=0;t<nThreads;t++)
+	{
+	s.workers[t].twoJ.assign(tri->nTriangles,-1);
+	s.workers[t].nFoams=s.workers[t].nNodes=0;
+	};
+
+ZTask root;
+root.depth=0;
+root.partial=XFloat(1.0);
+root.twoJ.assign(tri->nTriangles,-1);
+pushTask(&s,&s.workers[0],root);
+
+std::chrono::steady_clock::time_point t0=std::chrono::steady_clock::now();
+std::vector<std::thread> threads;
+for (int t=0;t<nThreads;t++) threads.push_back(std::thread(work,&s,t));
+
+double nextReport=reportSeconds;
+while (s.outstanding>0)
+	{
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	double seconds=std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+	if (reportSeconds>0.0 && seconds>=nextReport)
+		{
+		char buf[40];
+		std::lock_guard<std::mutex> lock(s.totalLock);
+		printf("%10.1f s %14lld foams  Z = %s\n",seconds,s.total.nFoams,
+			xToString(s.total.z,10,buf));
+		fflush(stdout);
+		nextReport+=reportSeconds;
+		};
+	};
+for (int t=0;t<nThreads;t++) threads[t].join();
+
+if (s.tooLarge)
+	{
+	printf("A 10j symbol needs matrices larger than maxC=%d\n",maxC);
+	return false;
+	};
+
+*result=s.total;
+result->nSteals=s.nSteals;
+result->seconds=std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+return true;
+}
@@ -0,0 +1,52 @@
+/*
+
+partitionMain.cpp
+=================
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a main program that computes the cutoff partition function of
+the DFKR model on a triangulated 4-manifold, by partitionSum().
+
+	10jz <triangulation> <maxTwoJ> [threads]
+
+The triangulation is either S4, for the boundary of a 5-simplex, or the name of a
+file listing the five vertex labels of each 4-simplex, one 4-simplex per line, as
+for 10jfoam.  Every spin foam with all 2j <= maxTwoJ is included; the number of
+threads is by default one for each processor.  Progress is reported every ten
+seconds.
+
+*/
+
+#include <thread>
+#include "spin.h"
+
+void usage()
+{
+printf("usage:\t10jz <S4 | file> <maxTwoJ> [threads]\n");
+exit(2);
+}
+
+int main(int argc, char **argv)
+{
+if (argc<3 || argc>4) usage();
+Triangulation tri;
+if (!readTriangulation(argv[1],&tri)) return 1;
+printf("%d 4-simplices, %d tetrahedra, %d triangles\n",tri.nPent,tri.nTets,tri.nTriangles);
+
+int maxTwoJ=atoi(argv[2]);
+int nThreads=argc==4 ? atoi(argv[3]) : (int)std::thread::hardware_concurrency();
+PartitionSum z;
+if (!partitionSum(&tri,maxTwoJ,nThreads,10.0,&z)) return 1;
+
+char buf[40];
+long long entries, hits, misses;
+tenJCacheInfo(entries,hits,misses);
+printf("Z = %s\n",xToString(z.z,15,buf));
+printf("%lld foams, %lld nodes searched, %lld subtrees stolen, %.3f seconds with %d threads\n",
+	z.nFoams,z.nNodes,z.nSteals,z.seconds,nThreads);
+printf("%lld distinct 10j symbols computed\n",entries);
+freeTriangulation(&tri);
+return 0;
+}
@@ -0,0 +1,252 @@
+/*
+
+plan.cpp
+========
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains routines that predict how much work and memory tenJ() will
+need for a given 10j symbol, without computing it.
+
+tenJPlan(int *twoJ1, int *twoJ2, TenJPlan *plan) runs through the same limits as
+tenJ(): L[i], H[i], mLow, mHigh, and the dimensions dim[i] of the matrices for each
+pair of m's.  This takes O(j^2) operations, against O(j^5) for tenJ() itself.
+It fills in:
+
+	admissible		false if the matrices would not fit in maxC (spin.h)
+	steps			number of (m1, m2) steps that contribute to the sum
+	tets			number of calls to tetOnThetas() (or tet()) to fill the matrices
+	flops			multiplications and additions in the trace of the matrix product
+	matrixBytes		largest amount of matrix storage needed for any single step
+	seconds			predicted running time
+
+The time is predicted as
+
+	seconds = tets * (tetBase + tetPerSpin * maxTwoJ) + flops * perFlop
+
+since the number of terms in each tet, and the size of the factorials in it, grow
+linearly with the spins.  The three coefficients have default values measured on
+a typical machine; calibrateTenJPlan() replaces them with values fitted to a
+short benchmark on the machine in use.
+
+tenJAdmit(TenJPlan *plan, double maxSeconds, double maxBytes) says whether a symbol
+should be accepted, given limits on time and memory; a limit of zero or less means
+no limit.
+
+*/
+
+#include <chrono>
+#include "spin.h"
+
+//	Coefficients of the time model, in seconds
+
+static double tetBase=3.0e-7, tetPerSpin=3.5e-8, perFlop=2.0e-9;
+
+//	tenJPlan()
+//	==========
+
+void tenJPlan(int *twoJ1, int *twoJ2, TenJPlan *plan)
+{
+TenJSetup s;
+plan->admissible=tenJSetup(twoJ1,twoJ2,&s);
+
+bool regular=true;
+int maxTwoJ=0;
+for (int i=0;i<5;i++)
+	{
+	regular&=(twoJ1[i]==twoJ1[0] && twoJ2[i]==twoJ1[0]);
+	if (twoJ1[i]>maxTwoJ) maxTwoJ=twoJ1[i];
+	if (twoJ2[i]>maxTwoJ) maxTwoJ=twoJ2[i];
+	};
+
+double steps=0.0, tets=0.0, flops=0.0, matrixBytes=0.0;
+int dim[5];
+for (int m1=s.mLow;m1<=s.mHigh;m1+=2)
+for (int m2=s.mLow;m2<=m1;m2+=2)
+	{
+	//	Dimensions of the matrices, exactly as in tenJTerm()
+
+	bool compatible=true;
+	int lowDim=0;
+	for (int i=0;i<5 && compatible;i++)
+		{
+		int j2m=s.twoJ2[mod5(i-1)];
+		int LLi=max(max(abs(m1-j2m),abs(m2-j2m)),s.L[i]);
+		int HHi=min(min(m1+j2m,m2+j2m),s.H[i]);
+		if (HHi<LLi) compatible=false;
+		dim[i]=1+(HHi-LLi)/2;
+		if (dim[i]<dim[lowDim]) lowDim=i;
+		};
+	if (!compatible) continue;
+	steps++;
+
+	//	Entries in the matrices; the regular routine only needs one matrix
+
+	double entries=0.0;
+	for (int k=0;k<5;k++) entries+=(double)dim[k]*dim[(k+1)%5];
+	tets+=regular ? 2.0*dim[0]*dim[0] : 2.0*entries;
+	if (entries*sizeof(TENJfloat)>matrixBytes) matrixBytes=entries*sizeof(TENJfloat);
+
+	//	Three matrix-vector products and a dot product for each basis vector
+
+	double chain=0.0;
+	for (int k=1;k<=3;k++) chain+=2.0*dim[mod5(lowDim+k)]*dim[mod5(lowDim+k+1)];
+	chain+=2.0*dim[mod5(lowDim+4)];
+	flops+=dim[lowDim]*chain;
+	};
+
+plan->steps=steps;
+plan->tets=tets;
+plan->flops=flops;
+plan->matrixBytes=matrixBytes;
+plan->seconds=tets*(tetBase+tetPerSpin*maxTwoJ)+flops*perFlop;
+}
+
+//	tenJAdmit()
+//	===========
+
+bool tenJAdmit(TenJPlan *plan, double maxSeconds, double maxBytes)
+{
+if (!plan->admissible) return false;
+if (maxSeconds>0.0 && plan->seconds>maxSeconds) return false;
+if (maxBytes>0.0 && plan->matrixBytes>maxBytes) return false;
+return true;
+}
+
+//	calibrateTenJPlan()
+//	===================
+//
+//	Times tenJ() for a few symbols of different sizes and shapes, and fits the
+//	coefficients of the time model to the results by least squares, keeping the
+//	coefficients non-negative.  This takes a fraction of a second.  Returns false,
+//	leaving the coefficients unchanged, if no sensible fit is found.
+
+//	Number of benchmark symbols
+
+#define nBench 12
+
+//	fitModel() solves the least squares problem for the coefficients flagged in
+//	use[], with the others held at zero; it returns the sum of squared residuals,
+//	or a negative number if the solution has a negative coefficient.
+
+static double fitModel(double x[nBench][3], double *y, bool *use, double *c)
+{
+double A[3][3], b[3];
+int idx[3], n=0;
+for (int j=0;j<3;j++)
+	{
+	c[j]=0.0;
+	if (use[j]) idx[n++]=j;
+	};
+
+for (int r=0;r<n;r++)
+	{
+	b[r]=0.0;
+	for (int q=0;q<n;q++) A[r][q]=0.0;
+	for (int k=0;k<nBench;k++)
+		{
+		for (int q=0;q<n;q++) A[r][q]+=x[k][idx[r]]*x[k][idx[q]];
+		b[r]+=x[k][idx[r]]*y[k];
+		};
+	};
+
+//	Gaussian elimination; the normal equations are symmetric positive definite
+//	unless the columns are degenerate
+
+for (int p=0;p<n;p++)
+	{
+	if (A[p][p]<=0.0) return -1.0;
+	for (int r=p+1;r<n;r++)
+		{
+		double f=A[r][p]/A[p][p];
+		for (int q=p;q<n;q++) A[r][q]-=f*A[p][q];
+		b[r]-=f*b[p];
+		};
+	};
+for (int p=n-1;p>=0;p--)
+	{
+	double v=b[p];
+	for (int q=p+1;q<n;q++) v-=A[p][q]*c[idx[q]];
+	c[idx[p]]=v/A[p][p];
+	if (c[idx[p]]<0.0) return -1.0;
+	};
+
+double r2=0.0;
+for (int k=0;k<nBench;k++)
+	{
+	double r=y[k];
+	for (int j=0;j<3;j++) r-=c[j]*x[k][j];
+	r2+=r*r;
+	};
+return r2;
+}
+
+bool calibrateTenJPlan()
+{
+static int base1[][5]={{1,1,1,1,1},{2,3,1,2,1},{2,1,1,2,1}};
+static int base2[][5]={{1,1,1,1,1},{1,3,1,2,2},{1,1,1,2,2}};
+static int mults[]={2,4,6,8};
+
+//	Each benchmark gives an equation for (tetBase, tetPerSpin, perFlop); the
+//	equations are scaled by the measured time, so the fit is to relative errors
+
+double x[nBench][3], y[nBench];
+int k=0;
+for (int s=0;s<3;s++)
+for (int m=0;m<4;m++,k++)
+	{
+	int twoJ1[5], twoJ2[5], maxTwoJ=0;
+	for (int i=0;i<5;i++)
+		{
+		twoJ1[i]=mults[m]*base1[s][i];
+		twoJ2[i]=mults[m]*base2[s][i];
+		if (twoJ1[i]>maxTwoJ) maxTwoJ=twoJ1[i];
+		if (twoJ2[i]>maxTwoJ) maxTwoJ=twoJ2[i];
+		};
+
+	//	Time the routine the plan is for, repeating small symbols to get a
+	//	measurable time; the first call warms up the factorial caches
+
+	bool regular=(s==0);
+	if (regular) tenJ(twoJ1[0]); else tenJ(twoJ1,twoJ2);
+	int reps=0;
+	auto t0=std::chrono::steady_clock::now();
+	double seconds;
+	do	{
+		if (regular) tenJ(twoJ1[0]); else tenJ(twoJ1,twoJ2);
+		reps++;
+		seconds=std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+		}
+	while (seconds<0.005);
+	seconds/=reps;
+
+	TenJPlan plan;
+	tenJPlan(twoJ1,twoJ2,&plan);
+	x[k][0]=plan.tets/seconds;
+	x[k][1]=plan.tets*maxTwoJ/seconds;
+	x[k][2]=plan.flops/seconds;
+	y[k]=1.0;
+	};
+
+//	Try every subset of the coefficients, and keep the best fit that has no
+//	negative coefficients
+
+double best=-1.0, c[3], bestC[3]={tetBase,tetPerSpin,perFlop};
+for (int subset=1;subset<8;subset++)
+	{
+	bool use[3]={(subset&1)!=0, (subset&2)!=0, (subset&4)!=0};
+	double r2=fitModel(x,y,use,c);
+	if (r2>=0.0 && (best<0.0 || r2<best))
+		{
+		best=r2;
+		for (int j=0;j<3;j++) bestC[j]=c[j];
+		};
+	};
+if (best<0.0) return false;
+
+tetBase=bestC[0];
+tetPerSpin=bestC[1];
+perFlop=bestC[2];
+return true;
+}
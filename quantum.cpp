@@ -0,0 +1,412 @@
+/*
+
+quantum.cpp
+===========
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains versions of the theta, tet, 6j and 10j routines for the
+quantum group SU_q(2), as used in the Turaev-Viro model and in the q-deformed
+Barrett-Crane model based on SU_q(2) x SU_qbar(2).  Every factorial n! in the
+ordinary formulas becomes a quantum factorial [n]! = [1][2]...[n], where
+
+	[n] = sin(n pi/r) / sin(pi/r)		for q = exp(i pi/r), a root of unity
+	[n] = sinh(n h) / sinh(h)			for a real q = exp(h) > 0
+
+so [n] = n when q = 1.  At a root of unity only spins with 2j <= r-2, and triads
+whose doubled spins add up to at most 2r-4, are admissible; every sum below runs
+over the admissible labels only, and a net with an inadmissible edge or triad is
+zero.
+
+	QTable *newQTable(int nq, QParameter *q, int maxTwoJ)
+
+builds the tables of log [n]! for nq values of q at once, each given by a
+QParameter with r >= 3 for a root of unity or r = 0 for a real q.  maxTwoJ is the
+largest doubled spin on the edges of any 10j symbol to be computed; the nets in
+the 10j sum have spins up to three times as large.  The tables are laid out with
+the values of q as the fastest index, so that every routine below can work on all
+of them at once with the same sequence of indices, in contiguous "lanes".
+
+	FACTfloat qTheta(QTable *t, int lane, int a, int b, int c)
+	TETfloat qTet(QTable *t, int lane, int a, int b, int c, int d, int e, int f)
+	TETfloat qTetOnThetas(QTable *t, int lane, int a, ..., int twoJ3b)
+	SIXJfloat qSixJ(QTable *t, int lane, int twoJ1, ..., int twoJ6)
+	TENJfloat qTenJ(QTable *t, int lane, int *twoJ1, int *twoJ2)
+
+have the same arguments and conventions as theta(), tet(), tetOnThetas(), sixJ()
+and tenJ(), for the value of q in one lane, and
+
+	void qTenJLanes(QTable *t, int *twoJ1, int *twoJ2, TENJfloat *values)
+
+computes a 10j symbol for every value of q in the table, values[lane] for each,
+in a single pass over the sum of Christensen and Egan.  Deforming each decagonal
+network into a ladder closed up with a twist gives phases; those that depend only
+on the spins and the c's come once from SU_q(2) and once, conjugated, from
+SU_qbar(2), and cancel, as the signs do when q = 1.  What is left is the twist on
+the spin m/2 that runs round the ladder after recoupling: the term for m1, m2 is
+multiplied by q^(j1(j1+1) - j2(j2+1)) with j1 = m1/2, j2 = m2/2, and since the
+terms are symmetric in m1 and m2 only its real part survives, cos(pi d/r) or
+cosh(h d) with d = j1(j1+1) - j2(j2+1).  At q = 1 this is the sign (-1)^((m1+m2)/2)
+in tenJ().  With it the symbol keeps all 120 symmetries of the 4-simplex, which
+10jq checks; without it, only the ten that preserve the pentagon.
+
+The quantum factorials are kept as logarithms, and each ratio of them is formed
+by adding and subtracting logs; the alternating sum in a tet is taken relative to
+its largest term.  This costs a few more digits than multiRatio() for q = 1, but
+cannot overflow for real q, where [n]! grows like exp(h n^2/2).
+
+*/
+
+#include <vector>
+#include "spin.h"
+
+static const double pi=3.14159265358979323846;
+
+struct QTable
+	{
+	int nq;							//	Number of values of q, or lanes
+	int maxN;						//	Largest n in the tables
+	std::vector<QParameter> q;
+	std::vector<int> maxSum;		//	Largest admissible sum of a triad, halved
+	std::vector<double> logFact;	//	log [n]!, at n*nq+lane
+	std::vector<double> qInt;		//	[n], at n*nq+lane
+	};
+
+//	newQTable()
+//	===========
+
+QTable *newQTable(int nq, QParameter *q, int maxTwoJ)
+{
+for (int k=0;k<nq;k++)
+	if (!((q[k].r>=3) || (q[k].r==0 && q[k].q>0.0)))
+		{
+		printf("newQTable() was given r = %d, q = %g\n",q[k].r,q[k].q);
+		return NULL;
+		};
+
+QTable *t=new QTable;
+t->nq=nq;
+t->maxN=8*maxTwoJ+8;
+t->q.assign(q,q+nq);
+t->maxSum.resize(nq);
+t->logFact.resize((t->maxN+1)*nq);
+t->qInt.resize((t->maxN+1)*nq);
+
+for (int k=0;k<nq;k++)
+	{
+	int r=q[k].r;
+	double h=r==0 ? log(q[k].q) : 0.0;
+	t->maxSum[k]=r==0 ? t->maxN : r-2;
+	double lf=0.0;
+	t->logFact[k]=0.0;
+	t->qInt[k]=0.0;
+	for (int n=1;n<=t->maxN;n++)
+		{
+		double qn;
+		if (r!=0) qn=n<r ? sin(n*pi/r)/sin(pi/r) : 0.0;
+		else if (fabs(h)<1e-12) qn=n;
+		else qn=sinh(n*h)/sinh(h);
+
+		//	For large n*h, log [n] without forming sinh(n*h)
+
+		double logQn;
+		if (r==0 && fabs(n*h)>30.0) logQn=fabs(n*h)-log(2.0*sinh(fabs(h)));
+		else logQn=qn>0.0 ? log(qn) : -HUGE_VAL;
+		lf+=logQn;
+		t->logFact[n*nq+k]=lf;
+		t->qInt[n*nq+k]=qn;
+		};
+	};
+return t;
+}
+
+void deleteQTable(QTable *t)
+{
+delete t;
+}
+
+//	Is (a,b,c) an admissible triad of doubled spins?  The parity and triangle
+//	inequalities are the same for every q; qTriad() checks the sum for a lane.
+
+static bool triad(int a, int b, int c)
+{
+return (a+b+c)%2==0 && a<=b+c && b<=a+c && c<=a+b;
+}
+
+static inline bool qTriad(QTable *t, int lane, int a, int b, int c)
+{
+return (a+b+c)/2<=t->maxSum[lane];
+}
+
+//	Check that the table reaches n
+
+static bool inRange(QTable *t, int n, const char *caller)
+{
+if (n<=t->maxN) return true;
+printf("%s() needs [%d]!, beyond the table's %d\n",caller,n,t->maxN);
+return false;
+}
+
+//	qThetaLanes() computes theta nets for the lanes lane0 to lane0+n-1, into out[]
+
+static void qThetaLanes(QTable *t, int lane0, int n, int a, int b, int c, double *out)
+{
+int sumJ=(a+b+c)/2, nq=t->nq;
+if (!triad(a,b,c) || !inRange(t,sumJ+1,"qTheta"))
+	{
+	for (int k=0;k<n;k++) out[k]=0.0;
+	return;
+	};
+const double *lf=&t->logFact[lane0];
+double sign=sumJ%2==0 ? 1.0 : -1.0;
+for (int k=0;k<n;k++)
+	{
+	if (!qTriad(t,lane0+k,a,b,c)) {out[k]=0.0; continue;};
+	out[k]=sign*exp(lf[(sumJ-a)*nq+k]+lf[(sumJ-b)*nq+k]+lf[(sumJ-c)*nq+k]+lf[(sumJ+1)*nq+k]
+		-lf[a*nq+k]-lf[b*nq+k]-lf[c*nq+k]);
+	};
+}
+
+//	qTetLanes() computes tets, divided by two thetas if twoJa and twoJb are not
+//	NULL, for the lanes lane0 to lane0+n-1, into out[]; peak[] is workspace.
+
+static void qTetLanes(QTable *t, int lane0, int n, int a, int b, int c, int d, int e, int f,
+	int *twoJa, int *twoJb, double *out, double *peak)
+{
+int aa[4], bb[3], nq=t->nq;
+aa[0]=(a+b+f)/2; aa[1]=(b+c+e)/2; aa[2]=(c+d+f)/2; aa[3]=(a+d+e)/2;
+bb[0]=(b+d+e+f)/2; bb[1]=(a+c+e+f)/2; bb[2]=(a+b+c+d)/2;
+int sumLo=max(max(aa[0],aa[1]),max(aa[2],aa[3])), sumHi=min(min(bb[0],bb[1]),bb[2]);
+
+bool ok=triad(a,b,f) && triad(b,c,e) && triad(c,d,f) && triad(a,d,e) &&
+	inRange(t,sumHi+1,"qTet");
+if (twoJa!=NULL) ok=ok && triad(twoJa[0],twoJa[1],twoJa[2]) &&
+	triad(twoJb[0],twoJb[1],twoJb[2]) &&
+	inRange(t,(twoJa[0]+twoJa[1]+twoJa[2])/2+1,"qTetOnThetas") &&
+	inRange(t,(twoJb[0]+twoJb[1]+twoJb[2])/2+1,"qTetOnThetas");
+if (!ok)
+	{
+	for (int k=0;k<n;k++) out[k]=0.0;
+	return;
+	};
+const double *lf=&t->logFact[lane0];
+
+//	The largest term in the sum, for each lane
+
+for (int k=0;k<n;k++) peak[k]=-HUGE_VAL;
+for (int s=sumLo;s<=sumHi;s++)
+	for (int k=0;k<n;k++)
+		{
+		double term=lf[(s+1)*nq+k]
+			-lf[(s-aa[0])*nq+k]-lf[(s-aa[1])*nq+k]-lf[(s-aa[2])*nq+k]-lf[(s-aa[3])*nq+k]
+			-lf[(bb[0]-s)*nq+k]-lf[(bb[1]-s)*nq+k]-lf[(bb[2]-s)*nq+k];
+		if (term>peak[k]) peak[k]=term;
+		};
+
+//	The sum relative to it
+
+for (int k=0;k<n;k++) out[k]=0.0;
+for (int s=sumLo;s<=sumHi;s++)
+	{
+	double sign=s%2==0 ? 1.0 : -1.0;
+	for (int k=0;k<n;k++)
+		{
+		double term=lf[(s+1)*nq+k]
+			-lf[(s-aa[0])*nq+k]-lf[(s-aa[1])*nq+k]-lf[(s-aa[2])*nq+k]-lf[(s-aa[3])*nq+k]
+			-lf[(bb[0]-s)*nq+k]-lf[(bb[1]-s)*nq+k]-lf[(bb[2]-s)*nq+k];
+		out[k]+=sign*exp(term-peak[k]);
+		};
+	};
+
+//	The common factor: the factorials of the differences bb[j]-aa[i] over those of
+//	the edges, and for the thetas, those of the edges over the rest
+
+int sumJa=0, sumJb=0;
+if (twoJa!=NULL)
+	{
+	sumJa=(twoJa[0]+twoJa[1]+twoJa[2])/2;
+	sumJb=(twoJb[0]+twoJb[1]+twoJb[2])/2;
+	};
+double sign=(sumJa+sumJb)%2==0 ? 1.0 : -1.0;
+int edges[6]={a,b,c,d,e,f};
+for (int k=0;k<n;k++)
+	{
+	int lane=lane0+k;
+	bool qOk=peak[k]>-HUGE_VAL;
+	for (int i=0;i<4;i++) qOk=qOk && aa[i]<=t->maxSum[lane];
+	if (twoJa!=NULL) qOk=qOk && sumJa<=t->maxSum[lane] && sumJb<=t->maxSum[lane];
+	if (!qOk)
+		{
+		out[k]=0.0;
+		continue;
+		};
+	double common=peak[k];
+	for (int j=0;j<3;j++)
+		for (int i=0;i<4;i++) common+=lf[(bb[j]-aa[i])*nq+k];
+	for (int i=0;i<6;i++) common-=lf[edges[i]*nq+k];
+	if (twoJa!=NULL)
+		for (int i=0;i<3;i++)
+			{
+			common+=lf[twoJa[i]*nq+k]-lf[(sumJa-twoJa[i])*nq+k];
+			common+=lf[twoJb[i]*nq+k]-lf[(sumJb-twoJb[i])*nq+k];
+			};
+	if (twoJa!=NULL) common-=lf[(sumJa+1)*nq+k]+lf[(sumJb+1)*nq+k];
+	out[k]*=sign*exp(common);
+	};
+}
+
+//	qTheta(), qTet(), qTetOnThetas(), qSixJ()
+//	=========================================
+
+FACTfloat qTheta(QTable *t, int lane, int a, int b, int c)
+{
+double result;
+qThetaLanes(t,lane,1,a,b,c,&result);
+return result;
+}
+
+TETfloat qTet(QTable *t, int lane, int a, int b, int c, int d, int e, int f)
+{
+double result, peak;
+qTetLanes(t,lane,1,a,b,c,d,e,f,NULL,NULL,&result,&peak);
+return result;
+}
+
+TETfloat qTetOnThetas(QTable *t, int lane, int a, int b, int c, int d, int e, int f,
+	int twoJ1a, int twoJ2a, int twoJ3a, int twoJ1b, int twoJ2b, int twoJ3b)
+{
+int twoJa[3]={twoJ1a,twoJ2a,twoJ3a}, twoJb[3]={twoJ1b,twoJ2b,twoJ3b};
+double result, peak;
+qTetLanes(t,lane,1,a,b,c,d,e,f,twoJa,twoJb,&result,&peak);
+return result;
+}
+
+//	As sixJ(), the tet Tet[j1 j2 j6; j4 j5 j3] over the square root of the
+//	absolute value of its four thetas
+
+SIXJfloat qSixJ(QTable *t, int lane, int twoJ1, int twoJ2, int twoJ3, int twoJ4,
+	int twoJ5, int twoJ6)
+{
+if (!(triad(twoJ1,twoJ2,twoJ3) && triad(twoJ1,twoJ5,twoJ6) &&
+	triad(twoJ4,twoJ2,twoJ6) && triad(twoJ4,twoJ5,twoJ3))) return 0.0;
+double thetas=qTheta(t,lane,twoJ1,twoJ2,twoJ3)*qTheta(t,lane,twoJ1,twoJ5,twoJ6)*
+	qTheta(t,lane,twoJ4,twoJ2,twoJ6)*qTheta(t,lane,twoJ4,twoJ5,twoJ3);
+if (thetas==0.0) return 0.0;
+return qTet(t,lane,twoJ1,twoJ2,twoJ4,twoJ5,twoJ6,twoJ3)/sqrt(fabs(thetas));
+}
+
+//	qTenJRange() computes a 10j symbol for the lanes lane0 to lane0+n-1, into
+//	values[], by the same sum as tenJ(), with [m+1] and [c+1] in place of m+1
+//	and c+1, and each term multiplied by the real part of the twists.
+
+static void qTenJRange(QTable *t, int lane0, int n, int *twoJ1, int *twoJ2,
+	TENJfloat *values)
+{
+for (int k=0;k<n;k++) values[k]=0.0;
+int biggest=0;
+for (int i=0;i<5;i++) biggest=max(biggest,max(twoJ1[i],twoJ2[i]));
+if (8*biggest+8>t->maxN)
+	{
+	printf("qTenJ() was given 2j = %d, beyond the table's %d\n",biggest,(t->maxN-8)/8);
+	return;
+	};
+
+TenJSetup s;
+tenJSetup(twoJ1,twoJ2,&s);
+int nq=t->nq;
+const double *qInt=&t->qInt[lane0];
+std::vector<double> M[5], v0, v1, peak(n), tr(n), row(n);
+
+for (int m1=s.mLow;m1<=s.mHigh;m1+=2)
+for (int m2=s.mLow;m2<=m1;m2+=2)
+	{
+	int LL[5], dim[5], lowDim;
+	if (!tenJLimits(&s,m1,m2,LL,dim,lowDim)) continue;
+
+	//	The matrices, with row i for c_{k+1}, column j for c_k, and the lanes
+	//	innermost
+
+	int big=0;
+	for (int k=0;k<5;k++)
+		{
+		int kp1=(k+1)%5, d1=dim[kp1], d2=dim[k];
+		int j1=twoJ1[k], j1p=twoJ1[mod5(k+1)];
+		int j2=twoJ2[k], j2m=twoJ2[mod5(k-1)], j2p=twoJ2[mod5(k+1)];
+		M[k].resize(d1*d2*n);
+		if (d2>big) big=d2;
+		for (int i=0;i<d1;i++)
+			{
+			int ckp=LL[kp1]+2*i;
+			int thetaA1[3]={j2,ckp,m1}, thetaA2[3]={j2m,ckp,j1};
+			int thetaB1[3]={j2,ckp,m2}, thetaB2[3]={j2p,ckp,j1p};
+			for (int j=0;j<d2;j++)
+				{
+				int ck=LL[k]+2*j;
+				double *out=&M[k][(i*d2+j)*n];
+				qTetLanes(t,lane0,n,ck,j2,ckp,j2m,m1,j1,thetaA1,thetaA2,out,&peak[0]);
+				qTetLanes(t,lane0,n,ck,j2,ckp,j2m,m2,j1,thetaB1,thetaB2,&row[0],&peak[0]);
+				for (int q=0;q<n;q++) out[q]*=qInt[(ckp+1)*nq+q]*row[q];
+				};
+			};
+		};
+
+	//	The trace of their product, for every lane at once
+
+	v0.resize(big*n);
+	v1.resize(big*n);
+	for (int q=0;q<n;q++) tr[q]=0.0;
+	int d0=dim[lowDim], dNext=dim[mod5(lowDim+1)];
+	for (int l0=0;l0<d0;l0++)
+		{
+		for (int i=0;i<dNext;i++)
+			for (int q=0;q<n;q++) v0[i*n+q]=M[lowDim][(i*d0+l0)*n+q];
+		double *vIn=&v0[0], *vOut=&v1[0], *tmp;
+		for (int k=1;k<=4;k++)
+			{
+			int ks=mod5(lowDim+k), dIn=dim[ks], dOut=dim[mod5(lowDim+k+1)];
+			int iLo=k==4 ? l0 : 0, iHi=k==4 ? l0+1 : dOut;
+			for (int i=iLo;i<iHi;i++)
+				{
+				double *vs=k==4 ? &tr[0] : vOut+i*n;
+				if (k!=4) for (int q=0;q<n;q++) vs[q]=0.0;
+				for (int j=0;j<dIn;j++)
+					{
+					const double *mij=&M[ks][(i*dIn+j)*n], *vj=vIn+j*n;
+					for (int q=0;q<n;q++) vs[q]+=mij[q]*vj[q];
+					};
+				};
+			tmp=vIn;
+			vIn=vOut;
+			vOut=tmp;
+			};
+		};
+
+	//	The term in the sum over the m's
+
+	double sign=(s.overallParity-(m1+m2)/2)%2==0 ? 1.0 : -1.0;
+	if (m1!=m2) sign*=2.0;
+	double twists=(m1*(m1+2)-m2*(m2+2))/4.0;
+	for (int q=0;q<n;q++)
+		{
+		QParameter &p=t->q[lane0+q];
+		double twist=p.r!=0 ? cos(pi*twists/p.r) : cosh(log(p.q)*twists);
+		values[q]+=sign*twist*qInt[(m1+1)*nq+q]*qInt[(m2+1)*nq+q]*tr[q];
+		};
+	};
+}
+
+//	qTenJ(), qTenJLanes()
+//	=====================
+
+TENJfloat qTenJ(QTable *t, int lane, int *twoJ1, int *twoJ2)
+{
+TENJfloat result;
+qTenJRange(t,lane,1,twoJ1,twoJ2,&result);
+return result;
+}
+
+void qTenJLanes(QTable *t, int *twoJ1, int *twoJ2, TENJfloat *values)
+{
+qTenJRange(t,0,t->nq,twoJ1,twoJ2,values);
+}
@@ -0,0 +1,105 @@
+/*
+
+quantumMain.cpp
+===============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a main program that scans a 10j symbol of SU_q(2) x SU_qbar(2)
+over the roots of unity q = exp(i pi/r) for a range of r, with qTenJLanes().
+
+	10jq <rMin> <rMax> <twoJ1[0..4]> <twoJ2[0..4]>
+
+It prints the symbol for each r, and for q = 1 compared with tenJ(); the time
+taken for all of them at once, against separate calls to qTenJ(); and the largest
+change in the symbols when the vertices of the 4-simplex are relabelled by a
+transposition and by a 5-cycle, which generate all 120 relabellings.
+
+*/
+
+#include <vector>
+#include "spin.h"
+
+void usage()
+{
+printf("usage:\t10jq <rMin> <rMax> <twoJ1[0..4]> <twoJ2[0..4]>\n");
+exit(2);
+}
+
+//	Relabel the vertices of the 4-simplex by vertex i -> perm[i]; twoJ1[i] is the
+//	edge (i,i+1) and twoJ2[i] the edge (i,i+2)
+
+static void relabel(int *perm, int *twoJ1, int *twoJ2, int *new1, int *new2)
+{
+for (int i=0;i<5;i++)
+	for (int step=1;step<=2;step++)
+		{
+		int a=perm[i], b=perm[mod5(i+step)], spin=step==1 ? twoJ1[i] : twoJ2[i];
+		if (mod5(b-a)==1) new1[a]=spin;
+		else if (mod5(a-b)==1) new1[b]=spin;
+		else if (mod5(b-a)==2) new2[a]=spin;
+		else new2[b]=spin;
+		};
+}
+
+int main(int argc, char **argv)
+{
+if (argc!=13) usage();
+int rMin=atoi(argv[1]), rMax=atoi(argv[2]);
+int twoJ1[5], twoJ2[5], biggest=0;
+for (int i=0;i<5;i++)
+	{
+	twoJ1[i]=atoi(argv[3+i]);
+	twoJ2[i]=atoi(argv[8+i]);
+	biggest=max(biggest,max(twoJ1[i],twoJ2[i]));
+	};
+if (rMin<3 || rMax<rMin) usage();
+
+//	One lane for each r, and one for q = 1
+
+int nq=rMax-rMin+2;
+std::vector<QParameter> q(nq);
+for (int k=0;k<nq-1;k++)
+	{
+	q[k].r=rMin+k;
+	q[k].q=0.0;
+	};
+q[nq-1].r=0;
+q[nq-1].q=1.0;
+QTable *t=newQTable(nq,&q[0],biggest);
+if (t==NULL) return 1;
+
+std::vector<TENJfloat> values(nq), single(nq);
+clock_t c0=clock();
+qTenJLanes(t,twoJ1,twoJ2,&values[0]);
+double tLanes=(clock()-c0)/(double)CLOCKS_PER_SEC;
+c0=clock();
+for (int k=0;k<nq;k++) single[k]=qTenJ(t,k,twoJ1,twoJ2);
+double tSingle=(clock()-c0)/(double)CLOCKS_PER_SEC;
+
+for (int k=0;k<nq-1;k++) printf("r = %4d %24.17g\n",q[k].r,(double)values[k]);
+TENJfloat classical=tenJ(twoJ1,twoJ2);
+printf("q = 1    %24.17g, tenJ() %24.17g\n",(double)values[nq-1],(double)classical);
+double laneError=0.0;
+for (int k=0;k<nq;k++) laneError=max(laneError,fabs(values[k]-single[k]));
+printf("%d values in %.3f seconds, against %.3f seconds one at a time (largest difference %.3g)\n",
+	nq,tLanes,tSingle,laneError);
+
+//	Symmetries
+
+int perms[2][5]={{1,0,2,3,4},{1,2,3,4,0}};
+double worst=0.0;
+for (int p=0;p<2;p++)
+	{
+	int new1[5], new2[5];
+	std::vector<TENJfloat> relabelled(nq);
+	relabel(perms[p],twoJ1,twoJ2,new1,new2);
+	qTenJLanes(t,new1,new2,&relabelled[0]);
+	for (int k=0;k<nq;k++)
+		worst=max(worst,fabs(relabelled[k]-values[k])/(fabs(values[k])+1e-300));
+	};
+printf("Largest relative change under relabelling: %.3g\n",worst);
+deleteQTable(t);
+return 0;
+}
@@ -0,0 +1,398 @@
+/*
+
+serverMain.cpp
+==============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a main program, 10jd, that serves thetas, tets, 6j and 10j
+symbols to other processes on the same machine over a Unix domain socket, so that
+short-lived jobs share one set of warm caches instead of each building its own.
+
+	10jd [-t threads] [-b batch] [-m entries] [-j maxTwoJ] [socket]
+
+The socket (default TENJ_DEFAULT_SOCKET, in tenj.h) is created when the server
+starts and removed when it is stopped by SIGINT or SIGTERM; a stale one left by a
+server that was killed is replaced.  The protocol is described in tenj.h, and
+tenjclient.cpp implements the client side.
+
+Every value computed is kept in a table shared by all the clients, keyed by the
+kind and the spins, up to "entries" values (default 1000000); after that new
+values are still computed and returned, but not kept.  A record already in the
+table is answered at once.  A record being computed for another client is not
+computed again:  the client waits for the same entry, so concurrent identical
+requests cost one computation.  Other records are queued for the worker threads
+(default: one for each processor), which keep the package's factorial and
+coefficient matrix caches for the life of the server.  The new records of each
+query are queued in order of the time tenJPlan() predicts for them, largest
+first, so that the slowest 10j symbols are started first and the cheap records
+fill in behind them; the values are still returned in the order of the query.
+Each worker takes up to "batch" records (default 64) from the queue at once,
+stopping after the first 10j symbol, so cheap records are handed out in batches
+and expensive ones alone.
+
+Spins above maxTwoJ (default 1000) in thetas, tets and 6j symbols, negative
+spins, unknown kinds, and 10j symbols too large for tenJ.cpp give NaN; thetas and
+tets with a triad that is not admissible give 0, as 6j symbols do.
+
+A record of kind TENJ_STATS returns, according to its first value, the number of
+records received (0), answered from the table (1), coalesced with a computation
+already under way (2), computed (3), batches taken by the workers (4), or values
+in the table (5).
+
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "spin.h"
+#include "tenj.h"
+
+void usage()
+{
+printf("usage:\t10jd [-t threads] [-b batch] [-m entries] [-j maxTwoJ] [socket]\n");
+exit(2);
+}
+
+//	Records, and the shared table of their values
+
+struct Key
+	{
+	int32_t kind, twoJ[10];
+	bool operator==(const Key &k) const {return memcmp(this,&k,sizeof(Key))==0;}
+	};
+
+struct KeyHash
+	{
+	size_t operator()(const Key &k) const
+		{
+		const unsigned char *p=(const unsigned char *)&k;
+		size_t h=14695981039346656037ULL;
+		for (size_t i=0;i<sizeof(Key);i++) h=(h^p[i])*1099511628211ULL;
+		return h;
+		}
+	};
+
+struct Entry
+	{
+	double value;
+	bool done;
+	};
+
+typedef std::shared_ptr<Entry> EntryPointer;
+
+static std::unordered_map<Key,EntryPointer,KeyHash> table;
+static std::deque<std::pair<Key,EntryPointer>> queue;
+static std::mutex lock;
+static std::condition_variable queued, computed;
+
+static int batch=64, maxTwoJ=1000;
+static size_t maxEntries=1000000;
+static std::atomic<long long> nRecords(0), nHits(0), nCoalesced(0), nComputed(0), nBatches(0);
+
+static const char *socketPath=TENJ_DEFAULT_SOCKET;
+
+//	Number of spins in each kind of record
+
+static const int nSpins[5]={1,3,6,6,10};
+
+static bool triad(int a, int b, int c)
+{
+return (a+b+c)%2==0 && a<=b+c && b<=a+c && c<=a+b;
+}
+
+//	Compute the value of one record
+
+static double compute(const Key &k)
+{
+const int32_t *j=k.twoJ;
+if (k.kind==TENJ_TENJ)
+	{
+	double value;
+	tenj_tenj(NULL,j,&value);
+	return value;
+	};
+for (int i=0;i<nSpins[k.kind];i++) if (j[i]>maxTwoJ) return NAN;
+switch (k.kind)
+	{
+	case TENJ_THETA:
+		return triad(j[0],j[1],j[2]) ? tenj_theta(j[0],j[1],j[2]) : 0.0;
+	case TENJ_TET:
+		return triad(j[0],j[1],j[5]) && triad(j[1],j[2],j[4]) && triad(j[2],j[3],j[5]) &&
+			triad(j[0],j[3],j[4]) ? tenj_tet(j[0],j[1],j[2],j[3],j[4],j[5]) : 0.0;
+	default:
+		return tenj_sixj(j[0],j[1],j[2],j[3],j[4],j[5]);
+	};
+}
+
+//	The time tenJPlan() predicts for a record, which is 0 for anything but a 10j
+//	symbol that tenJ() can compute
+
+static double cost(const int32_t *record)
+{
+if (record[0]!=TENJ_TENJ) return 0.0;
+int twoJ1[5], twoJ2[5];
+for (int i=0;i<5;i++)
+	{
+	twoJ1[i]=record[1+i];
+	twoJ2[i]=record[6+i];
+	if (twoJ1[i]<0 || twoJ2[i]<0) return 0.0;
+	};
+TenJPlan plan;
+tenJPlan(twoJ1,twoJ2,&plan);
+return plan.admissible ? plan.seconds : 0.0;
+}
+
+//	worker() takes batches of records from the queue, computes them, and wakes
+//	the clients waiting for them
+
+static void worker()
+{
+std::vector<std::pair<Key,EntryPointer>> mine;
+std::vector<double> values;
+while (true)
+	{
+	{
+	std::unique_lock<std::mutex> guard(lock);
+	queued.wait(guard,[]{return !queue.empty();});
+	mine.clear();
+	while (!queue.empty() && (int)mine.size()<batch)
+		{
+		mine.push_back(queue.front());
+		queue.pop_front();
+		if (mine.back().first.kind==TENJ_TENJ) break;
+		};
+	}
+	values.resize(mine.size());
+	for (size_t i=0;i<mine.size();i++) values[i]=compute(mine[i].first);
+
+	{
+	std::lock_guard<std::mutex> guard(lock);
+	for (size_t i=0;i<mine.size();i++)
+		{
+		mine[i].second->value=values[i];
+		mine[i].second->done=true;
+		if (table.size()>maxEntries)
+			{
+			auto e=table.find(mine[i].first);
+			if (e!=table.end() && e->second==mine[i].second) table.erase(e);
+			};
+		};
+	}
+	nComputed+=mine.size();
+	nBatches++;
+	computed.notify_all();
+	};
+}
+
+//	Send or receive exactly size bytes
+
+static bool sendAll(int fd, const void *buffer, size_t size)
+{
+const char *p=(const char *)buffer;
+while (size>0)
+	{
+	ssize_t k=send(fd,p,size,MSG_NOSIGNAL);
+	if (k<0 && errno==EINTR) continue;
+	if (k<=0) return false;
+	p+=k;
+	size-=k;
+	};
+return true;
+}
+
+static bool receiveAll(int fd, void *buffer, size_t size)
+{
+char *p=(char *)buffer;
+while (size>0)
+	{
+	ssize_t k=recv(fd,p,size,0);
+	if (k<0 && errno==EINTR) continue;
+	if (k<=0) return false;
+	p+=k;
+	size-=k;
+	};
+return true;
+}
+
+//	serve() answers the queries on one connection until the client hangs up
+
+static void serve(int fd)
+{
+const uint32_t maxRecords=1<<20;
+std::vector<int32_t> request;
+std::vector<EntryPointer> entries;
+std::vector<double> values, costs;
+std::vector<uint32_t> fresh;
+std::vector<Key> keys;
+uint32_t n;
+while (receiveAll(fd,&n,sizeof(n)) && n<=maxRecords)
+	{
+	request.resize(11*(size_t)n);
+	if (n>0 && !receiveAll(fd,&request[0],request.size()*sizeof(int32_t))) break;
+	entries.assign(n,EntryPointer());
+	values.assign(n,NAN);
+	costs.resize(n);
+	for (uint32_t r=0;r<n;r++) costs[r]=cost(&request[11*r]);
+	keys.resize(n);
+	fresh.clear();
+	nRecords+=n;
+
+	{
+	std::lock_guard<std::mutex> guard(lock);
+	for (uint32_t r=0;r<n;r++)
+		{
+		Key k;
+		memset(&k,0,sizeof(k));
+		k.kind=request[11*r];
+		if (k.kind<0 || k.kind>TENJ_TENJ) continue;
+		bool ok=true;
+		for (int i=0;i<nSpins[k.kind];i++)
+			{
+			k.twoJ[i]=request[11*r+1+i];
+			ok&=k.twoJ[i]>=0;
+			};
+		if (k.kind==TENJ_STATS)
+			{
+			long long counts[6]={nRecords,nHits,nCoalesced,nComputed,nBatches,(long long)table.size()};
+			if (ok && k.twoJ[0]<6) values[r]=(double)counts[k.twoJ[0]];
+			continue;
+			};
+		if (!ok) continue;
+
+		auto e=table.find(k);
+		if (e!=table.end())
+			{
+			if (e->second->done)
+				{
+				values[r]=e->second->value;
+				nHits++;
+				}
+			else
+				{
+				entries[r]=e->second;
+				nCoalesced++;
+				};
+			continue;
+			};
+		EntryPointer entry=std::make_shared<Entry>();
+		entry->done=false;
+		table[k]=entry;
+		entries[r]=entry;
+		keys[r]=k;
+		fresh.push_back(r);
+		};
+
+	//	Queue the new records, the most expensive first
+
+	std::stable_sort(fresh.begin(),fresh.end(),[&](uint32_t a, uint32_t b)
+		{return costs[a]>costs[b];});
+	for (size_t i=0;i<fresh.size();i++)
+		queue.push_back(std::make_pair(keys[fresh[i]],entries[fresh[i]]));
+	}
+	if (!fresh.empty()) queued.notify_all();
+
+	{
+	std::unique_lock<std::mutex> guard(lock);
+	for (uint32_t r=0;r<n;r++)
+		if (entries[r])
+			{
+			computed.wait(guard,[&]{return entries[r]->done;});
+			values[r]=entries[r]->value;
+			};
+	}
+	if (n>0 && !sendAll(fd,&values[0],n*sizeof(double))) break;
+	};
+close(fd);
+}
+
+static void stop(int)
+{
+unlink(socketPath);
+_exit(0);
+}
+
+int main(int argc, char **argv)
+{
+int nThreads=std::thread::hardware_concurrency();
+int a=1;
+for (;a<argc && argv[a][0]=='-';a+=2)
+	{
+	if (a+1>=argc || argv[a][2]!=0) usage();
+	switch (argv[a][1])
+		{
+		case 't': nThreads=atoi(argv[a+1]); break;
+		case 'b': batch=atoi(argv[a+1]); break;
+		case 'm': maxEntries=strtoull(argv[a+1],NULL,10); break;
+		case 'j': maxTwoJ=atoi(argv[a+1]); break;
+		default: usage();
+		};
+	};
+if (a<argc) socketPath=argv[a++];
+if (a<argc || batch<1 || maxTwoJ<0) usage();
+if (nThreads<1) nThreads=1;
+
+sockaddr_un address;
+if (strlen(socketPath)>=sizeof(address.sun_path))
+	{
+	printf("Socket path %s is too long\n",socketPath);
+	return 1;
+	};
+memset(&address,0,sizeof(address));
+address.sun_family=AF_UNIX;
+strcpy(address.sun_path,socketPath);
+
+//	Replace a stale socket, but not one a server is listening on
+
+tenj_client *other=tenj_client_connect(socketPath);
+if (other!=NULL)
+	{
+	tenj_client_close(other);
+	printf("A server is already listening on %s\n",socketPath);
+	return 1;
+	};
+unlink(socketPath);
+
+int listener=socket(AF_UNIX,SOCK_STREAM,0);
+if (listener<0 || bind(listener,(sockaddr *)&address,sizeof(address))<0 ||
+	listen(listener,64)<0)
+	{
+	printf("Could not listen on %s: %s\n",socketPath,strerror(errno));
+	return 1;
+	};
+signal(SIGPIPE,SIG_IGN);
+signal(SIGINT,stop);
+signal(SIGTERM,stop);
+
+for (int t=0;t<nThreads;t++) std::thread(worker).detach();
+printf("10jd: listening on %s with %d threads\n",socketPath,nThreads);
+fflush(stdout);
+
+while (true)
+	{
+	int fd=accept(listener,NULL,NULL);
+	if (fd<0)
+		{
+		if (errno==EINTR) continue;
+		printf("accept failed: %s\n",strerror(errno));
+		break;
+		};
+	std::thread(serve,fd).detach();
+	};
+unlink(socketPath);
+return 1;
+}
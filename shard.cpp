@@ -0,0 +1,223 @@
+/*
+
+shard.cpp
+=========
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains routines for splitting the computation of a single 10j symbol
+between several independent processes.
+
+The terms in the sum over m1, m2 computed by tenJ() are independent of each other,
+so the steps of that sum are dealt out, round robin, to nShards shards: shard s
+takes the steps numbered s, s+nShards, s+2*nShards, ... in the order used by
+tenJStepM().  Dealing the steps out like this, rather than giving each shard a
+contiguous block, evens out the work, since the matrices grow with m1.
+
+tenJShard(int *twoJ1, int *twoJ2, int shard, int nShards, TenJShard *result)
+computes one shard's partial sum.
+
+writeShard() and readShard() save and load a TenJShard as a small text file;
+the partial sum is written as a hexadecimal floating point number, so it is
+read back exactly.
+
+mergeShards(TenJShard *shards, int n, TENJfloat &result) checks that the n
+shards all belong to the same symbol and that every shard is present exactly
+once, then adds up the partial sums in order of shard number.
+
+*/
+
+#include "spin.h"
+
+//	tenJShard()
+//	===========
+
+bool tenJShard(int *twoJ1, int *twoJ2, int shard, int nShards, TenJShard *result)
+{
+if (nShards<1 || shard<0 || shard>=nShards)
+	{
+	printf("Shard %d of %d does not exist\n",shard,nShards);
+	return false;
+	};
+
+TenJSetup s;
+if (!tenJSetup(twoJ1,twoJ2,&s))
+	{
+	printf("Array size exceeded; recompile tenJ.cp with higher maxC\n");
+	return false;
+	};
+
+for (int i=0;i<5;i++)
+	{
+	result->twoJ1[i]=twoJ1[i];
+	result->twoJ2[i]=twoJ2[i];
+	};
+result->shard=shard;
+result->nShards=nShards;
+result->tSteps=s.nSteps;
+
+TenJWork *work=newTenJWork();
+TENJfloat sum=0.0;
+int nSteps=0;
+for (int step=shard;step<s.nSteps;step+=nShards)
+	{
+	int m1, m2;
+	tenJStepM(&s,step,m1,m2);
+	sum+=tenJTerm(&s,m1,m2,work);
+	nSteps++;
+	};
+deleteTenJWork(work);
+
+result->nSteps=nSteps;
+result->sum=sum;
+return true;
+}
+
+//	writeShard()
+//	============
+//
+//	The file is written under a temporary name and then renamed, so that a
+//	process killed part way through never leaves a truncated shard file behind.
+
+bool writeShard(const char *fileName, TenJShard *d)
+{
+char tmpName[1024];
+snprintf(tmpName,sizeof(tmpName),"%s.tmp",fileName);
+
+FILE *fp=fopen(tmpName,"w");
+if (fp==NULL)
+	{
+	printf("Cannot open shard file %s\n",tmpName);
+	return false;
+	};
+fprintf(fp,"10j shard 1\n");
+fprintf(fp,"twoJ1 %d %d %d %d %d\n",
+	d->twoJ1[0],d->twoJ1[1],d->twoJ1[2],d->twoJ1[3],d->twoJ1[4]);
+fprintf(fp,"twoJ2 %d %d %d %d %d\n",
+	d->twoJ2[0],d->twoJ2[1],d->twoJ2[2],d->twoJ2[3],d->twoJ2[4]);
+fprintf(fp,"shard %d of %d\n",d->shard,d->nShards);
+fprintf(fp,"steps %d of %d\n",d->nSteps,d->tSteps);
+fprintf(fp,"sum %La\n",(long double)d->sum);
+fprintf(fp,"value %.25Lg\n",(long double)d->sum);
+bool ok=(fclose(fp)==0);
+
+if (!ok || rename(tmpName,fileName)!=0)
+	{
+	printf("Cannot write shard file %s\n",fileName);
+	remove(tmpName);
+	return false;
+	};
+return true;
+}
+
+//	readShard()
+//	===========
+
+bool readShard(const char *fileName, TenJShard *d)
+{
+FILE *fp=fopen(fileName,"r");
+if (fp==NULL)
+	{
+	printf("Cannot open shard file %s\n",fileName);
+	return false;
+	};
+
+int version=0;
+char sum[128];
+bool ok=
+	fscanf(fp," 10j shard %d",&version)==1 && version==1 &&
+	fscanf(fp," twoJ1 %d %d %d %d %d",
+		&d->twoJ1[0],&d->twoJ1[1],&d->twoJ1[2],&d->twoJ1[3],&d->twoJ1[4])==5 &&
+	fscanf(fp," twoJ2 %d %d %d %d %d",
+		&d->twoJ2[0],&d->twoJ2[1],&d->twoJ2[2],&d->twoJ2[3],&d->twoJ2[4])==5 &&
+	fscanf(fp," shard %d of %d",&d->shard,&d->nShards)==2 &&
+	fscanf(fp," steps %d of %d",&d->nSteps,&d->tSteps)==2 &&
+	fscanf(fp," sum %127s",sum)==1;
+fclose(fp);
+
+if (!ok)
+	{
+	printf("Shard file %s is not in the expected format\n",fileName);
+	return false;
+	};
+d->sum=(TENJfloat)strtold(sum,NULL);
+return true;
+}
+
+//	mergeShards()
+//	=============
+
+bool mergeShards(TenJShard *shards, int n, TENJfloat &result)
+{
+if (n<1)
+	{
+	printf("No shards to merge\n");
+	return false;
+	};
+
+//	Check that all the shards are for the same symbol and the same split
+
+int nShards=shards[0].nShards, tSteps=shards[0].tSteps;
+for (int k=0;k<n;k++)
+	{
+	TenJShard *d=shards+k;
+	bool same=(d->nShards==nShards && d->tSteps==tSteps);
+	for (int i=0;i<5;i++)
+		same=same && d->twoJ1[i]==shards[0].twoJ1[i] && d->twoJ2[i]==shards[0].twoJ2[i];
+	if (!same)
+		{
+		printf("Shard %d does not belong to the same 10j symbol and split as shard %d\n",
+			d->shard,shards[0].shard);
+		return false;
+		};
+	if (d->shard<0 || d->shard>=nShards)
+		{
+		printf("Shard number %d is out of range for %d shards\n",d->shard,nShards);
+		return false;
+		};
+	};
+
+//	Every shard must be present exactly once
+
+int *which=new int[nShards];
+for (int s=0;s<nShards;s++) which[s]=-1;
+bool ok=true;
+for (int k=0;k<n && ok;k++)
+	{
+	int s=shards[k].shard;
+	if (which[s]>=0)
+		{
+		printf("Shard %d of %d is present more than once\n",s,nShards);
+		ok=false;
+		}
+	else which[s]=k;
+	};
+for (int s=0;s<nShards && ok;s++)
+	if (which[s]<0)
+		{
+		printf("Shard %d of %d is missing\n",s,nShards);
+		ok=false;
+		};
+
+//	Add the partial sums in order of shard number, so the result does not
+//	depend on the order in which the shards were listed
+
+int nSteps=0;
+TENJfloat sum=0.0;
+for (int s=0;s<nShards && ok;s++)
+	{
+	TenJShard *d=shards+which[s];
+	nSteps+=d->nSteps;
+	sum+=d->sum;
+	};
+if (ok && nSteps!=tSteps)
+	{
+	printf("Shards cover %d steps, but the sum has %d steps\n",nSteps,tSteps);
+	ok=false;
+	};
+
+delete [] which;
+if (ok) result=sum;
+return ok;
+}
@@ -0,0 +1,77 @@
+/*
+
+shardMain.cpp
+=============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a main program for computing a single 10j symbol in shards,
+with one process per shard, and for merging the shard files afterwards.
+
+	10jshard compute <shard> <nShards> <file> <twoJ1[0..4]> <twoJ2[0..4]>
+
+computes shard number <shard> (counting from 0) of <nShards>, and writes its
+partial sum to <file>.
+
+	10jshard merge <file> <file> ...
+
+checks that the files hold every shard of one symbol exactly once, and prints
+the value of the 10j symbol.
+
+*/
+
+#include <string.h>
+#include "spin.h"
+
+void usage()
+{
+printf("usage:\t10jshard compute <shard> <nShards> <file> <10 values of 2j>\n");
+printf("\t10jshard merge <file> ...\n");
+exit(2);
+}
+
+int main(int argc, char **argv)
+{
+if (argc<2) usage();
+
+if (strcmp(argv[1],"compute")==0)
+	{
+	if (argc!=15) usage();
+	int shard=atoi(argv[2]), nShards=atoi(argv[3]);
+	int twoJ1[5], twoJ2[5];
+	for (int i=0;i<5;i++)
+		{
+		twoJ1[i]=atoi(argv[5+i]);
+		twoJ2[i]=atoi(argv[10+i]);
+		};
+
+	TenJShard d;
+	if (!tenJShard(twoJ1,twoJ2,shard,nShards,&d)) return 1;
+	if (!writeShard(argv[4],&d)) return 1;
+	printf("Shard %d of %d: %d of %d steps, partial sum %.25Lg\n",
+		d.shard,d.nShards,d.nSteps,d.tSteps,(long double)d.sum);
+	return 0;
+	};
+
+if (strcmp(argv[1],"merge")==0)
+	{
+	int n=argc-2;
+	if (n<1) usage();
+	TenJShard *shards=new TenJShard[n];
+	for (int k=0;k<n;k++)
+		if (!readShard(argv[2+k],shards+k)) return 1;
+
+	TENJfloat result;
+	if (!mergeShards(shards,n,result)) return 1;
+	printf("{{%d,%d,%d,%d,%d},{%d,%d,%d,%d,%d}} %.25Lg\n",
+		shards[0].twoJ1[0],shards[0].twoJ1[1],shards[0].twoJ1[2],
+		shards[0].twoJ1[3],shards[0].twoJ1[4],
+		shards[0].twoJ2[0],shards[0].twoJ2[1],shards[0].twoJ2[2],
+		shards[0].twoJ2[3],shards[0].twoJ2[4],(long double)result);
+	delete [] shards;
+	return 0;
+	};
+
+usage();
+}
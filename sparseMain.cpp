@@ -0,0 +1,213 @@
+/*
+
+sparseMain.cpp
+==============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a main program that measures how much of the work in tenJ()'s
+coefficient matrices and traces the banded storage of tenJBand() eliminates.
+
+	10jsparse <twoJMax> [family ...]
+
+For each 2j from 1 to twoJMax it takes a symbol from each family named, or all of
+them:  "regular", every 2j the same; "wide", twoJ1[] = 2j and twoJ2[] = 2(2j), so
+that the c ranges are long; "narrow", twoJ1[] = 2(2j) and twoJ2[] = 2j; and
+"random", admissible spins up to 2j (the same ones on every run).  For each
+symbol it goes through the (m1, m2) steps of tenJ() and prints the number of
+matrix entries (each one a pair of tets), the percentage of them that are zero,
+the percentage left in the bands, the multiply-adds in the traces, and the
+percentage of them the banded trace leaves out, with the time taken by dense and
+banded traces.  The last column is the percentage of entries smaller than 1e-16
+times the largest in their matrix; these are kept, as dropping them would change
+the result, but they show how much a drop tolerance could remove.  The exit status
+is 1 if any banded sum differs from the dense one.
+
+*/
+
+#include <random>
+#include <vector>
+#include <string.h>
+#include "spin.h"
+
+void usage()
+{
+printf("usage:\t10jsparse <twoJMax> [regular|wide|narrow|random ...]\n");
+exit(2);
+}
+
+static const char *familyNames[4]={"regular","wide","narrow","random"};
+
+//	Do the spins pair off into admissible triples at every vertex?
+
+static bool admissibleTenJ(int *twoJ1, int *twoJ2)
+{
+TenJSetup s;
+tenJSetup(twoJ1,twoJ2,&s);
+for (int i=0;i<5;i++)
+	if (s.H[i]<s.L[i] || (twoJ1[i]+twoJ2[i]+twoJ1[mod5(i-1)]+twoJ2[mod5(i-2)])%2!=0)
+		return false;
+return true;
+}
+
+static double percent(double a, double b)
+{
+return b>0.0 ? 100.0*a/b : 0.0;
+}
+
+struct SparseCount
+	{
+	double entries, zeros, inBand, tiny;	//	Matrix entries
+	double dense, banded;					//	Multiply-adds in the traces
+	double denseSeconds, bandedSeconds;
+	bool same;								//	Banded sum equal to the dense one
+	};
+
+//	Go through the steps of one symbol, counting the entries and work
+
+static void countSymbol(int *twoJ1, int *twoJ2, SparseCount *c)
+{
+memset(c,0,sizeof(SparseCount));
+c->same=true;
+TenJSetup s;
+if (!tenJSetup(twoJ1,twoJ2,&s)) return;
+
+std::vector<TENJfloat> store[5];
+std::vector<int> loStore[5], hiStore[5];
+std::vector<TENJfloat> v0, v1;
+TENJfloat denseSum=0.0, bandedSum=0.0;
+for (int step=0;step<s.nSteps;step++)
+	{
+	int m1, m2, LL[5], dim[5], lowDim;
+	tenJStepM(&s,step,m1,m2);
+	if (!tenJLimits(&s,m1,m2,LL,dim,lowDim)) continue;
+
+	TENJfloat *M[5];
+	int stride[5], *lo[5], *hi[5], dMax=0;
+	for (int k=0;k<5;k++)
+		{
+		int rows=dim[mod5(k+1)], cols=dim[k];
+		if (cols>dMax) dMax=cols;
+		store[k].resize(rows*cols);
+		loStore[k].resize(rows);
+		hiStore[k].resize(rows);
+		M[k]=&store[k][0];
+		stride[k]=cols;
+		lo[k]=&loStore[k][0];
+		hi[k]=&hiStore[k][0];
+		tenJMatrix(&s,k,m1,m2,LL,dim,M[k],cols);
+		c->inBand+=tenJBand(M[k],cols,rows,cols,lo[k],hi[k]);
+
+		TENJfloat big=0.0;
+		for (int e=0;e<rows*cols;e++) if (fabs(M[k][e])>big) big=fabs(M[k][e]);
+		for (int e=0;e<rows*cols;e++)
+			{
+			if (M[k][e]==0.0) c->zeros++;
+			else if (fabs(M[k][e])<1e-16*big) c->tiny++;
+			};
+		c->entries+=rows*cols;
+		};
+	v0.resize(dMax);
+	v1.resize(dMax);
+
+	//	Multiply-adds, as counted by the loops of tenJTrace() and tenJTraceBanded()
+
+	int m4=mod5(lowDim+4);
+	for (int l0=0;l0<dim[lowDim];l0++)
+		{
+		c->dense+=dim[m4];
+		if (hi[m4][l0]<lo[m4][l0]) continue;
+		c->banded+=hi[m4][l0]-lo[m4][l0]+1;
+		for (int k=1;k<=3;k++)
+			{
+			int ks=mod5(lowDim+k);
+			for (int i=0;i<dim[mod5(lowDim+k+1)];i++)
+				if (hi[ks][i]>=lo[ks][i]) c->banded+=hi[ks][i]-lo[ks][i]+1;
+			};
+		};
+	for (int k=1;k<=3;k++)
+		{
+		int ks=mod5(lowDim+k);
+		c->dense+=(double)dim[lowDim]*dim[mod5(ks+1)]*dim[ks];
+		};
+
+	clock_t c0=clock();
+	denseSum+=tenJTrace(M,stride,dim,lowDim,&v0[0],&v1[0]);
+	clock_t c1=clock();
+	bandedSum+=tenJTraceBanded(M,stride,lo,hi,dim,lowDim,&v0[0],&v1[0]);
+	clock_t c2=clock();
+	c->denseSeconds+=(c1-c0)/(double)CLOCKS_PER_SEC;
+	c->bandedSeconds+=(c2-c1)/(double)CLOCKS_PER_SEC;
+	};
+c->same=denseSum==bandedSum;
+}
+
+int main(int argc, char **argv)
+{
+if (argc<2) usage();
+int twoJMax=atoi(argv[1]);
+if (twoJMax<1) usage();
+
+bool use[4]={argc==2,argc==2,argc==2,argc==2};
+for (int a=2;a<argc;a++)
+	{
+	int f=0;
+	while (f<4 && strcmp(argv[a],familyNames[f])!=0) f++;
+	if (f==4) usage();
+	use[f]=true;
+	};
+
+std::mt19937 rng(1);
+SparseCount total;
+memset(&total,0,sizeof(total));
+int nBad=0;
+
+printf("%-8s %4s %12s %7s %7s %14s %7s %9s %9s %7s\n","family","2j","entries","zero%",
+	"band%","multiply-adds","saved%","dense s","banded s","tiny%");
+for (int twoJ=1;twoJ<=twoJMax;twoJ++)
+	for (int f=0;f<4;f++)
+		{
+		if (!use[f]) continue;
+		int twoJ1[5], twoJ2[5];
+		for (int i=0;i<5;i++)
+			{
+			twoJ1[i]=f==2 ? 2*twoJ : twoJ;
+			twoJ2[i]=f==1 ? 2*twoJ : twoJ;
+			};
+		if (f==3) do
+			{
+			for (int i=0;i<5;i++)
+				{
+				twoJ1[i]=rng()%(twoJ+1);
+				twoJ2[i]=rng()%(twoJ+1);
+				};
+			}
+		while (!admissibleTenJ(twoJ1,twoJ2));
+
+		SparseCount c;
+		countSymbol(twoJ1,twoJ2,&c);
+		if (!c.same) nBad++;
+		printf("%-8s %4d %12.0f %7.2f %7.2f %14.0f %7.2f %9.4f %9.4f %7.2f%s\n",
+			familyNames[f],twoJ,c.entries,percent(c.zeros,c.entries),
+			percent(c.inBand,c.entries),c.dense,100.0-percent(c.banded,c.dense),
+			c.denseSeconds,c.bandedSeconds,percent(c.tiny,c.entries),
+			c.same ? "" : "  DIFFERENT");
+
+		total.entries+=c.entries;
+		total.zeros+=c.zeros;
+		total.inBand+=c.inBand;
+		total.tiny+=c.tiny;
+		total.dense+=c.dense;
+		total.banded+=c.banded;
+		total.denseSeconds+=c.denseSeconds;
+		total.bandedSeconds+=c.bandedSeconds;
+		};
+printf("%-8s %4s %12.0f %7.2f %7.2f %14.0f %7.2f %9.4f %9.4f %7.2f\n","total","",
+	total.entries,percent(total.zeros,total.entries),
+	percent(total.inBand,total.entries),total.dense,
+	100.0-percent(total.banded,total.dense),total.denseSeconds,total.bandedSeconds,
+	percent(total.tiny,total.entries));
+printf("%d banded sums differ from the dense ones\n",nBad);
+return nBad==0 ? 0 : 1;
+}
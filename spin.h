@@ -1 +1 @@
-/*spin.h======Author:		Greg EganDate:		24 September 2001Version:	1.0This header file contains options, includes, function declarations, and macrosfor the "tenJ" package.*///	OPTIONS://	--------//	Do we compute factorial ratios with floating point calculations, or//	with PrimePowers structures?#define USE_PRIME_POWERS true//	Define the floating point types to be used in various routines.//	These would normally be defined as either "double" or "long double".	//	* for factorial ratio calculations	typedef double FACTfloat;//	typedef long double FACTfloat;		//	* for tet network calculations		typedef double TETfloat;//	typedef long double TETfloat;		//	* for tenJ symbol calculations		typedef double TENJfloat;//	typedef long double TENJfloat;//	Do we compute tenJ symbols with separate tets and thetas, or do we//	merge the ratios into a single routine?#define MERGE_TET_THETA true//	INCLUDES://	---------//	Standard library routines#include <math.h>#include <stdio.h>#include <stdlib.h>#include <time.h>//	FUNCTION DECLARATIONS://	----------------------//	multiRatio() computes the product of several ratios of factorialsFACTfloat multiRatio(int *num, int *den, int size);//	theta() computes the unnormalised value of a theta netFACTfloat theta(int twoJ1, int twoJ2, int twoJ3);//	tet() computes the unnormalised value of a tetrahedral netTETfloat tet(int a, int b, int c, int d, int e, int f);//	tetOnThetas() computes a tet divided by two thetasTETfloat tetOnThetas(int a, int b, int c, int d, int e, int f,	int twoJ1a, int twoJ2a, int twoJ3a, int twoJ1b, int twoJ2b, int twoJ3b);//	tenJ() routines for general spins, regular spinsTENJfloat tenJ(int *twoJ1, int *twoJ2);TENJfloat tenJ(int twoJ);//	MACROS://	-------#define mod5(i) (i+5)%5#define min(a,b) ((a)<(b))?(a):(b)#define max(a,b) ((a)>(b))?(a):(b)#define abs(a) ((a)>=0)?(a):(-(a))
\ No newline at end of file
+/*spin.h======Author:		Greg EganDate:		24 September 2001Version:	1.0This header file contains options, includes, function declarations, and macrosfor the "tenJ" package.*///	OPTIONS://	--------//	Do we compute factorial ratios with floating point calculations, or//	with PrimePowers structures?#define USE_PRIME_POWERS true//	Define the floating point types to be used in various routines.//	These would normally be defined as either "double" or "long double".	//	* for factorial ratio calculations	typedef double FACTfloat;//	typedef long double FACTfloat;		//	* for tet network calculations		typedef double TETfloat;//	typedef long double TETfloat;		//	* for tenJ symbol calculations		typedef double TENJfloat;//	typedef long double TENJfloat;	//	* for 6j symbol calculations		typedef double SIXJfloat;//	typedef long double SIXJfloat;//	Do we compute tenJ symbols with separate tets and thetas, or do we//	merge the ratios into a single routine?#define MERGE_TET_THETA true//	Do we fill rows of tets in the tenJ coefficient matrices by recursion along//	the row, falling back to direct evaluation if the recursion loses precision?#define RECURSE_TET_ROWS true//	Up to what n do we take factorials from tables built by the compiler, rather//	than computing and caching them at run time?#define MAX_TABLE_FACTORIAL 64//	Maximum dimension of the coefficient matrices in tenJ(); tenJSetup() rejects//	symbols that need larger ones#define maxC 100//	INCLUDES://	---------//	Standard library routines#include <math.h>#include <stdio.h>#include <stdlib.h>#include <time.h>//	Floating point type with an extended exponent#include "XFloat.h"//	FUNCTION DECLARATIONS://	----------------------//	multiRatio() computes the product of several ratios of factorialsFACTfloat multiRatio(int *num, int *den, int size);XFloat multiRatioX(int *num, int *den, int size);//	factorialPowers() gives the powers of the primes in n!, for every n up to top,//	from the compiler's tables or a larger one kept by each thread.const int *factorialPowers(int top, int &stride, int &nPrimes, const int *&primes);//	theta() computes the unnormalised value of a theta netFACTfloat theta(int twoJ1, int twoJ2, int twoJ3);XFloat thetaX(int twoJ1, int twoJ2, int twoJ3);//	tet() computes the unnormalised value of a tetrahedral netTETfloat tet(int a, int b, int c, int d, int e, int f);XFloat tetX(int a, int b, int c, int d, int e, int f);//	tetOnThetas() computes a tet divided by two thetas, and tetOnThetasRow() the//	same for a row of values of its first argument, several at a time or, through//	tetOnThetasRecursion(), by recursion along the row; tetOnThetasRowX() gives the//	row relative to a power of 2, so it cannot overflowTETfloat tetOnThetas(int a, int b, int c, int d, int e, int f,	int twoJ1a, int twoJ2a, int twoJ3a, int twoJ1b, int twoJ2b, int twoJ3b);XFloat tetOnThetasX(int a, int b, int c, int d, int e, int f,	int twoJ1a, int twoJ2a, int twoJ3a, int twoJ1b, int twoJ2b, int twoJ3b);TETfloat tetOnRootThetas(int a, int b, int c, int d, int e, int f);void tetOnThetasRow(int n, int a0, int b, int c, int d, int e, int f,	int twoJ1a, int twoJ2a, int twoJ3a, int twoJ1b, int twoJ2b, int twoJ3b, TETfloat *out);bool tetOnThetasRecursion(int n, int a0, int b, int c, int d, int e, int f,	int twoJ1a, int twoJ2a, int twoJ3a, int twoJ1b, int twoJ2b, int twoJ3b, TETfloat *out);void tetOnThetasRowX(int n, int a0, int b, int c, int d, int e, int f,	int twoJ1a, int twoJ2a, int twoJ3a, int twoJ1b, int twoJ2b, int twoJ3b,	TETfloat *out, int &rowExp);//	sixJ() computes a normalised 6j symbol {j1 j2 j3; j4 j5 j6}, and sixJRow() all//	the symbols with given j2..j6, for every admissible j1, by recursion.SIXJfloat sixJ(int twoJ1, int twoJ2, int twoJ3, int twoJ4, int twoJ5, int twoJ6);int sixJRow(int twoJ2, int twoJ3, int twoJ4, int twoJ5, int twoJ6,	int &twoJ1Min, SIXJfloat *values);//	writeSixJTable() stores every 6j symbol with 2j <= maxTwoJ, once for each set//	related by tetrahedral and Regge symmetries; openSixJTable() maps such a file//	into memory for sixJTableLookup(), and makeSixJTable() builds one in memory.struct SixJTable	{	int maxTwoJ;				//	Largest 2j in the table	long long nValues;			//	Number of values stored	long long fileBytes;		//	Size of the mapped file	const char *map;			//	Start of the mapped file	const int *dirRow;			//	First row for each multiset of triad sums	const int *dirB1Min;		//	Smallest quadrilateral sum in those rows	const long long *rowValue;	//	First value in each row	const int *rowB2Min;		//	Second quadrilateral sum for that value	const SIXJfloat *values;	//	The symbols	};bool writeSixJTable(const char *fileName, int maxTwoJ, int nThreads);SixJTable *openSixJTable(const char *fileName);SixJTable *makeSixJTable(int maxTwoJ, int nThreads);SIXJfloat sixJTableLookup(SixJTable *table, int twoJ1, int twoJ2, int twoJ3,	int twoJ4, int twoJ5, int twoJ6);void closeSixJTable(SixJTable *table);//	tenJ() routines for general spins, regular spinsTENJfloat tenJ(int *twoJ1, int *twoJ2);TENJfloat tenJ(int twoJ);//	TenJSetup holds the data for a general 10j symbol that do not depend on the//	m's; the sum over m1, m2 can then be computed one term at a time, in any//	order, with tenJTerm().  TenJWork is the workspace tenJTerm() needs.  tenJBand()//	finds the band of nonzero columns in each row of a matrix, and tenJTraceBanded()//	skips the zeros outside it.struct TenJSetup	{	int twoJ1[5], twoJ2[5];		//	Double the spins on the edges	int L[5], H[5];				//	Limits on c_i, independent of m's	int mLow, mHigh;			//	Limits on m's	int overallParity;			//	m-independent part of the overall sign	int nSteps;					//	Number of pairs mLow<=m2<=m1<=mHigh	};struct TenJWork;bool tenJSetup(int *twoJ1, int *twoJ2, TenJSetup *setup);void tenJStepM(TenJSetup *setup, int step, int &m1, int &m2);TENJfloat tenJTerm(TenJSetup *setup, int m1, int m2, TenJWork *work);bool tenJLimits(TenJSetup *setup, int m1, int m2, int *LL, int *dim, int &lowDim);void tenJMatrix(TenJSetup *setup, int k, int m1, int m2, int *LL, int *dim,	TENJfloat *M, int stride);TENJfloat tenJTrace(TENJfloat **M, int *stride, int *dim, int lowDim,	TENJfloat *v0, TENJfloat *v1);long long tenJBand(TENJfloat *M, int stride, int rows, int cols, int *lo, int *hi);TENJfloat tenJTraceBanded(TENJfloat **M, int *stride, int **lo, int **hi, int *dim,	int lowDim, TENJfloat *v0, TENJfloat *v1);TenJWork *newTenJWork();void deleteTenJWork(TenJWork *work);//	TenJIncremental keeps the matrices of a 10j symbol for every pair of m's, so//	that when one spin is changed only the matrices and traces it affects are//	recomputed; tenJVaryEdge() uses it to compute a symbol for a range of one spin.struct TenJIncremental;TenJIncremental *newTenJIncremental(int *twoJ1, int *twoJ2);void deleteTenJIncremental(TenJIncremental *inc);TENJfloat tenJIncrementalValue(TenJIncremental *inc);TENJfloat tenJIncrementalSet(TenJIncremental *inc, int edge, int twoJ);void tenJIncrementalInfo(TenJIncremental *inc, long long &computed, long long &reused);int tenJVaryEdge(int *twoJ1, int *twoJ2, int edge, int twoJMin, int twoJMax,	TENJfloat *values);//	tenJEngine() computes a 10j symbol by one of N_TENJ_ENGINES algorithms, named in//	tenJEngineNames[], for comparing them; workBytes is set to the largest amount of//	working storage the engine used.#define N_TENJ_ENGINES 6extern const char *tenJEngineNames[N_TENJ_ENGINES];int tenJEngineNumber(const char *name);TENJfloat tenJEngine(int engine, int *twoJ1, int *twoJ2, double &workBytes);//	QTable holds quantum factorials for several values of q, each a root of unity//	exp(i pi/r) with r >= 3, or a real q > 0 with r = 0; the q routines are the//	SU_q(2) versions of theta(), tet(), tetOnThetas(), sixJ() and tenJ() for the//	q in one lane of the table, and qTenJLanes() computes a 10j symbol for all of//	them at once.struct QParameter	{	int r;						//	q = exp(i pi/r), or 0 for a real q	double q;					//	The real q, if r = 0	};struct QTable;QTable *newQTable(int nq, QParameter *q, int maxTwoJ);void deleteQTable(QTable *t);FACTfloat qTheta(QTable *t, int lane, int a, int b, int c);TETfloat qTet(QTable *t, int lane, int a, int b, int c, int d, int e, int f);TETfloat qTetOnThetas(QTable *t, int lane, int a, int b, int c, int d, int e, int f,	int twoJ1a, int twoJ2a, int twoJ3a, int twoJ1b, int twoJ2b, int twoJ3b);SIXJfloat qSixJ(QTable *t, int lane, int twoJ1, int twoJ2, int twoJ3, int twoJ4,	int twoJ5, int twoJ6);TENJfloat qTenJ(QTable *t, int lane, int *twoJ1, int *twoJ2);void qTenJLanes(QTable *t, int *twoJ1, int *twoJ2, TENJfloat *values);//	spinNetwork() evaluates a closed trivalent spin network, given by the edges at//	each vertex in anticlockwise order, by recoupling moves, keeping the value of//	every connected piece that needs a sum in a SpinNetworkCache.struct SpinNetworkCache;struct SpinNetworkInfo	{	long long moves;			//	Number of F moves made	long long terms;			//	Number of terms in their sums	long long hits;				//	Pieces found in the cache	int depth;					//	Deepest nesting of sums	};SpinNetworkCache *newSpinNetworkCache();void deleteSpinNetworkCache(SpinNetworkCache *cache);TETfloat spinNetwork(int nVertices, const int *vertexEdges, const int *twoJ,	SpinNetworkCache *cache, SpinNetworkInfo *info);//	tenJX() and tenJTermX() are versions of tenJ() and tenJTerm() whose results,//	and intermediate values, have an extended exponent and cannot overflow; their//	matrices are sized to the symbol, with no limit maxC.XFloat tenJX(int *twoJ1, int *twoJ2);XFloat tenJTermX(TenJSetup *setup, int m1, int m2, TenJWork *work);//	tenJShard() computes the part of the sum over m1, m2 belonging to one of//	nShards shards; the shards can be computed by separate processes, saved with//	writeShard() and combined by mergeShards().struct TenJShard	{	int twoJ1[5], twoJ2[5];		//	Double the spins on the edges	int shard, nShards;			//	Which shard this is, out of how many	int nSteps, tSteps;			//	Steps in this shard, in the whole sum	TENJfloat sum;				//	Partial sum over the steps in this shard	};bool tenJShard(int *twoJ1, int *twoJ2, int shard, int nShards, TenJShard *result);bool writeShard(const char *fileName, TenJShard *data);bool readShard(const char *fileName, TenJShard *data);bool mergeShards(TenJShard *shards, int n, TENJfloat &result);//	tenJPlan() predicts the work and memory tenJ() needs for a 10j symbol, in//	O(j^2) operations; tenJAdmit() checks a plan against limits, and//	calibrateTenJPlan() fits the time model to a short benchmark.struct TenJPlan	{	bool admissible;			//	False if the matrices would exceed maxC	double steps;				//	(m1, m2) steps contributing to the sum	double tets;				//	tet evaluations to fill the matrices	double flops;				//	Floating point operations in the traces	double matrixBytes;			//	Peak matrix storage for a single step	double seconds;				//	Predicted running time	};void tenJPlan(int *twoJ1, int *twoJ2, TenJPlan *plan);bool tenJAdmit(TenJPlan *plan, double maxSeconds, double maxBytes);bool calibrateTenJPlan();//	tenJThreads() computes a general 10j symbol with the sum over m1, m2 shared//	between several threads; if reproducible is true, the result is the same, bit//	for bit, for any number of threads.  Symbols too large for maxC give NaN.TENJfloat tenJThreads(int *twoJ1, int *twoJ2, int nThreads, bool reproducible);//	tenJAsymptoticFit() fits the large-spin behaviour of 10j symbols along the ray//	through a symbol, tenJAsymptotic() evaluates the fit at a multiple of the ray,//	and tenJAuto() chooses between it and tenJ() for a given relative tolerance,//	returning false if neither can meet it.struct TenJAsymptotic	{	int ray1[5], ray2[5];		//	Smallest symbol on the ray	int parity;					//	Parity of the multiples fitted	bool valid;					//	False if the ray could not be fitted	int nFit;					//	Number of exact values fitted	int kMax;					//	Largest multiple fitted	int sign;					//	Sign of the symbols on the ray	double c[4], c3[3];			//	Coefficients of four- and three-term fits	double holdError;			//	Relative error predicting the largest value	};bool tenJAsymptoticFit(int *twoJ1, int *twoJ2, double budget, TenJAsymptotic *fit);double tenJAsymptotic(TenJAsymptotic *fit, int k, double &error);bool tenJAuto(int *twoJ1, int *twoJ2, double tolerance, TENJfloat &value, bool &asymptotic);//	tenJExact() computes a 10j symbol exactly, as a fraction, by evaluating it modulo//	up to maxPrimes primes; tenJExactError() gives the relative error of an//	approximation to it, and freeTenJExact() frees the strings in the result.struct TenJExact	{	bool ok;					//	False if maxPrimes primes were not enough	int nPrimes;				//	Number of primes used	char *numerator;			//	Numerator, in decimal, with sign	char *denominator;			//	Positive denominator, in decimal	XFloat value;				//	Value of the fraction	};bool tenJExact(int *twoJ1, int *twoJ2, int maxPrimes, TenJExact *result);double tenJExactError(TenJExact *exact, TENJfloat approx);void freeTenJExact(TenJExact *exact);//	Triangulation describes a triangulated 4-manifold, as a simplicial complex given//	by the vertices of its 4-simplices; dfkrLogAmplitude() computes the amplitude//	of a spin foam on it in the DFKR version of the Barrett-Crane model, with the//	10j symbols from tenJCached(), which keeps every value it computes; a symbol//	too large for tenJ() gives NaN, and so does the amplitude.struct Triangulation	{	int nPent, nTriangles, nTets;	//	Numbers of 4-simplices, triangles, tets	int (*pentVertices)[5];			//	Vertex labels of each 4-simplex	int (*pentTriangles)[10];		//	Its triangles, in the order of tenJ()'s spins	int (*pentTets)[5];				//	Its tets, opposite each vertex	int (*triangleVertices)[3];		//	Vertex labels of each triangle	int (*tetVertices)[4];			//	Vertex labels of each tet	int (*tetTriangles)[4];			//	Its triangles, opposite each vertex	};bool makeTriangulation(int nPent, int (*vertices)[5], Triangulation *tri);bool makeSphere4(Triangulation *tri);bool readTriangulation(const char *fileName, Triangulation *tri);void freeTriangulation(Triangulation *tri);int fourJ(int twoJ1, int twoJ2, int twoJ3, int twoJ4);TENJfloat tenJCached(int *twoJ1, int *twoJ2);void tenJCacheInfo(long long &entries, long long &hits, long long &misses);double dfkrLogAmplitude(Triangulation *tri, int *twoJ, int &sign);//	partitionSum() adds up the amplitudes of every spin foam on a triangulation//	with all 2j <= maxTwoJ, searching the labellings with several threads.struct PartitionSum	{	XFloat z;					//	The partition function Z_J	long long nFoams;			//	Number of foams with nonzero amplitude	long long nNodes;			//	Number of partial labellings visited	long long nSteals;			//	Number of subtrees stolen by idle threads	double seconds;				//	Elapsed time	};bool partitionSum(Triangulation *tri, int maxTwoJ, int nThreads, double reportSeconds,	PartitionSum *result);//	foamMonteCarlo() estimates expectation values of observables of spin foams on a//	triangulation, with several Metropolis chains run in parallel.struct FoamObservable	{	const char *name;	double (*value)(Triangulation *tri, int *twoJ);	};struct MonteCarloEstimate	{	double mean;				//	Estimate of <O>	double error;				//	Its standard error, from the batch means	double tau;					//	Integrated autocorrelation time of O, in sweeps	};bool foamMonteCarlo(Triangulation *tri, int *startTwoJ, int maxTwoJ, int nChains,	int nThreads, unsigned long long seed, int burnIn, int batchSweeps, int nBatches,	int nObservables, FoamObservable *observables, MonteCarloEstimate *estimates,	bool report);double foamMeanSpin(Triangulation *tri, int *twoJ);double foamMeanArea(Triangulation *tri, int *twoJ);//	Complex is a triangulated 3- or 4-manifold built from Regina-style gluing tables,//	with the incidences of its top simplices, facets, codimension-2 faces (hinges)//	and vertices in flat arrays; the variable-length ones are in compressed sparse//	row form, the entries for hinge h being from hingeTopStart[h] to//	hingeTopStart[h+1]-1, and so on.  complexTriangulation() and//	triangulationComplex() convert between a 4-dimensional Complex and a//	Triangulation, with the same numbering of simplices, tets and triangles.struct Complex	{	int dim;						//	3 or 4	int nTop, nFacets, nHinges, nVertices;	int *topVertices;				//	Vertices of each top simplex, dim+1 each	int *topFacets;					//	Its facets, opposite each vertex	int *topHinges;					//	Its hinges, in the order of sixJ() or tenJ()	int *facetTops;					//	Simplices on each side of a facet, 2 each	int *facetHinges;				//	Hinges of each facet, dim each	int *hingeTopStart, *hingeTops;		//	Simplices around each hinge, in order	int *hingeFacetStart, *hingeFacets;	//	Facets around each hinge, in order	int *vertexTopStart, *vertexTops;	//	Simplices containing each vertex	};bool makeComplex(int dim, int nTop, const int *adjacencies, const int *gluings, Complex *c);bool makeSphereComplex(int dim, Complex *c);void freeComplex(Complex *c);bool complexTriangulation(Complex *c, Triangulation *tri);bool triangulationComplex(Triangulation *tri, Complex *c);//	stateSum() evaluates the Ponzano-Regge or Turaev-Viro state sum on a 3-dimensional//	Complex with all 2j <= maxTwoJ, contracting it as a tensor network over the edges.struct StateSum	{	double z;					//	The state sum	int width;					//	Most edges on any intermediate tensor	double peakBytes;			//	Most memory those tensors held at once	double terms;				//	Number of products formed	double seconds;				//	Elapsed time	};bool stateSum(Complex *c, int maxTwoJ, const int *fixedTwoJ, SixJTable *table,	QTable *q, int lane, double maxBytes, int nThreads, StateSum *result);//	MACROS://	-------#define mod5(i) (i+5)%5#define min(a,b) ((a)<(b))?(a):(b)#define max(a,b) ((a)>(b))?(a):(b)#define abs(a) ((a)>=0)?(a):(-(a))
\ No newline at end of file
@@ -0,0 +1,450 @@
+/*
+
+statesum.cpp
+============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a routine that evaluates the Ponzano-Regge state sum, or the
+Turaev-Viro state sum, on a triangulated 3-manifold given as a Complex (see
+complex.cpp), with a cutoff on the spins:
+
+	Z = sum over labellings of the edges with 2j <= maxTwoJ of
+		prod over edges e of (-1)^(2j_e) (2j_e+1)
+		prod over triangles f of (-1)^(j_a+j_b+j_c)
+		prod over tets t of {6j}_t
+
+For Turaev-Viro, 2j_e+1 becomes the quantum integer [2j_e+1] and the 6j symbols
+are those of SU_q(2); the edge weight is in both cases the theta net theta(0,2j,2j)
+or qTheta().  The sum is returned unnormalised: the Turaev-Viro invariant is Z
+times w^(-2V), where V is the number of vertices and w^2 = sum of [2j+1]^2 over
+all the labels, provided maxTwoJ is r-2, so that no admissible label is left out.
+
+	bool stateSum(Complex *c, int maxTwoJ, const int *fixedTwoJ, SixJTable *table,
+		QTable *q, int lane, double maxBytes, int nThreads, StateSum *result)
+
+c must have dim 3.  If fixedTwoJ is not NULL, an edge h with fixedTwoJ[h] >= 0 is
+held at that 2j rather than summed, for boundary conditions or observables.  The
+6j symbols come from sixJTableLookup() on table, or if that is NULL and q is NULL,
+from a table that stateSum() builds for itself with makeSixJTable(); if q is not
+NULL they are qSixJ() for the given lane, kept in a hash table in each thread.
+
+Rather than visiting every labelling, the sum is contracted as a tensor network:
+each edge is an index taking maxTwoJ+1 values, and the edges, triangles and tets
+are tensors on one, three and six of them.  The indices are summed out one at a
+time; summing out an edge multiplies together every tensor that involves it and
+leaves a single new tensor on all their other edges, stored densely.  The cost is
+set by the order in which the edges are summed, and finding the best order is
+hard, so the order is chosen greedily, always summing next the edge that leaves
+the smallest new tensor, with ties broken at random over a number of trials; the
+order whose tensors take the least memory at once is kept.  If even that needs
+more than maxBytes, stateSum() prints a message and returns false before doing
+any arithmetic.  The tensors for the edges, triangles and tets are never stored:
+their entries are computed as they are needed, from the labels.
+
+Each new tensor is computed by nThreads threads, which take blocks of its entries
+from a shared counter; small ones are computed by a single thread.  result gets
+the sum, the most edges on any intermediate tensor, the most memory they held at
+once, the number of terms formed, and the time taken.
+
+*/
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <unordered_map>
+#include "spin.h"
+
+//	The number of random orders tried, after the one that breaks ties by number
+
+#define orderTrials 32
+
+//	Tensors with fewer terms than this are computed by one thread
+
+#define threadedTerms (1<<15)
+
+enum {edgeTensor, facetTensor, tetTensor, denseTensor};
+
+struct Tensor
+	{
+	int kind;
+	int index;					//	The edge, triangle or tet
+	std::vector<int> edges;		//	Its distinct edges, in increasing order
+	std::vector<long long> stride;	//	For a dense tensor, the stride of each
+	std::vector<double> values;
+	bool live;
+	};
+
+struct StateSumRun
+	{
+	Complex *c;
+	std::vector<int> base, dim;		//	The labels of edge h are base[h] .. base[h]+dim[h]-1
+	std::vector<double> edgeWeight;	//	theta(0,2j,2j) for each 2j up to the largest
+	SixJTable *table;
+	QTable *q;
+	int lane;
+	std::vector<Tensor> tensors;
+	};
+
+//	The per-thread state:  the current labels of all the edges, and the cache of
+//	q-deformed 6j symbols
+
+struct StateSumThread
+	{
+	std::vector<int> label;
+	std::unordered_map<unsigned long long,double> qCache;
+	};
+
+static bool triad(int a, int b, int c)
+{
+return (a+b+c)%2==0 && a<=b+c && b<=a+c && c<=a+b;
+}
+
+//	The entry of tensor t for the labels in w
+
+static inline double entry(StateSumRun &s, StateSumThread &w, Tensor &t)
+{
+const int *label=&w.label[0];
+switch (t.kind)
+	{
+	case edgeTensor:
+		return s.edgeWeight[label[t.index]];
+
+	case facetTensor:
+		{
+		const int *h=&s.c->facetHinges[3*t.index];
+		int a=label[h[0]], b=label[h[1]], c=label[h[2]];
+		if (!triad(a,b,c)) return 0.0;
+		return ((a+b+c)/2)%2==0 ? 1.0 : -1.0;
+		};
+
+	case tetTensor:
+		{
+		const int *h=&s.c->topHinges[6*t.index];
+		int j[6];
+		for (int i=0;i<6;i++) j[i]=label[h[i]];
+		if (s.q==NULL) return sixJTableLookup(s.table,j[0],j[1],j[2],j[3],j[4],j[5]);
+		unsigned long long key=0;
+		for (int i=0;i<6;i++) key=(key<<10)|j[i];
+		auto found=w.qCache.find(key);
+		if (found!=w.qCache.end()) return found->second;
+		double v=qSixJ(s.q,s.lane,j[0],j[1],j[2],j[3],j[4],j[5]);
+		w.qCache[key]=v;
+		return v;
+		};
+
+	default:
+		{
+		long long k=0;
+		for (size_t i=0;i<t.edges.size();i++)
+			k+=(label[t.edges[i]]-s.base[t.edges[i]])*t.stride[i];
+		return t.values[k];
+		};
+	};
+}
+
+//	The edges left after summing out edge e from the tensors in group
+
+static void mergedEdges(std::vector<const std::vector<int> *> &group, int e,
+	std::vector<int> &out)
+{
+out.clear();
+for (size_t g=0;g<group.size();g++)
+	for (size_t i=0;i<group[g]->size();i++)
+		{
+		int h=(*group[g])[i];
+		if (h!=e) out.push_back(h);
+		};
+std::sort(out.begin(),out.end());
+out.erase(std::unique(out.begin(),out.end()),out.end());
+}
+
+//	An order in which to sum out the edges, and what it costs
+
+struct SumOrder
+	{
+	std::vector<int> edges;
+	double peakBytes, terms;
+	int width;
+	};
+
+//	Greedy choice of the order:  sum out the edge that leaves the smallest tensor,
+//	breaking ties with rng, or by the lowest edge number if rng is NULL
+
+static void chooseOrder(StateSumRun &s, std::mt19937 *rng, SumOrder &order)
+{
+int nEdges=s.c->nHinges;
+std::vector<std::vector<int> > scopes;
+std::vector<bool> dense, live;
+for (size_t t=0;t<s.tensors.size();t++)
+	{
+	scopes.push_back(s.tensors[t].edges);
+	dense.push_back(false);
+	live.push_back(true);
+	};
+std::vector<bool> done(nEdges,false);
+std::vector<const std::vector<int> *> group;
+std::vector<int> merged;
+double liveBytes=0.0;
+order.edges.clear();
+order.peakBytes=order.terms=0.0;
+order.width=0;
+
+for (int step=0;step<nEdges;step++)
+	{
+	int best=-1, nTies=0;
+	double bestSize=0.0;
+	for (int e=0;e<nEdges;e++)
+		{
+		if (done[e]) continue;
+		group.clear();
+		for (size_t t=0;t<scopes.size();t++)
+			if (live[t] && std::binary_search(scopes[t].begin(),scopes[t].end(),e))
+				group.push_back(&scopes[t]);
+		mergedEdges(group,e,merged);
+		double size=1.0;
+		for (size_t i=0;i<merged.size();i++) size*=s.dim[merged[i]];
+		if (best<0 || size<bestSize)
+			{
+			best=e;
+			bestSize=size;
+			nTies=1;
+			}
+		else if (size==bestSize && rng!=NULL && (*rng)()%(++nTies)==0) best=e;
+		};
+
+	//	Sum out the chosen edge
+
+	int e=best;
+	group.clear();
+	double freed=0.0;
+	int nGroup=0;
+	for (size_t t=0;t<scopes.size();t++)
+		if (live[t] && std::binary_search(scopes[t].begin(),scopes[t].end(),e))
+			{
+			group.push_back(&scopes[t]);
+			nGroup++;
+			};
+	mergedEdges(group,e,merged);
+	for (size_t t=0;t<scopes.size();t++)
+		if (live[t] && std::binary_search(scopes[t].begin(),scopes[t].end(),e))
+			{
+			live[t]=false;
+			if (dense[t])
+				{
+				double size=sizeof(double);
+				for (size_t i=0;i<scopes[t].size();i++) size*=s.dim[scopes[t][i]];
+				freed+=size;
+				};
+			};
+	double bytes=bestSize*sizeof(double);
+	if (liveBytes+bytes>order.peakBytes) order.peakBytes=liveBytes+bytes;
+	liveBytes+=bytes-freed;
+	order.terms+=bestSize*s.dim[e]*nGroup;
+	if ((int)merged.size()>order.width) order.width=(int)merged.size();
+	scopes.push_back(merged);
+	dense.push_back(true);
+	live.push_back(true);
+	done[e]=true;
+	order.edges.push_back(e);
+	};
+}
+
+//	Sum out edge e:  multiply the tensors in group and leave the result in out
+
+static void sumOut(StateSumRun &s, int e, std::vector<int> &group, Tensor &out,
+	std::vector<StateSumThread> &threads)
+{
+std::vector<const std::vector<int> *> scopes;
+for (size_t g=0;g<group.size();g++) scopes.push_back(&s.tensors[group[g]].edges);
+mergedEdges(scopes,e,out.edges);
+int n=(int)out.edges.size();
+out.kind=denseTensor;
+out.index=-1;
+out.live=true;
+out.stride.resize(n);
+long long size=1;
+for (int i=n-1;i>=0;i--)
+	{
+	out.stride[i]=size;
+	size*=s.dim[out.edges[i]];
+	};
+out.values.assign(size,0.0);
+
+int nThreads=size*s.dim[e]*(long long)group.size()<threadedTerms ? 1 : (int)threads.size();
+long long block=size/(64*nThreads)+1;
+std::atomic<long long> next(0);
+auto work=[&](int id)
+	{
+	StateSumThread &w=threads[id];
+	int *label=&w.label[0];
+	for (long long k0=(next+=block)-block;k0<size;k0=(next+=block)-block)
+		{
+		long long k1=k0+block<size ? k0+block : size;
+		for (long long k=k0;k<k1;k++)
+			{
+			long long rest=k;
+			for (int i=n-1;i>=0;i--)
+				{
+				int h=out.edges[i];
+				label[h]=s.base[h]+(int)(rest%s.dim[h]);
+				rest/=s.dim[h];
+				};
+			double sum=0.0;
+			for (int x=0;x<s.dim[e];x++)
+				{
+				label[e]=s.base[e]+x;
+				double product=1.0;
+				for (size_t g=0;g<group.size() && product!=0.0;g++)
+					product*=entry(s,w,s.tensors[group[g]]);
+				sum+=product;
+				};
+			out.values[k]=sum;
+			};
+		};
+	};
+std::vector<std::thread> pool;
+for (int t=1;t<nThreads;t++) pool.push_back(std::thread(work,t));
+work(0);
+for (int t=1;t<nThreads;t++) pool[t-1].join();
+}
+
+//	stateSum()
+//	==========
+
+bool stateSum(Complex *c, int maxTwoJ, const int *fixedTwoJ, SixJTable *table,
+	QTable *q, int lane, double maxBytes, int nThreads, StateSum *result)
+{
+if (c->dim!=3 || maxTwoJ<0 || maxTwoJ>1023)
+	{
+	printf("stateSum() needs a 3-dimensional complex and 0 <= 2j <= 1023\n");
+	return false;
+	};
+if (nThreads<1) nThreads=1;
+auto t0=std::chrono::steady_clock::now();
+
+StateSumRun s;
+s.c=c;
+s.q=q;
+s.lane=lane;
+s.table=table;
+int nEdges=c->nHinges, largest=maxTwoJ;
+for (int h=0;h<nEdges;h++)
+	{
+	bool fixed=fixedTwoJ!=NULL && fixedTwoJ[h]>=0;
+	if (fixed && fixedTwoJ[h]>1023)
+		{
+		printf("stateSum() was given 2j = %d on edge %d\n",fixedTwoJ[h],h);
+		return false;
+		};
+	s.base.push_back(fixed ? fixedTwoJ[h] : 0);
+	s.dim.push_back(fixed ? 1 : maxTwoJ+1);
+	if (fixed && fixedTwoJ[h]>largest) largest=fixedTwoJ[h];
+	};
+for (int x=0;x<=largest;x++)
+	s.edgeWeight.push_back(q==NULL ? theta(0,x,x) : qTheta(q,lane,0,x,x));
+
+//	The tensors of the network
+
+for (int h=0;h<nEdges;h++)
+	{
+	Tensor t;
+	t.kind=edgeTensor;
+	t.index=h;
+	t.edges.push_back(h);
+	t.live=true;
+	s.tensors.push_back(t);
+	};
+for (int f=0;f<c->nFacets;f++)
+	{
+	Tensor t;
+	t.kind=facetTensor;
+	t.index=f;
+	t.edges.assign(&c->facetHinges[3*f],&c->facetHinges[3*f+3]);
+	t.live=true;
+	s.tensors.push_back(t);
+	};
+for (int k=0;k<c->nTop;k++)
+	{
+	Tensor t;
+	t.kind=tetTensor;
+	t.index=k;
+	t.edges.assign(&c->topHinges[6*k],&c->topHinges[6*k+6]);
+	t.live=true;
+	s.tensors.push_back(t);
+	};
+for (size_t t=0;t<s.tensors.size();t++)
+	{
+	std::vector<int> &e=s.tensors[t].edges;
+	std::sort(e.begin(),e.end());
+	e.erase(std::unique(e.begin(),e.end()),e.end());
+	};
+
+//	Choose the order of summation
+
+SumOrder order, trial;
+chooseOrder(s,NULL,order);
+std::mt19937 rng(1);
+for (int k=0;k<orderTrials;k++)
+	{
+	chooseOrder(s,&rng,trial);
+	if (trial.peakBytes<order.peakBytes ||
+		(trial.peakBytes==order.peakBytes && trial.terms<order.terms)) order=trial;
+	};
+if (order.peakBytes>maxBytes)
+	{
+	printf("The contraction needs %.0f bytes for its tensors, more than the %.0f allowed\n",
+		order.peakBytes,maxBytes);
+	return false;
+	};
+
+bool ownTable=false;
+if (q==NULL && s.table==NULL)
+	{
+	s.table=makeSixJTable(maxTwoJ,nThreads);
+	if (s.table==NULL) return false;
+	ownTable=true;
+	};
+
+//	Contract
+
+std::vector<StateSumThread> threads(nThreads);
+for (int t=0;t<nThreads;t++) threads[t].label=s.base;
+std::vector<int> group;
+for (int step=0;step<nEdges;step++)
+	{
+	int e=order.edges[step];
+	group.clear();
+	for (size_t t=0;t<s.tensors.size();t++)
+		if (s.tensors[t].live &&
+			std::binary_search(s.tensors[t].edges.begin(),s.tensors[t].edges.end(),e))
+			group.push_back((int)t);
+	Tensor out;
+	sumOut(s,e,group,out,threads);
+	for (size_t g=0;g<group.size();g++)
+		{
+		Tensor &t=s.tensors[group[g]];
+		t.live=false;
+		std::vector<double>().swap(t.values);
+		};
+	s.tensors.push_back(out);
+	};
+
+//	Whatever is left has no edges
+
+double z=1.0;
+for (size_t t=0;t<s.tensors.size();t++)
+	if (s.tensors[t].live) z*=s.tensors[t].values[0];
+if (ownTable) closeSixJTable(s.table);
+
+result->z=z;
+result->width=order.width;
+result->peakBytes=order.peakBytes;
+result->terms=order.terms;
+result->seconds=std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+return true;
+}
@@ -0,0 +1,149 @@
+/*
+
+statesumMain.cpp
+================
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a main program that evaluates the Ponzano-Regge and Turaev-Viro
+state sums with stateSum() on two triangulations of the 3-sphere:  the boundary
+of a 4-simplex, from makeSphereComplex(), and two tetrahedra glued to each other
+by the identity on all four faces.
+
+	prsum <maxTwoJ> [r [threads]]
+
+For each triangulation it prints the Ponzano-Regge sum with all 2j <= maxTwoJ,
+with the width and memory of the contraction, and checks it against a direct sum
+over every labelling of the edges when there are few enough of them; it does the
+same with one edge held at 2j = maxTwoJ.  If r >= 3 is given, it also computes
+the Turaev-Viro invariant at q = exp(i pi/r), Z w^(-2V) with every 2j <= r-2,
+which should be the same for both triangulations, and equal to 1/w^2.  The exit
+status is 1 if any of the checks fail.
+
+*/
+
+#include <thread>
+#include <vector>
+#include "spin.h"
+
+void usage()
+{
+printf("usage:\tprsum <maxTwoJ> [r [threads]]\n");
+exit(2);
+}
+
+//	The Ponzano-Regge sum over every labelling, one at a time
+
+static double directSum(Complex *c, int maxTwoJ, const int *fixedTwoJ)
+{
+int n=c->nHinges;
+std::vector<int> j(n);
+for (int h=0;h<n;h++) j[h]=fixedTwoJ[h]>=0 ? fixedTwoJ[h] : 0;
+double z=0.0;
+while (true)
+	{
+	double term=1.0;
+	for (int h=0;h<n && term!=0.0;h++) term*=theta(0,j[h],j[h]);
+	for (int f=0;f<c->nFacets && term!=0.0;f++)
+		{
+		const int *e=&c->facetHinges[3*f];
+		int a=j[e[0]], b=j[e[1]], d=j[e[2]];
+		if ((a+b+d)%2!=0 || a>b+d || b>a+d || d>a+b) term=0.0;
+		else if (((a+b+d)/2)%2!=0) term=-term;
+		};
+	for (int t=0;t<c->nTop && term!=0.0;t++)
+		{
+		const int *e=&c->topHinges[6*t];
+		term*=sixJ(j[e[0]],j[e[1]],j[e[2]],j[e[3]],j[e[4]],j[e[5]]);
+		};
+	z+=term;
+
+	int h=0;
+	while (h<n && (fixedTwoJ[h]>=0 || j[h]==maxTwoJ))
+		{
+		if (fixedTwoJ[h]<0) j[h]=0;
+		h++;
+		};
+	if (h==n) break;
+	j[h]++;
+	};
+return z;
+}
+
+static bool agree(double a, double b)
+{
+return fabs(a-b)<=1e-9*(fabs(a)+fabs(b))+1e-300;
+}
+
+int main(int argc, char **argv)
+{
+if (argc<2 || argc>4) usage();
+int maxTwoJ=atoi(argv[1]), r=argc>2 ? atoi(argv[2]) : 0;
+int nThreads=argc>3 ? atoi(argv[3]) : (int)std::thread::hardware_concurrency();
+if (maxTwoJ<0 || (argc>2 && r<3)) usage();
+
+//	Two tets glued face to face, each vertex to itself
+
+int adjacencies[8]={1,1,1,1,0,0,0,0}, gluings[32];
+for (int k=0;k<32;k++) gluings[k]=k%4;
+
+Complex complexes[2];
+const char *names[2]={"Boundary of a 4-simplex","Two tetrahedra"};
+if (!makeSphereComplex(3,&complexes[0]) ||
+	!makeComplex(3,2,adjacencies,gluings,&complexes[1])) return 1;
+
+SixJTable *table=makeSixJTable(maxTwoJ,nThreads);
+if (table==NULL) return 1;
+
+int nBad=0;
+double invariant[2];
+for (int k=0;k<2;k++)
+	{
+	Complex *c=&complexes[k];
+	printf("%s: %d vertices, %d edges, %d triangles, %d tets\n",
+		names[k],c->nVertices,c->nHinges,c->nFacets,c->nTop);
+
+	std::vector<int> fixedTwoJ(c->nHinges,-1);
+	for (int pass=0;pass<2;pass++)
+		{
+		if (pass==1) fixedTwoJ[0]=maxTwoJ;
+		StateSum result;
+		if (!stateSum(c,maxTwoJ,&fixedTwoJ[0],table,NULL,0,1e10,nThreads,&result)) return 1;
+		printf("\tPonzano-Regge%s: Z = %.15g  (width %d, %.0f bytes, %.0f terms, %.3f s)\n",
+			pass==0 ? "" : ", first edge fixed",result.z,result.width,result.peakBytes,
+			result.terms,result.seconds);
+		if (pow(maxTwoJ+1.0,c->nHinges-pass)<=2e7)
+			{
+			clock_t c0=clock();
+			double z=directSum(c,maxTwoJ,&fixedTwoJ[0]);
+			bool ok=agree(z,result.z);
+			if (!ok) nBad++;
+			printf("\tDirect sum: %.15g  (%.3f s)%s\n",z,(clock()-c0)/(double)CLOCKS_PER_SEC,
+				ok ? "" : "  DISAGREES");
+			};
+		};
+
+	if (r>=3)
+		{
+		QParameter q={r,0.0};
+		QTable *qt=newQTable(1,&q,r-2);
+		if (qt==NULL) return 1;
+		StateSum result;
+		if (!stateSum(c,r-2,NULL,NULL,qt,0,1e10,nThreads,&result)) return 1;
+		double w2=0.0;
+		for (int x=0;x<=r-2;x++) w2+=qTheta(qt,0,0,x,x)*qTheta(qt,0,0,x,x);
+		invariant[k]=result.z*pow(w2,-c->nVertices);
+		printf("\tTuraev-Viro at r = %d: Z = %.15g, invariant %.15g, 1/w^2 = %.15g  (%.3f s)\n",
+			r,result.z,invariant[k],1.0/w2,result.seconds);
+		if (!agree(invariant[k],1.0/w2)) nBad++;
+		deleteQTable(qt);
+		};
+	};
+if (r>=3 && !agree(invariant[0],invariant[1])) nBad++;
+
+closeSixJTable(table);
+for (int k=0;k<2;k++) freeComplex(&complexes[k]);
+printf("%d checks failed\n",nBad);
+return nBad==0 ? 0 : 1;
+}
@@ -0,0 +1,439 @@
+/*
+
+streamMain.cpp
+==============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a main program that evaluates a stream of 10j symbols,
+read from a file or from standard input, using several threads.
+
+	10jstream [-t threads] [-T threads] [-w window] [-i text|binary] [-o csv|binary]
+		[-s seconds] [-m bytes] [-c] [-p] [-v] [file]
+
+With no file, or a file named "-", the spins are read from standard input.
+
+Text input has one symbol per line:  either ten values of 2j, giving twoJ1[0..4]
+then twoJ2[0..4] as in test.cpp, or a single value of 2j for a regular symbol.
+Blank lines and anything after a '#' are ignored.  Binary input is a sequence of
+records of ten 32-bit integers in the machine's own byte order.
+
+The results are written to standard output in the same order as the input, each
+as soon as it and all the results before it are complete.  CSV output has one
+line per symbol, giving its index in the input, the ten values of 2j and the
+value of the 10j symbol.  Binary output has one record per symbol:  the ten
+32-bit values of 2j followed by the value as a 64-bit double.  Symbols too large
+for the coefficient matrices in tenJ.cpp, and symbols with a negative spin, give a
+value of nan, as they do from 10jd; the latter are reported on standard error.
+
+At most "window" symbols (default 64 per thread) are held in memory at once:
+the reader waits for the oldest result to be written before it reads any more,
+so the memory used does not depend on the length of the input.
+
+Each symbol is planned with tenJPlan() as it is read, and the worker threads
+take the symbol in the window with the largest predicted time first, so that a
+big symbol late in the window does not hold up the output on its own.  Symbols
+whose plan exceeds the limits given by -s (predicted seconds) or -m (bytes of
+matrix storage) are not computed, and give a value of nan.  With -c, the time
+model is first calibrated with a short benchmark; this happens anyway if -s is
+given.  With -p, no symbols are computed:  the plan for each one is written as
+CSV instead.
+
+With -T, each symbol is computed by tenJThreads() (parallel.cpp), with the sum over
+m1, m2 shared between the given number of threads, as well as several symbols
+being computed at once; this helps when a few large symbols dominate the input.
+The sums are reproducible, so the values do not depend on the number of threads,
+though they can differ from tenJ()'s in the last digits.  With -v as well, each
+symbol is computed again with one thread, any value that differs is reported on
+standard error, and the exit status is 1 if any did.
+
+*/
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+#include <string.h>
+#include "spin.h"
+
+//	A symbol to be evaluated, in a slot of the reorder buffer
+
+enum {slotEmpty, slotRead, slotClaimed, slotDone};
+
+struct Record
+	{
+	int twoJ1[5], twoJ2[5];		//	Double the spins on the edges
+	long index;					//	Position in the input, counting from 0
+	double value;				//	Value of the 10j symbol, once computed
+	double cost;				//	Predicted time to compute it
+	int state;					//	One of the slot states above
+	};
+
+//	The reorder buffer, with the counts that say which part of it is in use:
+//	symbols nWritten<=n<nRead are held in slot n%window, and nWaiting of them
+//	have not yet been taken by a worker.
+
+static Record *slots;
+static int window;
+static long nRead=0, nWritten=0, nWaiting=0;
+static bool endOfInput=false;
+
+static std::mutex bufferLock;
+static std::condition_variable slotFreed, symbolRead, symbolDone;
+
+//	Options
+
+static bool binaryIn=false, binaryOut=false;
+static double maxSeconds=0.0, maxBytes=0.0;
+static int symbolThreads=0;
+static bool verify=false;
+static std::atomic<long> nDiffer(0);
+
+//	evaluate() computes a single 10j symbol, using the faster routine for
+//	regular symbols where possible
+
+double evaluate(int *twoJ1, int *twoJ2)
+{
+if (symbolThreads>0)
+	{
+	double value=tenJThreads(twoJ1,twoJ2,symbolThreads,true);
+	if (verify)
+		{
+		double one=tenJThreads(twoJ1,twoJ2,1,true);
+		if (memcmp(&one,&value,sizeof(double))!=0)
+			{
+			fprintf(stderr,"10jstream: %.17g with %d threads, %.17g with one\n",
+				value,symbolThreads,one);
+			nDiffer++;
+			};
+		};
+	return value;
+	};
+bool regular=true;
+for (int i=0;i<5;i++) regular&=(twoJ1[i]==twoJ1[0] && twoJ2[i]==twoJ1[0]);
+return regular ? tenJ(twoJ1[0]) : tenJ(twoJ1,twoJ2);
+}
+
+//	worker() takes symbols from the buffer, largest predicted time first, and
+//	computes them, until the input is exhausted
+
+void worker()
+{
+while (true)
+	{
+	Record *r=NULL;
+	{
+	std::unique_lock<std::mutex> lock(bufferLock);
+	symbolRead.wait(lock,[]{return nWaiting>0 || endOfInput;});
+	if (nWaiting==0) return;
+	for (long n=nWritten;n<nRead;n++)
+		{
+		Record *q=slots+n%window;
+		if (q->state==slotRead && (r==NULL || q->cost>r->cost)) r=q;
+		};
+	r->state=slotClaimed;
+	nWaiting--;
+	}
+
+	double value=evaluate(r->twoJ1,r->twoJ2);
+
+	{
+	std::lock_guard<std::mutex> lock(bufferLock);
+	r->value=value;
+	r->state=slotDone;
+	}
+	symbolDone.notify_all();
+	};
+}
+
+//	writeRecord() writes out a single result
+
+void writeRecord(Record *r)
+{
+if (binaryOut)
+	{
+	int32_t j[10];
+	for (int i=0;i<5;i++)
+		{
+		j[i]=r->twoJ1[i];
+		j[5+i]=r->twoJ2[i];
+		};
+	fwrite(j,sizeof(int32_t),10,stdout);
+	fwrite(&r->value,sizeof(double),1,stdout);
+	}
+else
+	{
+	printf("%ld,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%.17g\n",r->index,
+		r->twoJ1[0],r->twoJ1[1],r->twoJ1[2],r->twoJ1[3],r->twoJ1[4],
+		r->twoJ2[0],r->twoJ2[1],r->twoJ2[2],r->twoJ2[3],r->twoJ2[4],r->value);
+	};
+}
+
+//	writer() writes out the results in order, as soon as they are complete
+
+void writer()
+{
+while (true)
+	{
+	Record *r;
+	{
+	std::unique_lock<std::mutex> lock(bufferLock);
+	symbolDone.wait(lock,[]{return (nWritten<nRead && slots[nWritten%window].state==slotDone)
+		|| (endOfInput && nWritten>=nRead);});
+	if (nWritten>=nRead) break;
+	r=slots+nWritten%window;
+	}
+
+	writeRecord(r);
+
+	{
+	std::lock_guard<std::mutex> lock(bufferLock);
+	r->state=slotEmpty;
+	nWritten++;
+	}
+	slotFreed.notify_one();
+	};
+fflush(stdout);
+}
+
+//	readRecord() reads the spins for the next symbol; it returns false at the end
+//	of the input
+
+bool readRecord(FILE *fp, int *twoJ1, int *twoJ2)
+{
+static char line[1024];
+static long lineNumber=0;
+
+if (binaryIn)
+	{
+	int32_t j[10];
+	size_t n=fread(j,sizeof(int32_t),10,fp);
+	if (n==0) return false;
+	if (n!=10)
+		{
+		fprintf(stderr,"10jstream: incomplete record at end of input\n");
+		return false;
+		};
+	for (int i=0;i<5;i++)
+		{
+		twoJ1[i]=j[i];
+		twoJ2[i]=j[5+i];
+		};
+	return true;
+	};
+
+while (fgets(line,sizeof(line),fp)!=NULL)
+	{
+	lineNumber++;
+	char *hash=strchr(line,'#');
+	if (hash!=NULL) *hash=0;
+
+	//	Read up to ten integers from the line
+
+	int j[10], n=0;
+	char *p=line, *end;
+	while (n<10)
+		{
+		long v=strtol(p,&end,10);
+		if (end==p) break;
+		j[n++]=(int)v;
+		p=end;
+		};
+	while (*p==' ' || *p=='\t' || *p==',' || *p=='\r' || *p=='\n') p++;
+
+	if (n==0 && *p==0) continue;		//	Blank line
+
+	if (*p!=0 || (n!=1 && n!=10))
+		{
+		fprintf(stderr,"10jstream: line %ld should hold 1 or 10 values of 2j; skipped\n",
+			lineNumber);
+		continue;
+		};
+	for (int i=0;i<5;i++)
+		{
+		twoJ1[i]=n==1 ? j[0] : j[i];
+		twoJ2[i]=n==1 ? j[0] : j[5+i];
+		};
+	return true;
+	};
+return false;
+}
+
+//	negativeSpin() checks for spins that no symbol can have
+
+static bool negativeSpin(int *twoJ1, int *twoJ2)
+{
+for (int i=0;i<5;i++) if (twoJ1[i]<0 || twoJ2[i]<0) return true;
+return false;
+}
+
+void usage()
+{
+fprintf(stderr,"usage: 10jstream [-t threads] [-T threads] [-w window] [-i text|binary] "
+	"[-o csv|binary] [-s seconds] [-m bytes] [-c] [-p] [-v] [file]\n");
+exit(2);
+}
+
+//	planOnly() writes the plan for each symbol in the input, without computing any
+
+void planOnly(FILE *fp)
+{
+printf("index,twoJ1_0,twoJ1_1,twoJ1_2,twoJ1_3,twoJ1_4,"
+	"twoJ2_0,twoJ2_1,twoJ2_2,twoJ2_3,twoJ2_4,"
+	"admitted,steps,tets,flops,matrixBytes,seconds\n");
+
+int twoJ1[5], twoJ2[5];
+for (long n=0;readRecord(fp,twoJ1,twoJ2);n++)
+	{
+	TenJPlan plan;
+	if (negativeSpin(twoJ1,twoJ2)) memset(&plan,0,sizeof(plan));
+	else tenJPlan(twoJ1,twoJ2,&plan);
+	printf("%ld,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%.0f,%.0f,%.0f,%.0f,%.6g\n",n,
+		twoJ1[0],twoJ1[1],twoJ1[2],twoJ1[3],twoJ1[4],
+		twoJ2[0],twoJ2[1],twoJ2[2],twoJ2[3],twoJ2[4],
+		tenJAdmit(&plan,maxSeconds,maxBytes) ? 1 : 0,
+		plan.steps,plan.tets,plan.flops,plan.matrixBytes,plan.seconds);
+	};
+}
+
+//	Main program
+//	============
+
+int main(int argc, char **argv)
+{
+int nThreads=std::thread::hardware_concurrency();
+if (nThreads<1) nThreads=1;
+window=0;
+const char *fileName="-";
+bool calibrate=false, plans=false;
+
+for (int a=1;a<argc;a++)
+	{
+	if (strcmp(argv[a],"-t")==0 && a+1<argc) nThreads=atoi(argv[++a]);
+	else if (strcmp(argv[a],"-T")==0 && a+1<argc)
+		{
+		symbolThreads=atoi(argv[++a]);
+		if (symbolThreads<1) usage();
+		}
+	else if (strcmp(argv[a],"-w")==0 && a+1<argc) window=atoi(argv[++a]);
+	else if (strcmp(argv[a],"-i")==0 && a+1<argc)
+		{
+		a++;
+		if (strcmp(argv[a],"binary")==0) binaryIn=true;
+		else if (strcmp(argv[a],"text")!=0) usage();
+		}
+	else if (strcmp(argv[a],"-o")==0 && a+1<argc)
+		{
+		a++;
+		if (strcmp(argv[a],"binary")==0) binaryOut=true;
+		else if (strcmp(argv[a],"csv")!=0) usage();
+		}
+	else if (strcmp(argv[a],"-s")==0 && a+1<argc) maxSeconds=atof(argv[++a]);
+	else if (strcmp(argv[a],"-m")==0 && a+1<argc) maxBytes=atof(argv[++a]);
+	else if (strcmp(argv[a],"-c")==0) calibrate=true;
+	else if (strcmp(argv[a],"-p")==0) plans=true;
+	else if (strcmp(argv[a],"-v")==0) verify=true;
+	else if (argv[a][0]=='-' && argv[a][1]!=0) usage();
+	else fileName=argv[a];
+	};
+if (nThreads<1) usage();
+if (window<1) window=64*nThreads;
+
+FILE *fp=strcmp(fileName,"-")==0 ? stdin : fopen(fileName,binaryIn ? "rb" : "r");
+if (fp==NULL)
+	{
+	fprintf(stderr,"10jstream: cannot open %s\n",fileName);
+	return 1;
+	};
+
+if ((calibrate || maxSeconds>0.0) && !calibrateTenJPlan())
+	fprintf(stderr,"10jstream: calibration failed; using the default time model\n");
+
+if (plans)
+	{
+	planOnly(fp);
+	if (fp!=stdin) fclose(fp);
+	return 0;
+	};
+
+slots=new Record[window];
+for (int i=0;i<window;i++) slots[i].state=slotEmpty;
+
+if (!binaryOut)
+	printf("index,twoJ1_0,twoJ1_1,twoJ1_2,twoJ1_3,twoJ1_4,"
+		"twoJ2_0,twoJ2_1,twoJ2_2,twoJ2_3,twoJ2_4,tenJ\n");
+
+std::vector<std::thread> threads;
+for (int t=0;t<nThreads;t++) threads.push_back(std::thread(worker));
+std::thread output(writer);
+
+//	Read the input, waiting whenever the buffer is full
+
+int twoJ1[5], twoJ2[5];
+while (readRecord(fp,twoJ1,twoJ2))
+	{
+	TenJPlan plan;
+	bool negative=negativeSpin(twoJ1,twoJ2), admitted=false;
+	if (negative) memset(&plan,0,sizeof(plan));
+	else
+		{
+		tenJPlan(twoJ1,twoJ2,&plan);
+		admitted=tenJAdmit(&plan,maxSeconds,maxBytes);
+		};
+
+	std::unique_lock<std::mutex> lock(bufferLock);
+	slotFreed.wait(lock,[]{return nRead-nWritten<window;});
+	Record *r=slots+nRead%window;
+	for (int i=0;i<5;i++)
+		{
+		r->twoJ1[i]=twoJ1[i];
+		r->twoJ2[i]=twoJ2[i];
+		};
+	r->index=nRead;
+	r->cost=plan.seconds;
+	nRead++;
+	if (admitted)
+		{
+		r->state=slotRead;
+		nWaiting++;
+		lock.unlock();
+		symbolRead.notify_one();
+		}
+	else
+		{
+		//	Rejected symbols go straight to the writer
+
+		if (negative)
+			fprintf(stderr,"10jstream: symbol %ld rejected (negative spin)\n",r->index);
+		else
+			fprintf(stderr,"10jstream: symbol %ld rejected (predicted %.3g seconds, "
+				"%.3g bytes)\n",r->index,plan.seconds,plan.matrixBytes);
+		r->value=NAN;
+		r->state=slotDone;
+		lock.unlock();
+		symbolDone.notify_all();
+		};
+	};
+
+{
+std::lock_guard<std::mutex> lock(bufferLock);
+endOfInput=true;
+}
+symbolRead.notify_all();
+symbolDone.notify_all();
+
+for (int t=0;t<nThreads;t++) threads[t].join();
+output.join();
+
+if (fp!=stdin) fclose(fp);
+delete [] slots;
+if (nDiffer>0)
+	{
+	fprintf(stderr,"10jstream: %ld values depend on the number of threads\n",(long)nDiffer);
+	return 1;
+	};
+return 0;
+}
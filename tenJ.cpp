@@ -16,11 +16,25 @@ tenJ(int *twoJ1, int *twoJ2) computes the 10j symbol in the general case
 
 tenJ(int twoJ) computes the 10j symbol in the regular case
 
+The general case is also broken down into routines that can be used to compute
+the sum over m1, m2 piecemeal:  tenJSetup() computes everything that does not
+depend on the m's, and tenJTerm() computes the term for a single pair of m's
+using a workspace created by newTenJWork().
+
+tenJX(int *twoJ1, int *twoJ2) computes the general case with an extended exponent,
+for spins at which the tets, thetas or terms would overflow a double; its matrices
+are allocated to fit each symbol, so unlike tenJ() it has no limit maxC on them.
+
+The matrices used by tenJ() are kept separately for each thread, so several
+threads can compute different 10j symbols at the same time.
+
 Reference:	J.D. Christensen and G. Egan, "An Efficient Algorithm for the Riemannian
 			10j Symbols".
 
 */
 
+#include <new>
+#include <vector>
 #include "spin.h"
 
 //	Set logit to the number of inner loop passes at which to print a progress line;
@@ -28,23 +42,58 @@ Reference:	J.D. Christensen and G. Egan, "An Efficient Algorithm for the Riemann
 
 #define logit 0
 
-//	Maximum dimensions for coefficient matrices
+//	Largest dimension for which the trace uses a kernel with fixed loop bounds
 
-#define maxC 100
+#define maxSmallC 12
 
-//	tenJ() computes the normalised value of a 10j symbol
+//	Workspace for tenJTerm(): limits on c_i taking the m's into account, the
+//	coefficient matrices and the vectors used in computing the trace.  Each
+//	thread or process that computes terms needs its own workspace.
+
+struct TenJWork
+	{
+	int LL[5], HH[5], dim[5];			//	Limits on c_i, taking m's into account
+	TENJfloat M[5][maxC][maxC];			//	Coefficient matrices
+	TENJfloat v0[maxC], v1[maxC];		//	Vectors used in computing trace
+	int lo[5][maxC], hi[5][maxC];		//	Nonzero columns of each row, for tenJTraceBanded()
+	TENJfloat small[5*maxSmallC*maxSmallC];	//	Padded matrices, for smallTrace()
+	
+	//	For tenJTermX(), sized to the symbol rather than maxC:  the matrices, one
+	//	after another, each row relative to a power of 2, and the rows of tets
+	
+	std::vector<TENJfloat> xM, xV0, xV1, xT1, xT2;
+	std::vector<int> xRowExp;
+	};
+
+TenJWork *newTenJWork()
+{
+return new TenJWork;
+}
+
+void deleteTenJWork(TenJWork *work)
+{
+delete work;
+}
+
+//	tenJSetup() computes everything about a 10j symbol that does not depend on
+//	the m's.  It returns false if the symbol needs coefficient matrices larger
+//	than maxC.
 //
 //	twoJ1[]		gives double the values of the spins on the five edges joining
 //				vertices 0 to 1, 1 to 2, 2 to 3, 3 to 4, 4 to 0
 //	twoJ2[]		gives double the values of the spins on the five edges joining
 //				vertices 0 to 2, 1 to 3, 2 to 4, 3 to 0, 4 to 1
 
-TENJfloat tenJ(int *twoJ1, int *twoJ2)
+bool tenJSetup(int *twoJ1, int *twoJ2, TenJSetup *s)
 {
-static int L[5], H[5];					//	Limits on c_i, independent of m's
-static int LL[5], HH[5], dim[5];		//	Limits on c_i, taking m's into account
-static TENJfloat M[5][maxC][maxC];		//	Coefficient matrices
-static TENJfloat v0[maxC], v1[maxC];	//	Vectors used in computing trace
+int *L=s->L, *H=s->H;
+bool fits=true;
+
+for (int i=0;i<5;i++)
+	{
+	s->twoJ1[i]=twoJ1[i];
+	s->twoJ2[i]=twoJ2[i];
+	};
 
 //	Low/high limits on c_i, independent of m's
 
@@ -54,11 +103,7 @@ for (int i=0;i<5;i++)
 	int j1m=twoJ1[mod5(i-1)], j2m2=twoJ2[mod5(i-2)];
 	L[i]=max(abs(j1-j2),abs(j1m-j2m2));
 	H[i]=min(j1+j2,j1m+j2m2);
-	if (1+(H[i]-L[i])/2>maxC)
-		{
-		printf("Array size maxC=%d exceeded; recompile tenJ.cp with higher maxC\n",maxC);
-		exit(1);
-		};
+	if (1+(H[i]-L[i])/2>maxC) fits=false;
 	};
 	
 //	Low/high limits on m's
@@ -77,6 +122,8 @@ for (int i=0;i<5;i++)
 	else ml=(j2m-Li)%2;
 	if (i==0 || ml>mLow) mLow=ml;
 	};
+s->mLow=mLow;
+s->mHigh=mHigh;
 	
 //	Overall sign depends on sum of 2j for all edges, plus the m-independent
 //	part of the sign from equation (5) in the paper, (-1)^{2(L_0+j_{2,4})}
@@ -86,123 +133,518 @@ for (int i=0;i<5;i++)
 	{
 	overallParity+=(twoJ1[i]+twoJ2[i]);
 	};
+s->overallParity=overallParity;
 
-//	Outermost loop:  for mLow<=m2<=m1<=mHigh
+//	Number of (m1, m2) steps, for mLow<=m2<=m1<=mHigh
 
-TENJfloat sumOverM=0.0;
-int td=(mHigh-mLow)/2+1, tSteps=td*(td+1)/2, steps=0;
-for (int m1=mLow;m1<=mHigh;m1+=2)
-for (int m2=mLow;m2<=m1;m2+=2)
+int td=mHigh<mLow ? 0 : (mHigh-mLow)/2+1;
+s->nSteps=td*(td+1)/2;
+
+return fits;
+}
+
+//	tenJStepM() gives the values of m1, m2 for a step number 0<=step<nSteps;
+//	steps are numbered in the order of the loops in tenJ(), with m1 outermost.
+
+void tenJStepM(TenJSetup *s, int step, int &m1, int &m2)
+{
+int a=(int)((sqrt(8.0*step+1.0)-1.0)/2.0);
+while (a*(a+1)/2>step) a--;
+while ((a+1)*(a+2)/2<=step) a++;
+m1=s->mLow+2*a;
+m2=s->mLow+2*(step-a*(a+1)/2);
+}
+
+//	tenJLimits() sets the limits LL[i] and dimensions dim[i] of the ranges of c_i
+//	for a pair of m's, and lowDim to the index of the smallest dimension; it returns
+//	false if some range is empty, when the term is zero.
+
+bool tenJLimits(TenJSetup *s, int m1, int m2, int *LL, int *dim, int &lowDim)
+{
+int *twoJ2=s->twoJ2, *L=s->L, *H=s->H;
+
+lowDim=0;			//	Identify index to lowest dimension
+for (int i=0;i<5;i++)
 	{
-	if (logit>0 && ++steps%logit==1) printf("Starting step %d of %d\n",steps,tSteps);
+	int j2m=twoJ2[mod5(i-1)];
 	
-	//	Low/high limits on c_i, taking current m values into account
+	int origLow=L[i], clipLow=max(abs(m1-j2m),abs(m2-j2m));
+	int LLi=LL[i]=max(clipLow, origLow);
+	
+	int origHigh=H[i], clipHigh=min(m1+j2m,m2+j2m);
+	int HHi=min(clipHigh, origHigh);
+	
+	if (HHi<LLi) return false;
 	
-	bool compatible=true;
-	int lowDim=0;		//	Identify index to lowest dimension
-	for (int i=0;i<5 && compatible;i++)
+	dim[i]=1+(HHi-LLi)/2;
+	if (dim[i]<dim[lowDim]) lowDim=i;
+	};
+return true;
+}
+
+//	tenJMatrix() computes the coefficient matrix M_k for a pair of m's, with the
+//	limits from tenJLimits(); row i (for c_{k+1}) and column j (for c_k) is stored
+//	in M[i*stride+j].  It depends only on the spins twoJ1[k], twoJ1[k+1],
+//	twoJ2[k-1], twoJ2[k], twoJ2[k+1], the m's, and LL and dim for k and k+1.
+
+void tenJMatrix(TenJSetup *s, int k, int m1, int m2, int *LL, int *dim,
+	TENJfloat *M, int stride)
+{
+int *twoJ1=s->twoJ1, *twoJ2=s->twoJ2;
+int kp1=(k+1)%5;
+int d1=dim[kp1], d2=dim[k];
+int j1=twoJ1[k], j1p=twoJ1[mod5(k+1)];
+int j2=twoJ2[k], j2m=twoJ2[mod5(k-1)], j2p=twoJ2[mod5(k+1)];
+
+for (int i=0;i<d1;i++)
+	{
+	int ckp=LL[kp1]+2*i;
+	TENJfloat *row=M+i*stride;
+	#if MERGE_TET_THETA
+	TENJfloat factor=(ckp+1);
+	TETfloat t1[maxC], t2[maxC];
+	tetOnThetasRow(d2,LL[k],j2,ckp,j2m,m1,j1,j2,ckp,m1,j2m,ckp,j1,t1);
+	tetOnThetasRow(d2,LL[k],j2,ckp,j2m,m2,j1,j2,ckp,m2,j2p,ckp,j1p,t2);
+	for (int j=0;j<d2;j++) row[j]=factor*t1[j]*t2[j];
+	#else
+	TENJfloat factor=
+		(ckp+1)/
+		(theta(j2,ckp,m1)*theta(j2,ckp,m2)*theta(j2m,ckp,j1)*theta(j2p,ckp,j1p));
+	for (int j=0;j<d2;j++)
 		{
-		int j2m=twoJ2[mod5(i-1)];
-		
-		int origLow=L[i], clipLow=max(abs(m1-j2m),abs(m2-j2m));
-		int LLi=LL[i]=max(clipLow, origLow);
+		int ck=LL[k]+2*j;
+		row[j]=
+			factor*tet(ck,j2,ckp,j2m,m1,j1)*tet(ck,j2,ckp,j2m,m2,j1);
+		};
+	#endif
+	};
+}
+
+//	tenJTrace() finds the trace of the product of the five matrices M[k], each
+//	stored with its own row stride, using v0[] and v1[] as workspace; the outer sum
+//	is over basis vectors in the space with dimension dim[lowDim] (domain of first
+//	matrix, range of last matrix).
+
+TENJfloat tenJTrace(TENJfloat **M, int *stride, int *dim, int lowDim,
+	TENJfloat *v0, TENJfloat *v1)
+{
+TENJfloat trace=0.0;
+int d0=dim[lowDim], d1=dim[mod5(lowDim+1)];
+for (int l0=0;l0<d0;l0++)
+	{
+	//	Set v0 to product of first matrix and basis vector
+	
+	for (int i=0;i<d1;i++) v0[i]=M[lowDim][i*stride[lowDim]+l0];
+	
+	//	Multiply by the next three matrices
+	
+	TENJfloat *vIn=v0, *vOut=v1, *tmp;
+	for (int k=1;k<=3;k++)
+		{
+		//	Set vout = M[k] vin
 		
-		int origHigh=H[i], clipHigh=min(m1+j2m,m2+j2m);
-		int HHi=HH[i]=min(clipHigh, origHigh);
+		int ks=mod5(lowDim+k), dIn=dim[ks];
+		int ksp=mod5(lowDim+k+1), dOut=dim[ksp];
+		for (int i=0;i<dOut;i++)
+			{
+			TENJfloat vs=0.0, *row=M[ks]+i*stride[ks];
+			for (int j=0;j<dIn;j++) vs+=row[j]*vIn[j];
+			vOut[i]=vs;
+			};
 		
-		if (HHi<LLi) {compatible=false; break;};
+		//	Swap input/output vectors
 		
-		dim[i]=1+(HHi-LLi)/2;
-		if (dim[i]<dim[lowDim]) lowDim=i;
+		tmp=vIn;
+		vIn=vOut;
+		vOut=tmp;
 		};
-	if (!compatible) continue;
 	
-	//	Compute the M matrices
+	//	Add into trace only the relevant coordinate of product with final matrix
 	
-	for (int k=0;k<5;k++)
+	int m4=mod5(lowDim+4), dIn=dim[m4];
+	TENJfloat *row=M[m4]+l0*stride[m4];
+	for (int j=0;j<dIn;j++) trace+=row[j]*vIn[j];
+	};
+return trace;
+}
+
+//	tenJBand() finds, for each row of a matrix stored as in tenJMatrix(), the first
+//	and last columns lo[i], hi[i] holding nonzero entries, with lo[i] > hi[i] for a
+//	row of zeros; it returns the number of entries inside the bands.
+//
+//	There is no admissibility mask to apply first:  c_k and c_{k+1} are opposite
+//	edges of both tets in M_k, so every triad constrains only one of them, and the
+//	mask is the product of the ranges tenJLimits() has already clipped.  The zeros
+//	left are those of tets that vanish by cancellation, which are only found by
+//	computing them; trimming them keeps tenJTraceBanded() exact.
+
+long long tenJBand(TENJfloat *M, int stride, int rows, int cols, int *lo, int *hi)
+{
+long long n=0;
+for (int i=0;i<rows;i++)
+	{
+	TENJfloat *row=M+i*stride;
+	int l=0, h=cols-1;
+	while (l<cols && row[l]==0.0) l++;
+	while (h>=l && row[h]==0.0) h--;
+	lo[i]=l;
+	hi[i]=h;
+	if (h>=l) n+=h-l+1;
+	};
+return n;
+}
+
+//	tenJTraceBanded() finds the same trace as tenJTrace(), with each row of M[k]
+//	restricted to the columns lo[k][i]..hi[k][i] from tenJBand().  The terms it
+//	leaves out are all zero, and the rest are added in the same order, so the
+//	result is the same.
+
+TENJfloat tenJTraceBanded(TENJfloat **M, int *stride, int **lo, int **hi, int *dim,
+	int lowDim, TENJfloat *v0, TENJfloat *v1)
+{
+TENJfloat trace=0.0;
+int d0=dim[lowDim], d1=dim[mod5(lowDim+1)], m4=mod5(lowDim+4);
+for (int l0=0;l0<d0;l0++)
+	{
+	//	Skip basis vectors whose coordinate the final matrix can never reach
+	
+	if (hi[m4][l0]<lo[m4][l0]) continue;
+	
+	for (int i=0;i<d1;i++) v0[i]=M[lowDim][i*stride[lowDim]+l0];
+	
+	TENJfloat *vIn=v0, *vOut=v1, *tmp;
+	for (int k=1;k<=3;k++)
 		{
-		int kp1=(k+1)%5;
-		int d1=dim[kp1], d2=dim[k];
-		int j1=twoJ1[k], j1p=twoJ1[mod5(k+1)];
-		int j2=twoJ2[k], j2m=twoJ2[mod5(k-1)], j2p=twoJ2[mod5(k+1)];
-		
-		for (int i=0;i<d1;i++)
+		int ks=mod5(lowDim+k), dOut=dim[mod5(lowDim+k+1)];
+		int *rowLo=lo[ks], *rowHi=hi[ks];
+		for (int i=0;i<dOut;i++)
 			{
-			int ckp=LL[kp1]+2*i;
-			#if MERGE_TET_THETA
-			TENJfloat factor=(ckp+1);
-			for (int j=0;j<d2;j++)
-				{
-				int ck=LL[k]+2*j;
-				M[k][i][j]=
-					factor*tetOnThetas(ck,j2,ckp,j2m,m1,j1,j2,ckp,m1,j2m,ckp,j1)*
-					tetOnThetas(ck,j2,ckp,j2m,m2,j1,j2,ckp,m2,j2p,ckp,j1p);
-				};
-			#else
-			TENJfloat factor=
-				(ckp+1)/
-				(theta(j2,ckp,m1)*theta(j2,ckp,m2)*theta(j2m,ckp,j1)*theta(j2p,ckp,j1p));
-			for (int j=0;j<d2;j++)
-				{
-				int ck=LL[k]+2*j;
-				M[k][i][j]=
-					factor*tet(ck,j2,ckp,j2m,m1,j1)*tet(ck,j2,ckp,j2m,m2,j1);
-				};
-			#endif
+			TENJfloat vs=0.0, *row=M[ks]+i*stride[ks];
+			for (int j=rowLo[i];j<=rowHi[i];j++) vs+=row[j]*vIn[j];
+			vOut[i]=vs;
 			};
+		tmp=vIn;
+		vIn=vOut;
+		vOut=tmp;
 		};
-		
-	//	Find the trace of their product; outer sum is over basis vectors in the space
-	//	with dimensions dim 0 (domain of first matrix, range of last matrix)
 	
-	TENJfloat trace=0.0;
-	int d0=dim[lowDim], d1=dim[mod5(lowDim+1)];
-	for (int l0=0;l0<d0;l0++)
+	TENJfloat *row=M[m4]+l0*stride[m4];
+	for (int j=lo[m4][l0];j<=hi[m4][l0];j++) trace+=row[j]*vIn[j];
+	};
+return trace;
+}
+
+//	smallTrace<D>() finds the same trace as tenJTrace(), for five matrices padded
+//	with zeros to D x D and stored one after another.  Every inner loop has a fixed
+//	bound, so the compiler can unroll the chain of products; the padding only adds
+//	zero terms at the ends of the sums, so the result is the same.
+
+template<int D> static TENJfloat smallTrace(TENJfloat *M, int d0, int lowDim)
+{
+TENJfloat trace=0.0, v0[D], v1[D];
+const TENJfloat *first=M+lowDim*D*D, *last=M+mod5(lowDim+4)*D*D;
+for (int l0=0;l0<d0;l0++)
+	{
+	for (int i=0;i<D;i++) v0[i]=first[i*D+l0];
+	
+	TENJfloat *vIn=v0, *vOut=v1, *tmp;
+	for (int k=1;k<=3;k++)
 		{
-		//	Set v0 to product of first matrix and basis vector
-		
-		for (int i=0;i<d1;i++) v0[i]=M[lowDim][i][l0];
+		const TENJfloat *A=M+mod5(lowDim+k)*D*D;
+		for (int i=0;i<D;i++)
+			{
+			TENJfloat vs=0.0;
+			for (int j=0;j<D;j++) vs+=A[i*D+j]*vIn[j];
+			vOut[i]=vs;
+			};
+		tmp=vIn;
+		vIn=vOut;
+		vOut=tmp;
+		};
+	
+	const TENJfloat *row=last+l0*D;
+	for (int j=0;j<D;j++) trace+=row[j]*vIn[j];
+	};
+return trace;
+}
+
+typedef TENJfloat (*SmallTrace)(TENJfloat *M, int d0, int lowDim);
+
+static const SmallTrace smallTraces[maxSmallC+1]={NULL,
+	smallTrace<1>, smallTrace<2>, smallTrace<3>, smallTrace<4>,
+	smallTrace<5>, smallTrace<6>, smallTrace<7>, smallTrace<8>,
+	smallTrace<9>, smallTrace<10>, smallTrace<11>, smallTrace<12>};
+
+//	tenJTerm() computes the contribution to the 10j symbol from a single pair of
+//	values of m1, m2, with m2<=m1, including the factor of 2 for the term with
+//	m1 and m2 swapped.
+
+TENJfloat tenJTerm(TenJSetup *s, int m1, int m2, TenJWork *w)
+{
+int *LL=w->LL, *dim=w->dim, lowDim;
+
+//	Low/high limits on c_i, taking current m values into account
+
+if (!tenJLimits(s,m1,m2,LL,dim,lowDim)) return 0.0;
+
+//	Compute the M matrices, and the trace of their product; small ones are padded
+//	to the largest dimension, for a kernel with fixed loop bounds
+
+int D=0;
+for (int k=0;k<5;k++) if (dim[k]>D) D=dim[k];
+TENJfloat trace;
+if (D<=maxSmallC)
+	{
+	TENJfloat *P=w->small;
+	for (int e=0;e<5*D*D;e++) P[e]=0.0;
+	for (int k=0;k<5;k++) tenJMatrix(s,k,m1,m2,LL,dim,P+k*D*D,D);
+	trace=smallTraces[D](P,dim[lowDim],lowDim);
+	}
+else
+	{
+	TENJfloat *M[5];
+	int stride[5], *lo[5], *hi[5];
+	bool dense=true;
+	for (int k=0;k<5;k++)
+		{
+		M[k]=&w->M[k][0][0];
+		stride[k]=maxC;
+		lo[k]=w->lo[k];
+		hi[k]=w->hi[k];
+		tenJMatrix(s,k,m1,m2,LL,dim,M[k],maxC);
+		int rows=dim[mod5(k+1)], cols=dim[k];
+		if (tenJBand(M[k],maxC,rows,cols,lo[k],hi[k])<rows*cols) dense=false;
+		};
+	
+	//	The bands only pay for their loop overhead when they leave something out
+	
+	trace=dense ? tenJTrace(M,stride,dim,lowDim,w->v0,w->v1) :
+		tenJTraceBanded(M,stride,lo,hi,dim,lowDim,w->v0,w->v1);
+	};
+
+//	The term in the sum over the m's
+
+TENJfloat term=(m1+1)*(m2+1)*trace*
+	((s->overallParity-(m1+m2)/2)%2==0?1:-1);
+if (m1!=m2) term*=2;
+return term;
+}
+
+//	tenJTermX() computes the same term as tenJTerm(), as an XFloat.  Each row of
+//	the M matrices is stored as doubles relative to a power of 2, rowExp, chosen
+//	so the largest entry in the row has magnitude between 1/2 and 1.  The matrix
+//	products are carried out in doubles, scaling each output vector by its row
+//	powers and then renormalising it, with the accumulated power of 2 kept
+//	separately; only the trace itself is accumulated as an XFloat.
+
+//	scaleRows() rescales the entries v[i] by 2^(rowExp[i]-top), where top is the
+//	largest rowExp, and then renormalises v so its largest entry has magnitude
+//	between 1/2 and 1; it returns the total power of 2 taken out of v.
+
+static int scaleRows(TENJfloat *v, int *rowExp, int d)
+{
+int top=rowExp[0];
+for (int i=1;i<d;i++) if (rowExp[i]>top) top=rowExp[i];
+TENJfloat big=0.0;
+for (int i=0;i<d;i++)
+	{
+	v[i]=ldexp(v[i],rowExp[i]-top);
+	if (fabs(v[i])>big) big=fabs(v[i]);
+	};
+int e=0;
+if (big!=0.0)
+	{
+	frexp(big,&e);
+	for (int i=0;i<d;i++) v[i]=ldexp(v[i],-e);
+	};
+return top+e;
+}
+
+XFloat tenJTermX(TenJSetup *s, int m1, int m2, TenJWork *w)
+{
+int *twoJ1=s->twoJ1, *twoJ2=s->twoJ2;
+int *LL=w->LL, *dim=w->dim, lowDim;
+
+//	Low/high limits on c_i, taking current m values into account
+
+if (!tenJLimits(s,m1,m2,LL,dim,lowDim)) return XFloat();
+
+//	Room for the matrices; M[k] starts at offset[k], with rows of dim[k] entries,
+//	and its row exponents at rowOffset[k]
+
+int offset[5], rowOffset[5], size=0, rows=0, D=0;
+for (int k=0;k<5;k++)
+	{
+	offset[k]=size;
+	rowOffset[k]=rows;
+	size+=dim[mod5(k+1)]*dim[k];
+	rows+=dim[mod5(k+1)];
+	if (dim[k]>D) D=dim[k];
+	};
+if ((int)w->xM.size()<size) w->xM.resize(size);
+if ((int)w->xRowExp.size()<rows) w->xRowExp.resize(rows);
+if ((int)w->xV0.size()<D)
+	{
+	w->xV0.resize(D);
+	w->xV1.resize(D);
+	w->xT1.resize(D);
+	w->xT2.resize(D);
+	};
+TENJfloat *M[5], *t1=&w->xT1[0], *t2=&w->xT2[0];
+int *rowExp[5];
+for (int k=0;k<5;k++)
+	{
+	M[k]=&w->xM[offset[k]];
+	rowExp[k]=&w->xRowExp[rowOffset[k]];
+	};
+
+//	Compute the M matrices, one row at a time, each relative to a power of 2
+
+for (int k=0;k<5;k++)
+	{
+	int kp1=(k+1)%5;
+	int d1=dim[kp1], d2=dim[k];
+	int j1=twoJ1[k], j1p=twoJ1[mod5(k+1)];
+	int j2=twoJ2[k], j2m=twoJ2[mod5(k-1)], j2p=twoJ2[mod5(k+1)];
+	
+	for (int i=0;i<d1;i++)
+		{
+		int ckp=LL[kp1]+2*i, top;
+		TENJfloat *row=M[k]+i*d2;
+		#if MERGE_TET_THETA
+		int e1, e2;
+		tetOnThetasRowX(d2,LL[k],j2,ckp,j2m,m1,j1,j2,ckp,m1,j2m,ckp,j1,t1,e1);
+		tetOnThetasRowX(d2,LL[k],j2,ckp,j2m,m2,j1,j2,ckp,m2,j2p,ckp,j1p,t2,e2);
+		for (int j=0;j<d2;j++) row[j]=(ckp+1)*t1[j]*t2[j];
+		top=e1+e2;
+		#else
+		XFloat factor=XFloat((double)(ckp+1))/
+			(thetaX(j2,ckp,m1)*thetaX(j2,ckp,m2)*thetaX(j2m,ckp,j1)*thetaX(j2p,ckp,j1p));
+		std::vector<XFloat> x(d2);
+		top=0;
+		for (int j=0;j<d2;j++)
+			{
+			int ck=LL[k]+2*j;
+			x[j]=factor*tetX(ck,j2,ckp,j2m,m1,j1)*tetX(ck,j2,ckp,j2m,m2,j1);
+			if (x[j].m!=0.0 && x[j].e>top) top=x[j].e;
+			};
+		for (int j=0;j<d2;j++) row[j]=ldexp(x[j].m,x[j].e-top);
+		#endif
 		
-		//	Multiply by the next three matrices
+		//	Renormalise so the largest entry has magnitude between 1/2 and 1
 		
-		TENJfloat *vIn=v0, *vOut=v1, *tmp;
-		for (int k=1;k<=3;k++)
+		TENJfloat big=0.0;
+		for (int j=0;j<d2;j++) if (fabs(row[j])>big) big=fabs(row[j]);
+		int e=0;
+		if (big!=0.0)
 			{
-			//	Set vout = M[k] vin
-			
-			int ks=mod5(lowDim+k), dIn=dim[ks];
-			int ksp=mod5(lowDim+k+1), dOut=dim[ksp];
-			for (int i=0;i<dOut;i++)
-				{
-				TENJfloat vs=0.0;
-				for (int j=0;j<dIn;j++) vs+=M[ks][i][j]*vIn[j];
-				vOut[i]=vs;
-				};
-			
-			//	Swap input/output vectors
-			
-			tmp=vIn;
-			vIn=vOut;
-			vOut=tmp;
+			frexp(big,&e);
+			for (int j=0;j<d2;j++) row[j]=ldexp(row[j],-e);
 			};
+		rowExp[k][i]=top+e;
+		};
+	};
+	
+//	Find the trace of their product, as in tenJTerm()
+
+XFloat trace;
+TENJfloat *v0=&w->xV0[0], *v1=&w->xV1[0];
+int d0=dim[lowDim], d1=dim[mod5(lowDim+1)];
+for (int l0=0;l0<d0;l0++)
+	{
+	for (int i=0;i<d1;i++) v0[i]=M[lowDim][i*d0+l0];
+	int vExp=scaleRows(v0,rowExp[lowDim],d1);
+	
+	TENJfloat *vIn=v0, *vOut=v1, *tmp;
+	for (int k=1;k<=3;k++)
+		{
+		int ks=mod5(lowDim+k), dIn=dim[ks];
+		int ksp=mod5(lowDim+k+1), dOut=dim[ksp];
+		for (int i=0;i<dOut;i++)
+			{
+			TENJfloat vs=0.0, *row=M[ks]+i*dIn;
+			for (int j=0;j<dIn;j++) vs+=row[j]*vIn[j];
+			vOut[i]=vs;
+			};
+		vExp+=scaleRows(vOut,rowExp[ks],dOut);
 		
-		//	Add into trace only the relevant coordinate of product with final matrix
-		
-		int m4=mod5(lowDim+4), dIn=dim[m4];
-		for (int j=0;j<dIn;j++) trace+=M[m4][l0][j]*vIn[j];
+		tmp=vIn;
+		vIn=vOut;
+		vOut=tmp;
 		};
 	
+	int m4=mod5(lowDim+4), dIn=dim[m4];
+	TENJfloat t=0.0, *row=M[m4]+l0*dIn;
+	for (int j=0;j<dIn;j++) t+=row[j]*vIn[j];
+	trace+=XFloat((double)t,vExp+rowExp[m4][l0]);
+	};
+
+//	The term in the sum over the m's
+
+XFloat term=trace*XFloat((double)((m1+1)*(m2+1)*
+	((s->overallParity-(m1+m2)/2)%2==0?1:-1)*(m1!=m2?2:1)));
+return term;
+}
+
+//	tenJ() computes the normalised value of a 10j symbol
+//
+//	twoJ1[]		gives double the values of the spins on the five edges joining
+//				vertices 0 to 1, 1 to 2, 2 to 3, 3 to 4, 4 to 0
+//	twoJ2[]		gives double the values of the spins on the five edges joining
+//				vertices 0 to 2, 1 to 3, 2 to 4, 3 to 0, 4 to 1
+
+TENJfloat tenJ(int *twoJ1, int *twoJ2)
+{
+static thread_local TenJWork work;		//	Matrices and vectors for each step
+TenJSetup s;
+
+if (!tenJSetup(twoJ1,twoJ2,&s))
+	{
+	printf("Array size maxC=%d exceeded; recompile tenJ.cp with higher maxC\n",maxC);
+	exit(1);
+	};
+
+//	Outermost loop:  for mLow<=m2<=m1<=mHigh
+
+TENJfloat sumOverM=0.0;
+int tSteps=s.nSteps, steps=0;
+for (int m1=s.mLow;m1<=s.mHigh;m1+=2)
+for (int m2=s.mLow;m2<=m1;m2+=2)
+	{
+	if (logit>0 && ++steps%logit==1) printf("Starting step %d of %d\n",steps,tSteps);
+	
 	//	Accumulate into the sum over the m's
 	
-	TENJfloat term=(m1+1)*(m2+1)*trace*
-		((overallParity-(m1+m2)/2)%2==0?1:-1);
-	if (m1!=m2) term*=2;
-	sumOverM+=term;
+	sumOverM+=tenJTerm(&s,m1,m2,&work);
 	};
 
 return sumOverM;
 }
 
+//	tenJX() computes the same value as tenJ(int *twoJ1, int *twoJ2), as an XFloat,
+//	so that neither the tets and thetas nor the terms in the sum over the m's can
+//	overflow.  Its matrices are sized to the symbol, so it has no limit maxC; if
+//	they cannot be allocated, the result is NaN.
+
+XFloat tenJX(int *twoJ1, int *twoJ2)
+{
+static thread_local TenJWork work;
+TenJSetup s;
+tenJSetup(twoJ1,twoJ2,&s);
+
+XFloat sumOverM;
+try
+	{
+	for (int m1=s.mLow;m1<=s.mHigh;m1+=2)
+	for (int m2=s.mLow;m2<=m1;m2+=2)
+		sumOverM+=tenJTermX(&s,m1,m2,&work);
+	}
+catch (std::bad_alloc &)
+	{
+	sumOverM.m=NAN;
+	};
+return sumOverM;
+}
 
 //	Version for regular 10j symbol
 
@@ -210,8 +652,8 @@ TENJfloat tenJ(int twoJ)
 {
 int H;									//	Limits on c_i, independent of m's
 int LL, HH, dim;						//	Limits on c_i, taking m's into account
-static TENJfloat M[maxC][maxC];			//	Coefficient matrices
-static TENJfloat v0[maxC], v1[maxC];		//	Vectors used in computing trace
+static thread_local TENJfloat M[maxC][maxC];		//	Coefficient matrices
+static thread_local TENJfloat v0[maxC], v1[maxC];	//	Vectors used in computing trace
 
 //	Low/high limits on c_i, independent of m's
 
@@ -258,13 +700,10 @@ for (int m2=mLow;m2<=m1;m2+=2)
 		int ckp=LL+2*i;
 		#if MERGE_TET_THETA
 		TENJfloat factor=(ckp+1);
-		for (int j=0;j<dim;j++)
-			{
-			int ck=LL+2*j;
-			M[i][j]=
-				factor*tetOnThetas(ck,twoJ,ckp,twoJ,m1,twoJ,twoJ,ckp,m1,twoJ,ckp,twoJ)*
-				tetOnThetas(ck,twoJ,ckp,twoJ,m2,twoJ,twoJ,ckp,m2,twoJ,ckp,twoJ);
-			};
+		TETfloat t1[maxC], t2[maxC];
+		tetOnThetasRow(dim,LL,twoJ,ckp,twoJ,m1,twoJ,twoJ,ckp,m1,twoJ,ckp,twoJ,t1);
+		tetOnThetasRow(dim,LL,twoJ,ckp,twoJ,m2,twoJ,twoJ,ckp,m2,twoJ,ckp,twoJ,t2);
+		for (int j=0;j<dim;j++) M[i][j]=factor*t1[j]*t2[j];
 		#else
 		TENJfloat factor=
 			(ckp+1)/
@@ -0,0 +1,127 @@
+/*
+
+tenj.h
+======
+
+Date:		18 October 2026
+Version:	1.0
+
+This header file declares the C interface of libtenj, the package built as a
+shared or static library, for callers in C, Fortran (through ISO_C_BINDING), Julia
+(through ccall) and anything else that can call C.  Only the functions declared
+here are exported from the shared library, and none of them is overloaded, so
+their names and calling conventions stay the same from one version to the next;
+TENJ_ABI_VERSION changes if they ever have to change.
+
+All spins are passed as double their values, as everywhere in the package.  A 10j
+symbol is ten ints:  twoJ1[0..4] then twoJ2[0..4], as in test.cpp.
+
+The functions without a context can be called from any number of threads at once.
+Those with one use its threads, which are started by tenj_context_new() and kept
+until tenj_context_free(); since the caches of factorials and coefficient matrices
+belong to the threads that fill them, they stay warm from one call to the next.  A
+context can be shared between threads, but its calls run one at a time.
+
+Functions returning int return one of the TENJ_ status codes below; values are
+returned through pointers.
+
+The tenj_client_ functions, in tenjclient.cpp, send the same queries to a 10jd
+server (serverMain.cpp) over a Unix domain socket instead; they need nothing else
+from the package.  A query is a count n, as a uint32, followed by n records of
+eleven int32s:  a kind (TENJ_THETA, TENJ_TET, TENJ_SIXJ or TENJ_TENJ) and ten values
+of 2j, as many as the kind needs followed by zeros.  The reply is n doubles, in the
+same order, with NaN for records that are invalid or too large.  Both are in the
+machine's own byte order.  A record of kind TENJ_STATS returns the server's count
+numbered by its first value (see serverMain.cpp).
+
+*/
+
+#ifndef TENJ_H
+#define TENJ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__GNUC__)
+#define TENJ_API __attribute__((visibility("default")))
+#else
+#define TENJ_API
+#endif
+
+#define TENJ_ABI_VERSION 1
+
+//	Status codes
+
+#define TENJ_OK				0	//	Success
+#define TENJ_TOO_LARGE		1	//	A symbol needs bigger matrices than tenJ.cpp has
+#define TENJ_INVALID		2	//	A null pointer, negative spin or count
+#define TENJ_NO_MEMORY		3	//	Storage or threads could not be allocated
+#define TENJ_IO_ERROR		4	//	The server could not be reached, or hung up
+
+//	Kinds of query for the server
+
+#define TENJ_STATS			0
+#define TENJ_THETA			1
+#define TENJ_TET			2
+#define TENJ_SIXJ			3
+#define TENJ_TENJ			4
+
+#define TENJ_DEFAULT_SOCKET	"/tmp/10jd.socket"
+
+typedef struct tenj_context tenj_context;
+
+//	The version of this interface that the library was built with
+
+TENJ_API int tenj_abi_version(void);
+
+//	A short description of a status code
+
+TENJ_API const char *tenj_status_string(int status);
+
+//	Contexts:  n_threads is the number of threads for batches, including the
+//	caller's; 0 means one for each processor.  Returns NULL on failure.
+
+TENJ_API tenj_context *tenj_context_new(int n_threads);
+TENJ_API void tenj_context_free(tenj_context *ctx);
+TENJ_API int tenj_context_threads(const tenj_context *ctx);
+
+//	Single values:  unnormalised theta and tet nets (Tet[a b e; c d f], as in
+//	tet.cpp) and normalised 6j symbols {j1 j2 j3; j4 j5 j6}.  Negative spins give
+//	NaN, and triads that are not admissible give 0.
+
+TENJ_API double tenj_theta(int a, int b, int c);
+TENJ_API double tenj_tet(int a, int b, int c, int d, int e, int f);
+TENJ_API double tenj_sixj(int j1, int j2, int j3, int j4, int j5, int j6);
+
+//	A single 10j symbol, in the calling thread; ctx may be NULL
+
+TENJ_API int tenj_tenj(tenj_context *ctx, const int *two_j, double *value);
+
+//	Batches:  n records of ten (10j) or six (6j) values of 2j, one after another,
+//	and n values out, shared between the context's threads.  Symbols too large
+//	for tenJ() give NaN, and the return value TENJ_TOO_LARGE; the others are
+//	still computed.  10j symbols are started in order of their predicted cost,
+//	largest first, but the values are in the order of the records.
+
+TENJ_API int tenj_tenj_batch(tenj_context *ctx, long long n, const int *two_j,
+	double *values);
+TENJ_API int tenj_sixj_batch(tenj_context *ctx, long long n, const int *two_j,
+	double *values);
+
+//	Clients of a 10jd server:  path NULL means TENJ_DEFAULT_SOCKET.  A query sends n
+//	records, each a kind and ten values of 2j, and waits for the n values.
+
+typedef struct tenj_client tenj_client;
+
+TENJ_API tenj_client *tenj_client_connect(const char *path);
+TENJ_API void tenj_client_close(tenj_client *client);
+TENJ_API int tenj_client_query(tenj_client *client, int n, const int *kinds,
+	const int *two_j, double *values);
+TENJ_API int tenj_client_tenj(tenj_client *client, const int *two_j, double *value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,130 @@
+/*
+
+tenjclient.cpp
+==============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains the client side of the protocol of the 10jd server
+(serverMain.cpp), declared in tenj.h:
+
+	tenj_client *tenj_client_connect(const char *path)
+	void tenj_client_close(tenj_client *client)
+	int tenj_client_query(tenj_client *client, int n, const int *kinds,
+		const int *two_j, double *values)
+	int tenj_client_tenj(tenj_client *client, const int *two_j, double *value)
+
+A client is one connection to the server, and its queries wait for their replies,
+so a client should be used by one thread at a time; the server computes the
+queries of different clients concurrently.  Sending many records in one query
+saves a round trip for each of them.
+
+This file needs nothing else from the package, so it can be linked into a program
+on its own.
+
+*/
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+#include "tenj.h"
+
+struct tenj_client
+	{
+	int fd;
+	std::vector<int32_t> request;
+	};
+
+//	Send or receive exactly size bytes
+
+static bool sendAll(int fd, const void *buffer, size_t size)
+{
+const char *p=(const char *)buffer;
+while (size>0)
+	{
+	ssize_t k=send(fd,p,size,MSG_NOSIGNAL);
+	if (k<0 && errno==EINTR) continue;
+	if (k<=0) return false;
+	p+=k;
+	size-=k;
+	};
+return true;
+}
+
+static bool receiveAll(int fd, void *buffer, size_t size)
+{
+char *p=(char *)buffer;
+while (size>0)
+	{
+	ssize_t k=recv(fd,p,size,0);
+	if (k<0 && errno==EINTR) continue;
+	if (k<=0) return false;
+	p+=k;
+	size-=k;
+	};
+return true;
+}
+
+tenj_client *tenj_client_connect(const char *path)
+{
+if (path==NULL) path=TENJ_DEFAULT_SOCKET;
+sockaddr_un address;
+if (strlen(path)>=sizeof(address.sun_path)) return NULL;
+memset(&address,0,sizeof(address));
+address.sun_family=AF_UNIX;
+strcpy(address.sun_path,path);
+
+int fd=socket(AF_UNIX,SOCK_STREAM,0);
+if (fd<0) return NULL;
+if (connect(fd,(sockaddr *)&address,sizeof(address))<0)
+	{
+	close(fd);
+	return NULL;
+	};
+tenj_client *client=new tenj_client;
+client->fd=fd;
+return client;
+}
+
+void tenj_client_close(tenj_client *client)
+{
+if (client==NULL) return;
+close(client->fd);
+delete client;
+}
+
+int tenj_client_query(tenj_client *client, int n, const int *kinds,
+	const int *two_j, double *values)
+{
+if (client==NULL || n<0 || (n>0 && (kinds==NULL || two_j==NULL || values==NULL)))
+	return TENJ_INVALID;
+if (n==0) return TENJ_OK;
+
+//	The count, then a kind and ten values of 2j for each record
+
+std::vector<int32_t> &r=client->request;
+r.resize(1+11*(size_t)n);
+r[0]=(int32_t)n;
+for (int k=0;k<n;k++)
+	{
+	r[1+11*k]=kinds[k];
+	for (int i=0;i<10;i++) r[2+11*k+i]=two_j[10*k+i];
+	};
+if (!sendAll(client->fd,&r[0],r.size()*sizeof(int32_t)) ||
+	!receiveAll(client->fd,values,n*sizeof(double))) return TENJ_IO_ERROR;
+return TENJ_OK;
+}
+
+int tenj_client_tenj(tenj_client *client, const int *two_j, double *value)
+{
+int kind=TENJ_TENJ;
+int status=tenj_client_query(client,1,&kind,two_j,value);
+if (status==TENJ_OK && *value!=*value) status=TENJ_TOO_LARGE;
+return status;
+}
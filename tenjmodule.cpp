@@ -0,0 +1,263 @@
+/*
+
+tenjmodule.cpp
+==============
+
+Date:		18 October 2026
+Version:	1.0
+
+This file contains a CPython extension module, "tenj", that gives Python and Sage
+direct access to the routines of the package, without running the 10j program
+and parsing its output.  As everywhere else, the arguments are double the spins.
+
+	tenj.theta(a, b, c)
+	tenj.tet(a, b, c, d, e, f)			Tet[a b e; c d f], as in tet.cpp
+	tenj.sixj(j1, j2, j3, j4, j5, j6)	the normalised 6j symbol, as in 6j.cpp
+	tenj.tenj(twoJ)						a regular 10j symbol
+	tenj.tenj(twoJ1_0, ..., twoJ1_4, twoJ2_0, ..., twoJ2_4)
+
+return floats.  As in libtenj, a theta or tet whose triads are not admissible is
+0.0.  A 10j symbol too large for the coefficient matrices in tenJ.cpp raises
+ValueError, rather than ending the program as tenJ() would.
+
+	tenj.tenj_batch(spins, out, threads=0)
+
+evaluates many 10j symbols at once.  spins is any object with a C-contiguous
+buffer of 32-bit ints (an array.array('i'), a numpy int32 array of shape (n, 10),
+a memoryview ...), holding records of ten values of 2j, twoJ1[0..4] then
+twoJ2[0..4], as in the binary input of 10jstream; out is a writable C-contiguous
+buffer of n doubles, which is filled in place.  Symbols too large for the
+coefficient matrices give nan.  Neither buffer is copied.
+
+The interpreter lock is released while the symbols are computed by
+tenj_tenj_batch() (libtenj.cpp), so other Python threads keep running.  Its threads
+(default: one for each processor) belong to a libtenj context, which the module
+keeps for each number of threads asked for, so they are only started by the first
+call; calls from several Python threads with the same number share the context,
+and run one at a time.  The symbols are handed out most expensive first, by the
+time tenJPlan() predicts for them, and each is computed entirely in one thread, so
+the values are the same as from tenJ() whatever the number of threads.
+
+To build it, compile the library, including libtenj.cpp, with the module into a
+shared object:
+
+	g++ -O2 -shared -fPIC -pthread $(python3-config --includes) \
+		-o tenj$(python3-config --extension-suffix) tenjmodule.cpp <library .cpp files>
+
+*/
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <map>
+#include <stdint.h>
+#include "spin.h"
+#include "tenj.h"
+
+//	The contexts for batches, by number of threads; they are only created and
+//	looked up with the interpreter lock held, and freed when Python exits
+
+static std::map<int,tenj_context *> contexts;
+
+static void freeContexts()
+{
+for (std::map<int,tenj_context *>::iterator it=contexts.begin();it!=contexts.end();it++)
+	tenj_context_free(it->second);
+contexts.clear();
+}
+
+static tenj_context *getContext(int nThreads)
+{
+std::map<int,tenj_context *>::iterator it=contexts.find(nThreads);
+if (it!=contexts.end()) return it->second;
+tenj_context *ctx=tenj_context_new(nThreads);
+if (ctx!=NULL)
+	{
+	if (contexts.empty()) Py_AtExit(freeContexts);
+	contexts[nThreads]=ctx;
+	};
+return ctx;
+}
+
+static bool triad(int a, int b, int c)
+{
+return (a+b+c)%2==0 && a<=b+c && b<=a+c && c<=a+b;
+}
+
+//	Parse a tuple of n non-negative ints
+
+static bool parseSpins(PyObject *args, int n, int *twoJ)
+{
+if (PyTuple_GET_SIZE(args)!=n)
+	{
+	PyErr_Format(PyExc_TypeError,"expected %d values of 2j, got %zd",n,PyTuple_GET_SIZE(args));
+	return false;
+	};
+for (int i=0;i<n;i++)
+	{
+	long v=PyLong_AsLong(PyTuple_GET_ITEM(args,i));
+	if (v==-1 && PyErr_Occurred()) return false;
+	if (v<0 || v>INT_MAX)
+		{
+		PyErr_SetString(PyExc_ValueError,"values of 2j must be non-negative ints");
+		return false;
+		};
+	twoJ[i]=(int)v;
+	};
+return true;
+}
+
+//	Is a buffer format a single native item of the given struct code?
+
+static bool formatIs(const char *format, char code)
+{
+if (format==NULL) return code=='B';
+if (*format=='@' || *format=='=') format++;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__==__ORDER_LITTLE_ENDIAN__
+else if (*format=='<') format++;
+#elif defined(__BYTE_ORDER__)
+else if (*format=='>' || *format=='!') format++;
+#endif
+return format[0]==code && format[1]==0;
+}
+
+static PyObject *pyTheta(PyObject *self, PyObject *args)
+{
+int j[3];
+if (!parseSpins(args,3,j)) return NULL;
+if (!triad(j[0],j[1],j[2])) return PyFloat_FromDouble(0.0);
+return PyFloat_FromDouble(theta(j[0],j[1],j[2]));
+}
+
+static PyObject *pyTet(PyObject *self, PyObject *args)
+{
+int j[6];
+if (!parseSpins(args,6,j)) return NULL;
+if (!(triad(j[0],j[1],j[5]) && triad(j[1],j[2],j[4]) && triad(j[2],j[3],j[5]) &&
+	triad(j[0],j[3],j[4]))) return PyFloat_FromDouble(0.0);
+return PyFloat_FromDouble(tet(j[0],j[1],j[2],j[3],j[4],j[5]));
+}
+
+static PyObject *pySixJ(PyObject *self, PyObject *args)
+{
+int j[6];
+if (!parseSpins(args,6,j)) return NULL;
+return PyFloat_FromDouble(sixJ(j[0],j[1],j[2],j[3],j[4],j[5]));
+}
+
+static PyObject *pyTenJ(PyObject *self, PyObject *args)
+{
+int j[10];
+if (PyTuple_GET_SIZE(args)==1)
+	{
+	if (!parseSpins(args,1,j)) return NULL;
+	for (int i=1;i<10;i++) j[i]=j[0];
+	}
+else if (!parseSpins(args,10,j)) return NULL;
+
+double value;
+int status;
+Py_BEGIN_ALLOW_THREADS
+status=tenj_tenj(NULL,j,&value);
+Py_END_ALLOW_THREADS
+if (status==TENJ_NO_MEMORY) return PyErr_NoMemory();
+if (status!=TENJ_OK)
+	{
+	PyErr_SetString(PyExc_ValueError,tenj_status_string(status));
+	return NULL;
+	};
+return PyFloat_FromDouble(value);
+}
+
+static PyObject *pyTenJBatch(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+static const char *keywords[]={"spins","out","threads",NULL};
+PyObject *spinsObject, *outObject;
+int nThreads=0;
+if (!PyArg_ParseTupleAndKeywords(args,kwargs,"OO|i",(char **)keywords,
+	&spinsObject,&outObject,&nThreads)) return NULL;
+
+Py_buffer spins, out;
+if (PyObject_GetBuffer(spinsObject,&spins,PyBUF_C_CONTIGUOUS | PyBUF_FORMAT)<0) return NULL;
+if (PyObject_GetBuffer(outObject,&out,PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | PyBUF_WRITABLE)<0)
+	{
+	PyBuffer_Release(&spins);
+	return NULL;
+	};
+
+const char *error=NULL;
+Py_ssize_t n=spins.len/(10*sizeof(int32_t));
+if (spins.itemsize!=4 || !(formatIs(spins.format,'i') ||
+	(sizeof(long)==4 && formatIs(spins.format,'l'))))
+	error="spins must be a buffer of 32-bit ints";
+else if (out.itemsize!=8 || !formatIs(out.format,'d'))
+	error="out must be a buffer of doubles";
+else if (spins.len%(10*sizeof(int32_t))!=0)
+	error="spins must hold a whole number of records of ten values of 2j";
+else if (out.len!=n*(Py_ssize_t)sizeof(double))
+	error="out must have one double for each record in spins";
+else
+	{
+	const int32_t *twoJ=(const int32_t *)spins.buf;
+	for (Py_ssize_t k=0;k<10*n;k++)
+		if (twoJ[k]<0)
+			{
+			error="values of 2j must be non-negative";
+			break;
+			};
+	};
+if (error!=NULL)
+	{
+	PyErr_SetString(PyExc_ValueError,error);
+	PyBuffer_Release(&spins);
+	PyBuffer_Release(&out);
+	return NULL;
+	};
+
+tenj_context *ctx=getContext(nThreads<1 ? 0 : nThreads);
+if (ctx==NULL)
+	{
+	PyBuffer_Release(&spins);
+	PyBuffer_Release(&out);
+	return PyErr_NoMemory();
+	};
+
+//	Symbols too large for tenJ() are left as nan, and not an error
+
+int status;
+Py_BEGIN_ALLOW_THREADS
+status=tenj_tenj_batch(ctx,(long long)n,(const int *)spins.buf,(double *)out.buf);
+Py_END_ALLOW_THREADS
+
+PyBuffer_Release(&spins);
+PyBuffer_Release(&out);
+if (status==TENJ_NO_MEMORY) return PyErr_NoMemory();
+Py_RETURN_NONE;
+}
+
+static PyMethodDef tenjMethods[]=
+	{
+	{"theta",pyTheta,METH_VARARGS,
+		"theta(a, b, c): the unnormalised theta net, with arguments double the spins"},
+	{"tet",pyTet,METH_VARARGS,
+		"tet(a, b, c, d, e, f): the unnormalised tetrahedral net Tet[a b e; c d f]"},
+	{"sixj",pySixJ,METH_VARARGS,
+		"sixj(j1, j2, j3, j4, j5, j6): the normalised 6j symbol {j1 j2 j3; j4 j5 j6}"},
+	{"tenj",pyTenJ,METH_VARARGS,
+		"tenj(twoJ) or tenj(twoJ1_0, ..., twoJ1_4, twoJ2_0, ..., twoJ2_4): a 10j symbol"},
+	{"tenj_batch",(PyCFunction)(void (*)(void))pyTenJBatch,METH_VARARGS | METH_KEYWORDS,
+		"tenj_batch(spins, out, threads=0): fill the doubles of out with the 10j symbols\n"
+		"for the records of ten int32 values of 2j in spins, without the GIL"},
+	{NULL,NULL,0,NULL}
+	};
+
+static struct PyModuleDef tenjModule=
+	{
+	PyModuleDef_HEAD_INIT,"tenj",
+	"Theta nets, tets, 6j and 10j symbols, with arguments double the spins",
+	-1,tenjMethods
+	};
+
+PyMODINIT_FUNC PyInit_tenj()
+{
+return PyModule_Create(&tenjModule);
+}
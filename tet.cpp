@@ -41,68 +41,590 @@ computes the value of the same unnormalised tetrahedral net, divided by two
 theta nets, in a form that is useful for the 10j symbol calculations, and which
 offers greater possibilities for the cancellation of factorials.
 
+tetX() and tetOnThetasX() compute the same values as XFloats, which cannot overflow.
+
+tetOnThetasRow() computes tetOnThetas() for a whole row of a coefficient matrix in
+tenJ.cpp, where only the first spin changes along the row, several tets at a time;
+tetOnThetasRowX() computes the same row relative to a power of 2, for tenJX().
+tetOnThetasRecursion() computes the same row from five tets and the recursion of
+Schulten and Gordon, with O(1) work for each of the others, and reports whether
+it kept its precision; tetOnThetasRow() uses it first if RECURSE_TET_ROWS is true.
+
+tetOnRootThetas(int a, int b, int c, int d, int e, int f) computes the same net
+divided by the square root of the absolute value of the product of the theta nets
+on its four triangles, which is the normalised 6j symbol.  The thetas and the
+square root are taken inside a single factorial ratio, so the result stays in range.
+
 Reference:	L. Kauffman and S. Lins, Temperley-Lieb Recoupling Theory and
 			invariants of 3-Manifolds, Princeton University Press,
 			Princeton,  1994.
 
 */
 
+#include <vector>
 #include "spin.h"
+#if USE_PRIME_POWERS
+#include "PrimePowers.h"
+#endif
+
+//	Number of tets tetOnThetasRow() works out side by side:  one vector register
+//	of doubles for the target
+
+#if defined(__AVX512F__)
+#define tetLanes 8
+#elif defined(__AVX__)
+#define tetLanes 4
+#else
+#define tetLanes 2
+#endif
 
 //	Declarations for private helper functions in this file
 
 int arrayMin(int *array, int size);
 int arrayMax(int *array, int size);
+static TETfloat tetSum(int a, int b, int c, int d, int e, int f, int *aa, int *bb, int &ls);
+static bool tetFactorials(int a, int b, int c, int d, int e, int f, int *nn, int *dd,
+	TETfloat &sum);
+static bool tetOnThetasFactorials(int a, int b, int c, int d, int e, int f,
+	int twoJ1a, int twoJ2a, int twoJ3a, int twoJ1b, int twoJ2b, int twoJ3b,
+	int *nn, int *dd, TETfloat &sum);
 
 //	tet()
 //	=====
 
 TETfloat tet(int a, int b, int c, int d, int e, int f)
 {
-int aa[]={(a+b+f)/2, (b+c+e)/2, (c+d+f)/2, (a+d+e)/2};
-int bb[]={(b+d+e+f)/2, (a+c+e+f)/2, (a+b+c+d)/2};
+int nn[13], dd[13];
+TETfloat sum;
+bool negative=tetFactorials(a,b,c,d,e,f,nn,dd,sum);
+TETfloat commonFactor=multiRatio(nn, dd, 13);
+if (negative) commonFactor=-commonFactor;
+TETfloat result=sum*commonFactor;
+
+return result;
+}
+
+//	tetOnThetas()
+//	=============
+
+TETfloat tetOnThetas(int a, int b, int c, int d, int e, int f,
+	int twoJ1a, int twoJ2a, int twoJ3a, int twoJ1b, int twoJ2b, int twoJ3b)
+{
+int nn[21], dd[21];
+TETfloat sum;
+bool negative=tetOnThetasFactorials(a,b,c,d,e,f,
+	twoJ1a,twoJ2a,twoJ3a,twoJ1b,twoJ2b,twoJ3b,nn,dd,sum);
+TETfloat commonFactor=multiRatio(nn, dd, 21);
+if (negative) commonFactor=-commonFactor;
+TETfloat result=sum*commonFactor;
+
+return result;
+}
+
+//	tetOnThetasRow()
+//	================
+//
+//	Set out[j] to tetOnThetas(a0+2j, b, c, d, e, f, ...) for 0 <= j < n, by
+//	tetOnThetasRecursion() if RECURSE_TET_ROWS is true and it succeeds.  Otherwise the
+//	tets are worked out tetLanes at a time, in vectors with one lane for each tet, using
+//	the vector extensions of GCC and Clang; each step of tetOnThetas() is applied to
+//	all the lanes at once, and masked where a lane's sum is shorter than the others.
+//	Every lane goes through the same floating point operations as tetOnThetas(), in
+//	the same order, so the results are the same, bit for bit.  That relies on
+//	multiRatio() multiplying out prime powers in doubles, so with floating point
+//	factorials, other compilers, or TETfloat or PPfloat other than double, the row
+//	is just a loop over tetOnThetas().
+
+#if USE_PRIME_POWERS && defined(__GNUC__)
+#define TET_LANES_VECTOR true
+
+typedef double LaneFloat __attribute__((vector_size(tetLanes*sizeof(double))));
+typedef long long LaneInt __attribute__((vector_size(tetLanes*sizeof(long long))));
+
+#define toLaneFloat(v) __builtin_convertvector(v,LaneFloat)
+
+static void tetOnThetasLanes(int nLanes, int a0, int b, int c, int d, int e, int f,
+	int twoJ1a, int twoJ2a, int twoJ3a, int twoJ1b, int twoJ2b, int twoJ3b, TETfloat *out,
+	int *outExp)
+{
+const int W=tetLanes;
+
+//	Bounds of each lane's sum; spare lanes repeat the last tet
+
+LaneInt a;
+for (int l=0;l<W;l++) a[l]=a0+2*(l<nLanes ? l : nLanes-1);
+LaneInt aa[4]={(a+b+f)/2, a-a+(b+c+e)/2, a-a+(c+d+f)/2, (a+d+e)/2};
+LaneInt bb[3]={a-a+(b+d+e+f)/2, (a+c+e+f)/2, (a+b+c+d)/2};
+LaneInt lo=aa[0], hi=bb[0];
+for (int i=1;i<4;i++) lo=aa[i]>lo ? aa[i] : lo;
+for (int i=1;i<3;i++) hi=bb[i]<hi ? bb[i] : hi;
+int nMax=0;
+for (int l=0;l<W;l++) if (hi[l]-lo[l]+1>nMax) nMax=(int)(hi[l]-lo[l]+1);
+
+//	Ratios between consecutive terms, R[t-1] being the one into the term at lo+t,
+//	and the peak of each sum, as in tetSum()
+
+LaneFloat local[MAX_TABLE_FACTORIAL];
+std::vector<LaneFloat> heap;
+LaneFloat *R=local;
+if (nMax-1>MAX_TABLE_FACTORIAL)
+	{
+	heap.resize(nMax-1);
+	R=&heap[0];
+	};
+
+LaneInt ls=lo;
+LaneFloat lg=toLaneFloat(a-a)+1e30;
+for (int t=1;t<nMax;t++)
+	{
+	LaneInt s=lo+t, sm=s-1;
+	LaneFloat num=toLaneFloat(s+1)*toLaneFloat(bb[0]-sm);
+	num=num*toLaneFloat(bb[1]-sm);
+	num=num*toLaneFloat(bb[2]-sm);
+	LaneFloat den=toLaneFloat(s-aa[0])*toLaneFloat(s-aa[1]);
+	den=den*toLaneFloat(s-aa[2]);
+	den=den*toLaneFloat(s-aa[3]);
+	LaneFloat rr=R[t-1]=-num/den;
+	LaneFloat x=rr+1;
+	LaneFloat g=x>=0 ? x : -x;
+	LaneInt better=(s<=hi) & (g<lg);
+	ls=better ? s : ls;
+	lg=better ? g : lg;
+	};
+
+//	Sum outwards from the peak, one term on each side per step
+
+LaneFloat sum=toLaneFloat(a-a)+1.0, term1=sum, term2=sum;
+int steps=0;
+for (int l=0;l<W;l++)
+	{
+	if (hi[l]-ls[l]>steps) steps=(int)(hi[l]-ls[l]);
+	if (ls[l]-lo[l]>steps) steps=(int)(ls[l]-lo[l]);
+	};
+for (int k=0;k<steps;k++)
+	{
+	LaneInt ok1=ls+1+k<=hi, ok2=ls-1-k>=lo;
+	LaneFloat r1, r2;
+	for (int l=0;l<W;l++)
+		{
+		r1[l]=ok1[l] ? R[ls[l]-lo[l]+k][l] : 1.0;
+		r2[l]=ok2[l] ? R[ls[l]-lo[l]-1-k][l] : 1.0;
+		};
+	term1=ok1 ? term1*r1 : term1;
+	sum=ok1 ? sum+term1 : sum;
+	term2=ok2 ? term2/r2 : term2;
+	sum=ok2 ? sum+term2 : sum;
+	};
+
+//	The factorials of the common factor, as in tetOnThetasFactorials(); those that
+//	vary along the row are listed for each lane, and the rest once
+
+int sumJa=(twoJ1a+twoJ2a+twoJ3a)/2, sumJb=(twoJ1b+twoJ2b+twoJ3b)/2;
+LaneInt vn[11], vd[8];
+vn[0]=bb[0]-aa[0]; vn[1]=bb[0]-aa[3];
+for (int j=0;j<4;j++)
+	{
+	vn[2+j]=bb[1]-aa[j];
+	vn[6+j]=bb[2]-aa[j];
+	vd[1+j]=ls-aa[j];
+	};
+vn[10]=ls+1;
+vd[0]=a;
+for (int i=0;i<3;i++) vd[5+i]=bb[i]-ls;
+int cn[8]={(int)(bb[0][0]-aa[1][0]), (int)(bb[0][0]-aa[2][0]),
+	twoJ1a, twoJ2a, twoJ3a, twoJ1b, twoJ2b, twoJ3b};
+int cd[13]={b, c, d, e, f, sumJa-twoJ1a, sumJa-twoJ2a, sumJa-twoJ3a, sumJa+1,
+	sumJb-twoJ1b, sumJb-twoJ2b, sumJb-twoJ3b, sumJb+1};
+
+int top=0;
+for (int i=0;i<8;i++) if (cn[i]>top) top=cn[i];
+for (int i=0;i<13;i++) if (cd[i]>top) top=cd[i];
+for (int l=0;l<W;l++)
+	{
+	for (int i=0;i<11;i++) if (vn[i][l]>top) top=(int)vn[i][l];
+	for (int i=0;i<8;i++) if (vd[i][l]>top) top=(int)vd[i][l];
+	};
+
+//	Powers of the primes in the common factor, multiplied out in the same order as
+//	PrimePowers::evaluate():  all the lanes with a positive power of a prime
+//	multiply by it together, then all those with a negative power divide
+
+int stride, nPrimes;
+const int *primes, *table=factorialPowers(top,stride,nPrimes,primes);
+static thread_local std::vector<int> powerStore;
+powerStore.assign((W+1)*nPrimes,0);
+int *base=&powerStore[W*nPrimes];
+for (int i=0;i<8;i++)
+	{
+	const int *row=table+cn[i]*stride;
+	for (int p=0;p<nPrimes;p++) base[p]+=row[p];
+	};
+for (int i=0;i<13;i++)
+	{
+	const int *row=table+cd[i]*stride;
+	for (int p=0;p<nPrimes;p++) base[p]-=row[p];
+	};
+for (int l=0;l<W;l++)
+	{
+	int *power=&powerStore[l*nPrimes];
+	for (int p=0;p<nPrimes;p++) power[p]=base[p];
+	for (int i=0;i<11;i++)
+		{
+		const int *row=table+vn[i][l]*stride;
+		for (int p=0;p<nPrimes;p++) power[p]+=row[p];
+		};
+	for (int i=0;i<8;i++)
+		{
+		const int *row=table+vd[i][l]*stride;
+		for (int p=0;p<nPrimes;p++) power[p]-=row[p];
+		};
+	};
+
+//
+//	With outExp, the product is kept as prod * 2^pExp, so it cannot overflow:  the
+//	powers of 2 go straight into pExp, and prod is renormalised after every
+//	xChunk factors of any other prime.  Scaling by powers of 2 is exact, so the
+//	mantissas are those the plain product would have, wherever it stays in range.
+
+const int xChunk=32;
+LaneFloat prod=toLaneFloat(a-a)+1.0;
+LaneInt pExp=a-a;
+for (int p=0;p<nPrimes;p++)
+	{
+	LaneInt power;
+	int up=0, down=0;
+	for (int l=0;l<W;l++)
+		{
+		int n=powerStore[l*nPrimes+p];
+		power[l]=n;
+		if (n>up) up=n;
+		if (-n>down) down=-n;
+		};
+	double factor=primes[p];
+	if (outExp==NULL)
+		{
+		for (int j=0;j<up;j++) prod=j<power ? prod*factor : prod;
+		for (int j=0;j<down;j++) prod=j<-power ? prod/factor : prod;
+		}
+	else if (primes[p]==2)
+		pExp+=power;
+	else
+		{
+		for (int j=0;j<up;j++)
+			{
+			prod=j<power ? prod*factor : prod;
+			if (j%xChunk==xChunk-1 || j==up-1)
+				for (int l=0;l<W;l++) {int k; prod[l]=frexp(prod[l],&k); pExp[l]+=k;};
+			};
+		for (int j=0;j<down;j++)
+			{
+			prod=j<-power ? prod/factor : prod;
+			if (j%xChunk==xChunk-1 || j==down-1)
+				for (int l=0;l<W;l++) {int k; prod[l]=frexp(prod[l],&k); pExp[l]+=k;};
+			};
+		};
+	};
+
+for (int l=0;l<nLanes;l++)
+	{
+	TETfloat commonFactor=(FACTfloat)prod[l];
+	if ((ls[l]+sumJa+sumJb)%2==1) commonFactor=-commonFactor;
+	out[l]=sum[l]*commonFactor;
+	if (outExp!=NULL) outExp[l]=(int)pExp[l];
+	};
+}
+
+#else
+#define TET_LANES_VECTOR false
+#endif
+
+//	tetOnThetasRecursion()
+//	======================
+//
+//	Set out[j] to tetOnThetas(a0+2j, b, c, d, e, f, ...) for 0 <= j < n, by the
+//	three-term recursion in j1 of Schulten and Gordon (see 6j.cpp) for the 6j
+//	symbol {a/2 b/2 f/2; c/2 d/2 e/2}.  The thetas divided out are fixed along the
+//	row, and the tet is the 6j symbol times sqrt|theta(a,b,f) theta(a,d,e)| times
+//	constants, so taking those square roots into the coefficients gives
+//
+//		A(a) t(a+2) + F(a) t(a) + C(a) t(a-2) = 0
+//
+//	where, with x, y, z the internal spins opposite a, f (or e) and b (or d), and s
+//	the half-perimeter, in each of the two triangles:
+//
+//		A(a) = (a/2) x1 x2 (a+1)(a+2)
+//		C(a) = (a/2+1) y1 z1 (s1+1) y2 z2 (s2+1) / (a(a-1))
+//
+//	and F is Schulten and Gordon's F(j1); these are rational, with no square roots.
+//
+//	Upwards, the recursion is stable below the classically allowed region, where
+//	the wanted solution grows, and downwards above it; inside it, where the roots
+//	of the characteristic equation A x^2 + F x + C = 0 are complex, both ways are.
+//	So it is run up from two exact values at the start of the row and down from two
+//	at the end, to meet in the middle of the allowed part of the row.  A fifth exact
+//	value there checks both, and if either differs from it by more than
+//	tetRecursionTolerance times the largest value in the row, the function returns
+//	false; the caller should then evaluate the row directly.
+
+//	Rows shorter than this are not worth the five direct evaluations
+
+#define minTetRecursion 8
+
+//	Largest error allowed at the meeting point, relative to the largest value
+
+#define tetRecursionTolerance 1e-13
+
+static void tetRecursionCoefficients(int a, int b, int c, int d, int e, int f,
+	TETfloat &A, TETfloat &F, TETfloat &C)
+{
+double x1=(b+f-a)/2, y1=(a+f-b)/2, z1=(a+b-f)/2, s1=(a+b+f)/2;
+double x2=(d+e-a)/2, y2=(a+e-d)/2, z2=(a+d-e)/2, s2=(a+d+e)/2;
+double J1=a*(a+2)/4.0, J2=b*(b+2)/4.0, J3=f*(f+2)/4.0;
+double L1=c*(c+2)/4.0, L2=d*(d+2)/4.0, L3=e*(e+2)/4.0;
+A=0.5*a*x1*x2*(a+1.0)*(a+2.0);
+F=(a+1.0)*(J1*(-J1+J2+J3-2*L1)+L2*(J1+J2-J3)+L3*(J1-J2+J3));
+C=a<2 ? 0.0 : (0.5*a+1.0)*y1*z1*(s1+1)*y2*z2*(s2+1)/(a*(a-1.0));
+}
+
+//	recursionRow() does the work for tetOnThetasRecursion() and, if extended is true,
+//	for tetOnThetasRowX():  the exact values are then XFloats, taken relative to the
+//	largest of them, 2^rowExp, and the recursion fails if the row goes out of range.
+
+static bool recursionRow(int n, int a0, int b, int c, int d, int e, int f,
+	int twoJ1a, int twoJ2a, int twoJ3a, int twoJ1b, int twoJ2b, int twoJ3b, TETfloat *out,
+	bool extended, int &rowExp)
+{
+rowExp=0;
+if (n<minTetRecursion) return false;
+
+static thread_local std::vector<TETfloat> store;
+store.resize(3*n);
+TETfloat *A=&store[0], *F=&store[n], *C=&store[2*n];
+
+//	Meet in the middle of the classically allowed part of the row, if any
+
+int first=-1, last=-1;
+for (int j=1;j<n-1;j++)
+	{
+	tetRecursionCoefficients(a0+2*j,b,c,d,e,f,A[j],F[j],C[j]);
+	if (A[j]==0.0 || C[j]==0.0) return false;
+	if (F[j]*F[j]<4*A[j]*C[j])
+		{
+		if (first<0) first=j;
+		last=j;
+		};
+	};
+int m=first<0 ? n/2 : (first+last)/2;
+if (m<2) m=2;
+if (m>n-3) m=n-3;
+
+TETfloat exact;
+int at[5]={0,1,n-2,n-1,m};
+if (extended)
+	{
+	XFloat x[5];
+	for (int i=0;i<5;i++)
+		{
+		x[i]=tetOnThetasX(a0+2*at[i],b,c,d,e,f,twoJ1a,twoJ2a,twoJ3a,twoJ1b,twoJ2b,twoJ3b);
+		if (x[i].m!=0.0 && (rowExp==0 || x[i].e>rowExp)) rowExp=x[i].e;
+		};
+	for (int i=0;i<4;i++) out[at[i]]=ldexp(x[i].m,x[i].e-rowExp);
+	exact=ldexp(x[4].m,x[4].e-rowExp);
+	}
+else
+	{
+	for (int i=0;i<4;i++)
+		out[at[i]]=tetOnThetas(a0+2*at[i],b,c,d,e,f,twoJ1a,twoJ2a,twoJ3a,twoJ1b,twoJ2b,twoJ3b);
+	exact=tetOnThetas(a0+2*m,b,c,d,e,f,twoJ1a,twoJ2a,twoJ3a,twoJ1b,twoJ2b,twoJ3b);
+	};
+
+//	Upwards to the meeting point, then downwards to it
+
+for (int j=1;j<m;j++) out[j+1]=-(F[j]*out[j]+C[j]*out[j-1])/A[j];
+TETfloat up=out[m];
+for (int j=n-2;j>m;j--) out[j-1]=-(F[j]*out[j]+A[j]*out[j+1])/C[j];
+TETfloat down=out[m];
+out[m]=exact;
+
+TETfloat big=0.0;
+for (int j=0;j<n;j++) if (fabs(out[j])>big) big=fabs(out[j]);
+if (extended && !isfinite(big)) return false;
+return fabs(up-exact)<=tetRecursionTolerance*big && fabs(down-exact)<=tetRecursionTolerance*big;
+}
+
+bool tetOnThetasRecursion(int n, int a0, int b, int c, int d, int e, int f,
+	int twoJ1a, int twoJ2a, int twoJ3a, int twoJ1b, int twoJ2b, int twoJ3b, TETfloat *out)
+{
+int rowExp;
+return recursionRow(n,a0,b,c,d,e,f,twoJ1a,twoJ2a,twoJ3a,twoJ1b,twoJ2b,twoJ3b,out,false,rowExp);
+}
+
+void tetOnThetasRow(int n, int a0, int b, int c, int d, int e, int f,
+	int twoJ1a, int twoJ2a, int twoJ3a, int twoJ1b, int twoJ2b, int twoJ3b, TETfloat *out)
+{
+#if RECURSE_TET_ROWS
+if (tetOnThetasRecursion(n,a0,b,c,d,e,f,twoJ1a,twoJ2a,twoJ3a,twoJ1b,twoJ2b,twoJ3b,out))
+	return;
+#endif
+#if TET_LANES_VECTOR
+
+//	Tets whose factorials are all in the compiler's tables are quicker one at a
+//	time; the largest factorial is at most one more than a quadrilateral sum
+
+int aMax=a0+2*(n-1), top=(b+d+e+f)/2;
+if ((aMax+c+e+f)/2>top) top=(aMax+c+e+f)/2;
+if ((aMax+b+c+d)/2>top) top=(aMax+b+c+d)/2;
+if ((twoJ1a+twoJ2a+twoJ3a)/2>top) top=(twoJ1a+twoJ2a+twoJ3a)/2;
+if ((twoJ1b+twoJ2b+twoJ3b)/2>top) top=(twoJ1b+twoJ2b+twoJ3b)/2;
+if (top+1>MAX_TABLE_FACTORIAL && sizeof(TETfloat)==sizeof(double) &&
+	sizeof(PPfloat)==sizeof(double))
+	{
+	int j=0;
+	for (;n-j>1;j+=tetLanes)
+		tetOnThetasLanes(n-j<tetLanes ? n-j : tetLanes,a0+2*j,b,c,d,e,f,
+			twoJ1a,twoJ2a,twoJ3a,twoJ1b,twoJ2b,twoJ3b,out+j,NULL);
+	if (j<n) out[j]=tetOnThetas(a0+2*j,b,c,d,e,f,twoJ1a,twoJ2a,twoJ3a,twoJ1b,twoJ2b,twoJ3b);
+	return;
+	};
+#endif
+for (int j=0;j<n;j++)
+	out[j]=tetOnThetas(a0+2*j,b,c,d,e,f,twoJ1a,twoJ2a,twoJ3a,twoJ1b,twoJ2b,twoJ3b);
+}
+
+//	tetOnThetasRowX()
+//	=================
+//
+//	The same row as tetOnThetasRow(), as out[j] * 2^rowExp, where 2^rowExp is the
+//	power of 2 above the largest value, so the row cannot overflow whatever the
+//	spins.  It is computed by the same two methods, the lanes keeping an exponent
+//	for each tet; values less than 2^-1074 of the largest in the row become zero.
+
+void tetOnThetasRowX(int n, int a0, int b, int c, int d, int e, int f,
+	int twoJ1a, int twoJ2a, int twoJ3a, int twoJ1b, int twoJ2b, int twoJ3b,
+	TETfloat *out, int &rowExp)
+{
+#if RECURSE_TET_ROWS
+if (recursionRow(n,a0,b,c,d,e,f,twoJ1a,twoJ2a,twoJ3a,twoJ1b,twoJ2b,twoJ3b,out,true,rowExp))
+	return;
+#endif
+static thread_local std::vector<int> exps;
+exps.resize(n);
+#if TET_LANES_VECTOR
+if (sizeof(TETfloat)==sizeof(double) && sizeof(PPfloat)==sizeof(double))
+	for (int j=0;j<n;j+=tetLanes)
+		tetOnThetasLanes(n-j<tetLanes ? n-j : tetLanes,a0+2*j,b,c,d,e,f,
+			twoJ1a,twoJ2a,twoJ3a,twoJ1b,twoJ2b,twoJ3b,out+j,&exps[j]);
+else
+#endif
+for (int j=0;j<n;j++)
+	{
+	XFloat x=tetOnThetasX(a0+2*j,b,c,d,e,f,twoJ1a,twoJ2a,twoJ3a,twoJ1b,twoJ2b,twoJ3b);
+	out[j]=x.m;
+	exps[j]=x.e;
+	};
+
+//	Take the values relative to the largest
+
+rowExp=0;
+bool any=false;
+for (int j=0;j<n;j++)
+	if (out[j]!=0.0)
+		{
+		int k;
+		frexp(out[j],&k);
+		exps[j]+=k;
+		out[j]=ldexp(out[j],-k);
+		if (!any || exps[j]>rowExp) rowExp=exps[j];
+		any=true;
+		};
+for (int j=0;j<n;j++) out[j]=ldexp(out[j],exps[j]-rowExp);
+}
+
+//	tetX(), tetOnThetasX()
+//	======================
+//
+//	The same values as XFloats; only the common factor can be out of range, since
+//	the sum is taken relative to its largest term.
+
+XFloat tetX(int a, int b, int c, int d, int e, int f)
+{
+int nn[13], dd[13];
+TETfloat sum;
+bool negative=tetFactorials(a,b,c,d,e,f,nn,dd,sum);
+XFloat result=XFloat((double)sum)*multiRatioX(nn, dd, 13);
+return negative ? -result : result;
+}
+
+XFloat tetOnThetasX(int a, int b, int c, int d, int e, int f,
+	int twoJ1a, int twoJ2a, int twoJ3a, int twoJ1b, int twoJ2b, int twoJ3b)
+{
+int nn[21], dd[21];
+TETfloat sum;
+bool negative=tetOnThetasFactorials(a,b,c,d,e,f,
+	twoJ1a,twoJ2a,twoJ3a,twoJ1b,twoJ2b,twoJ3b,nn,dd,sum);
+XFloat result=XFloat((double)sum)*multiRatioX(nn, dd, 21);
+return negative ? -result : result;
+}
+
+//	tetOnRootThetas()
+//	=================
+//
+//	The twelve factorials in the numerator of a tet are those of the differences
+//	between the sum around each triangle and its three edges, which are also in
+//	the thetas, while the edge factorials cancel against the thetas completely; so
+//	the square of the result is a ratio of factorials with no edge factorials.
+
+TETfloat tetOnRootThetas(int a, int b, int c, int d, int e, int f)
+{
+int aa[4], bb[3], ls;
+TETfloat sum=tetSum(a,b,c,d,e,f,aa,bb,ls);
+
+int nn[18], dd[18];
+for (int i=0;i<4;i++)
+	{
+	for (int j=0;j<3;j++) nn[3*i+j]=bb[j]-aa[i];
+	dd[i]=aa[i]+1;
+	dd[4+i]=dd[8+i]=ls-aa[i];
+	};
+nn[12]=nn[13]=ls+1;
+for (int i=14;i<18;i++) nn[i]=0;
+for (int j=0;j<3;j++) dd[12+j]=dd[15+j]=bb[j]-ls;
+
+TETfloat result=sum*sqrt(multiRatio(nn, dd, 18));
+return ls%2==1 ? -result : result;
+}
+
+//	tetSum() computes the sum in a tet, divided by its largest term; it sets aa[4]
+//	and bb[3] to the sums of spins around triangles and quadrilaterals, and ls to
+//	the index of the largest term.
+
+static TETfloat tetSum(int a, int b, int c, int d, int e, int f, int *aa, int *bb, int &ls)
+{
+aa[0]=(a+b+f)/2; aa[1]=(b+c+e)/2; aa[2]=(c+d+f)/2; aa[3]=(a+d+e)/2;
+bb[0]=(b+d+e+f)/2; bb[1]=(a+c+e+f)/2; bb[2]=(a+b+c+d)/2;
 
 //	Compute ratios between consecutive terms in the sum, and identify when this ratio
-//	is closest to -1, which should be at the peak in absolute value
+//	is closest to -1, which should be at the peak in absolute value.  The products
+//	are formed in floating point, since they overflow an int beyond spins of a few
+//	hundred; below that they are exact either way.
 
 int sumLo=arrayMax(aa,4), sumHi=arrayMin(bb,3), nterms=sumHi-sumLo+1;
-TETfloat *ratios=new TETfloat[nterms-1];
-int r=0, ls=sumLo;
+TETfloat local[MAX_TABLE_FACTORIAL];			//	Enough for any tet the tables cover
+TETfloat *ratios=nterms-1<=MAX_TABLE_FACTORIAL ? local : new TETfloat[nterms-1];
+int r=0;
+ls=sumLo;
 TETfloat lg=1e30;
 for (int s=sumLo+1;s<=sumHi;s++)
 	{
 	int sm=s-1;
 	TETfloat rr=ratios[r++]=
-				-(TETfloat)((s+1)*(bb[0]-sm)*(bb[1]-sm)*(bb[2]-sm))
-				/(TETfloat)((s-aa[0])*(s-aa[1])*(s-aa[2])*(s-aa[3]));
+				-((TETfloat)(s+1)*(bb[0]-sm)*(bb[1]-sm)*(bb[2]-sm))
+				/((TETfloat)(s-aa[0])*(s-aa[1])*(s-aa[2])*(s-aa[3]));
 
 	TETfloat g=abs(rr+1);
 	if (g<lg) {ls=s; lg=g;};
 	};
 
-//	Pull out the peak term as part of the common factor, and compute the overall
-//	common factor.
-
-//	Factorials in the numerator of the common factor
-	
-int nn[]={
-	bb[0]-aa[0], bb[0]-aa[1], bb[0]-aa[2], bb[0]-aa[3],
-	bb[1]-aa[0], bb[1]-aa[1], bb[1]-aa[2], bb[1]-aa[3], 
-	bb[2]-aa[0], bb[2]-aa[1], bb[2]-aa[2], bb[2]-aa[3], ls+1};
-
-//	Factorials in the denominator of the common factor
-
-int dd[]={a,b,c,d,e,f,
-	ls-aa[0], ls-aa[1], ls-aa[2], ls-aa[3],
-	bb[0]-ls, bb[1]-ls, bb[2]-ls
-	};
-
-TETfloat commonFactor=multiRatio(nn, dd, 13);
-	
-//	Set the sign of the common factor
-
-if (ls%2==1) commonFactor=-commonFactor;
-
 //	Sum all terms, with the common factor removed, starting from
 //	the term that gave the common factor itself.
 
@@ -126,48 +648,53 @@ while (true)
 		};
 	};
 
-delete [] ratios;
-TETfloat result=sum*commonFactor;
-
-return result;
+if (ratios!=local) delete [] ratios;
+return sum;
 }
 
-//	tetOnThetas()
-//	=============
+//	tetFactorials() computes the sum in a tet and lists the factorials in its
+//	common factor, with the peak term pulled out; it returns true if the common
+//	factor is negative.
 
-TETfloat tetOnThetas(int a, int b, int c, int d, int e, int f,
-	int twoJ1a, int twoJ2a, int twoJ3a, int twoJ1b, int twoJ2b, int twoJ3b)
+static bool tetFactorials(int a, int b, int c, int d, int e, int f, int *nn, int *dd,
+	TETfloat &sum)
 {
-int aa[]={(a+b+f)/2, (b+c+e)/2, (c+d+f)/2, (a+d+e)/2};
-int bb[]={(b+d+e+f)/2, (a+c+e+f)/2, (a+b+c+d)/2};
+int aa[4], bb[3], ls;
+sum=tetSum(a,b,c,d,e,f,aa,bb,ls);
 
-//	Compute ratios between consecutive terms in the sum, and identify when this ratio
-//	is closest to -1, which should be at the peak in absolute value
+//	Factorials in the numerator of the common factor
+	
+int n[]={
+	bb[0]-aa[0], bb[0]-aa[1], bb[0]-aa[2], bb[0]-aa[3],
+	bb[1]-aa[0], bb[1]-aa[1], bb[1]-aa[2], bb[1]-aa[3], 
+	bb[2]-aa[0], bb[2]-aa[1], bb[2]-aa[2], bb[2]-aa[3], ls+1};
 
-int sumLo=arrayMax(aa,4), sumHi=arrayMin(bb,3), nterms=sumHi-sumLo+1;
-TETfloat *ratios=new TETfloat[nterms-1];
-int r=0, ls=sumLo;
-TETfloat lg=1e30;
-for (int s=sumLo+1;s<=sumHi;s++)
-	{
-	int sm=s-1;
-	TETfloat rr=ratios[r++]=
-				-(TETfloat)((s+1)*(bb[0]-sm)*(bb[1]-sm)*(bb[2]-sm))
-				/(TETfloat)((s-aa[0])*(s-aa[1])*(s-aa[2])*(s-aa[3]));
+//	Factorials in the denominator of the common factor
 
-	TETfloat g=abs(rr+1);
-	if (g<lg) {ls=s; lg=g;};
+int dn[]={a,b,c,d,e,f,
+	ls-aa[0], ls-aa[1], ls-aa[2], ls-aa[3],
+	bb[0]-ls, bb[1]-ls, bb[2]-ls
 	};
 
-//	Pull out the peak term as part of the common factor, and compute the overall
-//	common factor, divided by the specified thetas.
+for (int i=0;i<13;i++) {nn[i]=n[i]; dd[i]=dn[i];};
+return ls%2==1;
+}
+
+//	tetOnThetasFactorials() does the same for a tet divided by two thetas
+
+static bool tetOnThetasFactorials(int a, int b, int c, int d, int e, int f,
+	int twoJ1a, int twoJ2a, int twoJ3a, int twoJ1b, int twoJ2b, int twoJ3b,
+	int *nn, int *dd, TETfloat &sum)
+{
+int aa[4], bb[3], ls;
+sum=tetSum(a,b,c,d,e,f,aa,bb,ls);
 
 int sumJa=(twoJ1a+twoJ2a+twoJ3a)/2;
 int sumJb=(twoJ1b+twoJ2b+twoJ3b)/2;
 
 //	Factorials in the numerator of the common factor
 	
-int nn[]={
+int n[]={
 	bb[0]-aa[0], bb[0]-aa[1], bb[0]-aa[2], bb[0]-aa[3],
 	bb[1]-aa[0], bb[1]-aa[1], bb[1]-aa[2], bb[1]-aa[3], 
 	bb[2]-aa[0], bb[2]-aa[1], bb[2]-aa[2], bb[2]-aa[3],
@@ -178,46 +705,15 @@ int nn[]={
 
 //	Factorials in the denominator of the common factor
 
-int dd[]={a,b,c,d,e,f,
+int dn[]={a,b,c,d,e,f,
 	ls-aa[0], ls-aa[1], ls-aa[2], ls-aa[3],
 	bb[0]-ls, bb[1]-ls, bb[2]-ls,
 	sumJa-twoJ1a, sumJa-twoJ2a, sumJa-twoJ3a, sumJa+1,
 	sumJb-twoJ1b, sumJb-twoJ2b, sumJb-twoJ3b, sumJb+1
 	};
 
-TETfloat commonFactor=multiRatio(nn, dd, 21);
-	
-//	Set the sign of the common factor
-
-if ((ls+sumJa+sumJb)%2==1) commonFactor=-commonFactor;
-
-//	Sum all terms, with the common factor removed, starting from
-//	the term that gave the common factor itself.
-
-TETfloat sum=1.0, term1=1.0, term2=1.0;
-int s1=ls+1, s2=ls-1;
-while (true)
-	{
-	bool ok1=(s1<=sumHi), ok2=(s2>=sumLo);
-	if (!(ok1||ok2)) break;
-	if (ok1)
-		{
-		term1*=ratios[s1-sumLo-1];
-		sum+=term1;
-		s1++;
-		};
-	if (ok2)
-		{
-		term2/=ratios[s2-sumLo];
-		sum+=term2;
-		s2--;
-		};
-	};
-
-delete [] ratios;
-TETfloat result=sum*commonFactor;
-
-return result;
+for (int i=0;i<21;i++) {nn[i]=n[i]; dd[i]=dn[i];};
+return (ls+sumJa+sumJb)%2==1;
 }
 
 //	Minimum and maximum values in an integer array